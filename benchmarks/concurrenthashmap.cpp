@@ -0,0 +1,153 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// Total operations shared between all threads at each thread count
+static const int OPERATIONS = 2000000;
+// Keys in the map, all inserted before timing starts
+static const int KEYS = 100000;
+// Keys in the map used to compare batched and single lookups, large enough to miss in cache
+static const int BATCH_KEYS = 2000000;
+
+struct LockedHashMap {
+    HashMap<std::uint64_t, std::uint64_t> map;
+    std::mutex mutex;
+
+    bool find(std::uint64_t key, std::uint64_t& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::uint64_t* value = map.find(key);
+        if (value == nullptr) {
+            return false;
+        }
+        out = *value;
+        return true;
+    }
+
+    void set(std::uint64_t key, std::uint64_t value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        map.set(key, value);
+    }
+};
+
+struct SharedLockedHashMap {
+    HashMap<std::uint64_t, std::uint64_t> map;
+    std::shared_mutex mutex;
+
+    bool find(std::uint64_t key, std::uint64_t& out) {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        const std::uint64_t* value = map.find(key);
+        if (value == nullptr) {
+            return false;
+        }
+        out = *value;
+        return true;
+    }
+
+    void set(std::uint64_t key, std::uint64_t value) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        map.set(key, value);
+    }
+};
+
+// Every thread mixes lookups and updates of random keys, writing a given percentage of the time
+template <class M>
+static double run(M& map, int threads, int write_percent) {
+    for (int i = 0; i < KEYS; i++) {
+        map.set(i, i);
+    }
+
+    int per_thread = OPERATIONS / threads;
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&map, per_thread, write_percent, t]() {
+            std::minstd_rand local(t + 1);
+            std::uint64_t sum = 0;
+            for (int i = 0; i < per_thread; i++) {
+                std::uint64_t key = local() % KEYS;
+                if (static_cast<int>(local() % 100) < write_percent) {
+                    map.set(key, key + i);
+                } else {
+                    std::uint64_t value;
+                    if (map.find(key, value)) {
+                        sum += value;
+                    }
+                }
+            }
+            if (sum == 1) {
+                std::printf("unlikely\n");
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(per_thread) * threads / seconds / 1e6;
+}
+
+int main() {
+    int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::printf("Mixed find/set throughput in Mops/s over %d keys, %d hardware threads\n", KEYS, hardware);
+
+    int write_percents[] = {0, 5, 50};
+    for (int write_percent : write_percents) {
+        std::printf("\n%d%% writes\n", write_percent);
+        std::printf("%8s %18s %18s %18s\n", "threads", "ConcurrentHashMap", "mutex HashMap", "shared_mutex");
+        for (int threads = 1; threads <= 64; threads *= 2) {
+            ConcurrentHashMap<std::uint64_t, std::uint64_t> concurrent;
+            LockedHashMap locked;
+            SharedLockedHashMap shared;
+            double concurrent_mops = run(concurrent, threads, write_percent);
+            double locked_mops = run(locked, threads, write_percent);
+            double shared_mops = run(shared, threads, write_percent);
+            std::printf("%8d %18.2f %18.2f %18.2f\n", threads, concurrent_mops, locked_mops, shared_mops);
+        }
+    }
+
+    // Batched lookups take each shard's sequence once per batch rather than once per key
+    ConcurrentHashMap<std::uint64_t, std::uint64_t> map;
+    std::vector<std::uint64_t> keys(BATCH_KEYS);
+    std::vector<std::uint64_t> values(BATCH_KEYS);
+    for (int i = 0; i < BATCH_KEYS; i++) {
+        keys[i] = i;
+        values[i] = i;
+    }
+    auto start = Clock::now();
+    map.insertMany(keys.data(), values.data(), BATCH_KEYS);
+    double insert_many = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / BATCH_KEYS;
+
+    std::mt19937 rng(3);
+    for (std::uint64_t& key : keys) {
+        key = rng() % BATCH_KEYS;
+    }
+    bool* found = new bool[BATCH_KEYS];
+    start = Clock::now();
+    for (int round = 0; round < 10; round++) {
+        map.findMany(keys.data(), BATCH_KEYS, values.data(), found);
+    }
+    double find_many = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (10.0 * BATCH_KEYS);
+
+    std::uint64_t value;
+    start = Clock::now();
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < BATCH_KEYS; i++) {
+            map.find(keys[i], value);
+        }
+    }
+    double find_each = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / (10.0 * BATCH_KEYS);
+    delete[] found;
+
+    std::printf("\ninsertMany %.1f ns/key, findMany %.1f ns/key, find %.1f ns/key\n", insert_many, find_many, find_each);
+    return 0;
+}
@@ -0,0 +1,68 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int ITEMS = 20000000;
+
+struct Result {
+    double push_secs;
+    double pop_secs;
+    long long checksum;
+};
+
+template <class Queue>
+static Result drain(Queue& pqueue, const std::vector<int>& values) {
+    auto start = Clock::now();
+    for (int value : values) {
+        pqueue.push(value);
+    }
+    auto pushed = Clock::now();
+    long long checksum = 0;
+    int previous = 0;
+    while (!pqueue.isEmpty()) {
+        int value = pqueue.pop();
+        if (value < previous) {
+            std::printf("order violated\n");
+        }
+        previous = value;
+        checksum += value;
+    }
+    auto popped = Clock::now();
+    return {std::chrono::duration<double>(pushed - start).count(), std::chrono::duration<double>(popped - pushed).count(), checksum};
+}
+
+static void report(const char* name, const Result& result) {
+    std::printf("%-28s %12.2f %12.2f %20lld\n", name, ITEMS / result.push_secs / 1e6, ITEMS / result.pop_secs / 1e6, result.checksum);
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::vector<int> values(ITEMS);
+    for (int& value : values) {
+        value = static_cast<int>(rng() >> 1);
+    }
+
+    std::printf("Push then pop %d random ints (%.0f MiB of data)\n", ITEMS, ITEMS * sizeof(int) / 1048576.0);
+    std::printf("%-28s %12s %12s %20s\n", "queue", "push Mops/s", "pop Mops/s", "checksum");
+    {
+        PQueue<int> pqueue;
+        report("PQueue", drain(pqueue, values));
+    }
+
+    // The smallest budget spills about 150 runs, filling and merging level 0 nine times
+    int budgets[] = {1 << 24, 1 << 22, 1 << 20, 1 << 18};
+    for (int memory : budgets) {
+        ExternalPQueue<int> pqueue(memory);
+        Result result = drain(pqueue, values);
+        char name[64];
+        std::snprintf(name, sizeof(name), "ExternalPQueue %d MiB", static_cast<int>(memory * sizeof(int) >> 20));
+        report(name, result);
+        std::printf("%-28s %.0f MiB written, %.2f elements written per element pushed\n", "", pqueue.spilled() * sizeof(int) / 1048576.0, pqueue.spilled() / static_cast<double>(ITEMS));
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int ITEMS = 1000000;
+static const int LOOKUPS = 10000000;
+
+static double nsPerOp(Clock::time_point start, int ops) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ops;
+}
+
+// Times inserting every key, looking up present and absent keys, then removing every key
+template <class Insert, class Find, class Remove>
+static void run(const char* name, const std::vector<unsigned>& keys, const std::vector<unsigned>& probes, Insert insert, Find find, Remove remove) {
+    auto start = Clock::now();
+    for (unsigned key : keys) {
+        insert(key);
+    }
+    double insert_ns = nsPerOp(start, ITEMS);
+
+    long long hits = 0;
+    start = Clock::now();
+    for (int i = 0; i < LOOKUPS; i++) {
+        hits += find(keys[probes[i]]);
+    }
+    double hit_ns = nsPerOp(start, LOOKUPS);
+
+    // Odd keys were never inserted, since every inserted key is even
+    long long misses = 0;
+    start = Clock::now();
+    for (int i = 0; i < LOOKUPS; i++) {
+        misses += find(keys[probes[i]] | 1);
+    }
+    double miss_ns = nsPerOp(start, LOOKUPS);
+
+    start = Clock::now();
+    for (unsigned key : keys) {
+        remove(key);
+    }
+    double remove_ns = nsPerOp(start, ITEMS);
+
+    std::printf("%-20s %10.1f %10.1f %10.1f %10.1f %12lld\n", name, insert_ns, hit_ns, miss_ns, remove_ns, hits + misses);
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::vector<unsigned> keys(ITEMS);
+    for (unsigned& key : keys) {
+        key = rng() & ~1u;
+    }
+    std::vector<unsigned> probes(LOOKUPS);
+    for (unsigned& probe : probes) {
+        probe = rng() % ITEMS;
+    }
+
+    std::printf("%d random keys, %d lookups, ns per operation\n", ITEMS, LOOKUPS);
+    std::printf("%-20s %10s %10s %10s %10s %12s\n", "map", "insert", "hit", "miss", "remove", "checksum");
+
+    HashMap<unsigned, unsigned> map;
+    run("HashMap", keys, probes,
+        [&](unsigned key) { map.set(key, key); },
+        [&](unsigned key) { const unsigned* value = map.find(key); return value == nullptr ? 0u : *value & 1u ? 2u : 1u; },
+        [&](unsigned key) { map.remove(key); });
+
+    std::unordered_map<unsigned, unsigned> reference;
+    run("std::unordered_map", keys, probes,
+        [&](unsigned key) { reference[key] = key; },
+        [&](unsigned key) { auto it = reference.find(key); return it == reference.end() ? 0u : it->second & 1u ? 2u : 1u; },
+        [&](unsigned key) { reference.erase(key); });
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int KEYS = 1000000;
+static const int OPS = 5000000;
+// Capacity of the caches, about 5% of the keys
+static const int CAPACITY = 50000;
+// Capacity and operations for the List-based cache, whose moves scan the list
+static const int LIST_CAPACITY = 1000;
+static const int LIST_OPS = 100000;
+
+// Skewed keys: a few are hot and most are cold, as in most cache workloads
+static std::vector<int> skewedKeys(int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<int> keys(count);
+    for (int& key : keys) {
+        key = static_cast<int>(KEYS * std::pow(unit(rng), 4.0));
+    }
+    return keys;
+}
+
+// Times a read-through loop: look each key up, and put it on a miss
+template <class Get, class Put>
+static void run(const char* name, const std::vector<int>& keys, int ops, Get get, Put put) {
+    int hits = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < ops; i++) {
+        if (get(keys[i])) {
+            hits++;
+        } else {
+            put(keys[i]);
+        }
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ops;
+    std::printf("%-28s %10.1f %9.1f%%\n", name, ns, 100.0 * hits / ops);
+}
+
+// Times get-or-put over a shared cache from a number of threads, in millions of operations per second
+template <class Cache>
+static double throughput(Cache& cache, const std::vector<int>& keys, int threads) {
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    int per_thread = OPS / threads;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            int value;
+            for (int i = 0; i < per_thread; i++) {
+                int key = keys[(t * per_thread + i) % keys.size()];
+                if (!cache.get(key, value)) {
+                    cache.put(key, key);
+                }
+            }
+        });
+    }
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return per_thread * static_cast<double>(threads) / seconds / 1e6;
+}
+
+int main() {
+    std::vector<int> keys = skewedKeys(OPS, 42);
+
+    std::printf("Read-through over skewed keys, capacity %d\n", CAPACITY);
+    std::printf("%-28s %10s %10s\n", "cache", "ns/op", "hit rate");
+
+    {
+        // The pattern this replaces: recency kept in a List, so every hit scans it
+        List<int> order;
+        HashMap<int, int> values;
+        run("List + HashMap (cap 1000)", keys, LIST_OPS,
+            [&](int key) {
+                if (!values.contains(key)) {
+                    return false;
+                }
+                order.removeValue(key);
+                order.push(key);
+                return true;
+            },
+            [&](int key) {
+                if (order.length() == LIST_CAPACITY) {
+                    values.remove(order.remove(0));
+                }
+                order.push(key);
+                values.set(key, key);
+            });
+    }
+    {
+        LRUCache<int, int> cache(LIST_CAPACITY);
+        run("LRUCache (cap 1000)", keys, LIST_OPS,
+            [&](int key) { return cache.get(key) != nullptr; },
+            [&](int key) { cache.put(key, key); });
+    }
+    {
+        LRUCache<int, int> cache(CAPACITY);
+        run("LRUCache", keys, OPS,
+            [&](int key) { return cache.get(key) != nullptr; },
+            [&](int key) { cache.put(key, key); });
+    }
+    {
+        ClockCache<int, int> cache(CAPACITY);
+        run("ClockCache", keys, OPS,
+            [&](int key) { return cache.get(key) != nullptr; },
+            [&](int key) { cache.put(key, key); });
+    }
+
+    int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    std::printf("\nShared cache throughput in Mops/s, %d hardware threads\n", hardware);
+    std::printf("%8s %14s %14s %14s\n", "threads", "LRU, 1 shard", "sharded LRU", "sharded CLOCK");
+    for (int threads = 1; threads <= 16; threads *= 2) {
+        ShardedCache<LRUCache<int, int>> single(CAPACITY, 1);
+        ShardedCache<LRUCache<int, int>> lru(CAPACITY);
+        ShardedCache<ClockCache<int, int>> clock(CAPACITY);
+        double single_rate = throughput(single, keys, threads);
+        double lru_rate = throughput(lru, keys, threads);
+        double clock_rate = throughput(clock, keys, threads);
+        std::printf("%8d %14.2f %14.2f %14.2f\n", threads, single_rate, lru_rate, clock_rate);
+    }
+    return 0;
+}
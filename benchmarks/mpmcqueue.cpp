@@ -0,0 +1,83 @@
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// Total push/pop pairs shared between all threads at each thread count
+static const int OPERATIONS = 2000000;
+static const int CAPACITY = 4096;
+
+// Spins briefly before yielding, so oversubscribed runs still make progress
+static void backoff(int& spins) {
+    if (++spins > 64) {
+        std::this_thread::yield();
+        spins = 0;
+    }
+}
+
+struct LockedQueue {
+    Queue<int> queue;
+    std::mutex mutex;
+
+    bool tryPush(int data) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(data);
+        return true;
+    }
+
+    bool tryPop(int& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.isEmpty()) {
+            return false;
+        }
+        out = queue.pop();
+        return true;
+    }
+};
+
+// Every thread alternates a push and a pop, so all threads both produce and consume
+template <class Q>
+static double run(Q& queue, int threads) {
+    int per_thread = OPERATIONS / threads;
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&queue, per_thread, t]() {
+            int out;
+            int spins = 0;
+            for (int i = 0; i < per_thread; i++) {
+                while (!queue.tryPush(t)) {
+                    backoff(spins);
+                }
+                while (!queue.tryPop(out)) {
+                    backoff(spins);
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return 2.0 * per_thread * threads / seconds / 1e6;
+}
+
+int main() {
+    std::printf("%d push/pop pairs per run, %u hardware threads\n", OPERATIONS, std::thread::hardware_concurrency());
+    std::printf("%8s %18s %18s\n", "threads", "MPMCQueue Mops/s", "mutex Queue Mops/s");
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        MPMCQueue<int> lock_free(CAPACITY);
+        LockedQueue locked;
+        double lock_free_rate = run(lock_free, threads);
+        double locked_rate = run(locked, threads);
+        std::printf("%8d %18.1f %18.1f\n", threads, lock_free_rate, locked_rate);
+    }
+    return 0;
+}
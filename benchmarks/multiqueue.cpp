@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// Total push/pop pairs shared between all threads at each thread count
+static const int OPERATIONS = 2000000;
+// Elements in the queue before timing starts, so pops rarely find it empty
+static const int PREFILL = 100000;
+// Elements pushed and popped when measuring rank error
+static const int QUALITY_ITEMS = 200000;
+
+struct LockedPQueue {
+    PQueue<int> pqueue;
+    std::mutex mutex;
+
+    void push(int data) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pqueue.push(data);
+    }
+
+    bool tryPop(int& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pqueue.isEmpty()) {
+            return false;
+        }
+        out = pqueue.pop();
+        return true;
+    }
+};
+
+// Every thread alternates a push of a random key and a pop
+template <class Q>
+static double run(Q& queue, int threads) {
+    std::mt19937 rng(7);
+    for (int i = 0; i < PREFILL; i++) {
+        queue.push(static_cast<int>(rng() >> 1));
+    }
+
+    int per_thread = OPERATIONS / threads;
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&queue, per_thread, t]() {
+            std::minstd_rand local(t + 1);
+            int out;
+            for (int i = 0; i < per_thread; i++) {
+                queue.push(static_cast<int>(local()));
+                queue.tryPop(out);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return 2.0 * per_thread * threads / seconds / 1e6;
+}
+
+// Average number of smaller keys still queued when each key is popped, counted with a Fenwick tree
+static double rankError(int threads, int factor) {
+    MultiQueue<int> queue(threads, factor);
+    std::vector<int> tree(QUALITY_ITEMS + 1, 0);
+    auto add = [&](int idx, int delta) {
+        for (idx++; idx <= QUALITY_ITEMS; idx += idx & -idx) {
+            tree[idx] += delta;
+        }
+    };
+    auto below = [&](int idx) {
+        int count = 0;
+        for (; idx > 0; idx -= idx & -idx) {
+            count += tree[idx];
+        }
+        return count;
+    };
+
+    std::vector<int> keys(QUALITY_ITEMS);
+    for (int i = 0; i < QUALITY_ITEMS; i++) {
+        keys[i] = i;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(3));
+    for (int key : keys) {
+        queue.push(key);
+        add(key, 1);
+    }
+
+    long long total = 0;
+    int out;
+    while (queue.tryPop(out)) {
+        total += below(out);
+        add(out, -1);
+    }
+    return static_cast<double>(total) / QUALITY_ITEMS;
+}
+
+int main() {
+    std::printf("Average rank error of %d pops, 8 threads' worth of shards\n", QUALITY_ITEMS);
+    std::printf("%8s %8s %12s\n", "factor", "shards", "rank error");
+    for (int factor = 1; factor <= 8; factor *= 2) {
+        std::printf("%8d %8d %12.2f\n", factor, 8 * factor, rankError(8, factor));
+    }
+
+    std::printf("\n%d push/pop pairs per run, %u hardware threads\n", OPERATIONS, std::thread::hardware_concurrency());
+    std::printf("%8s %19s %19s\n", "threads", "MultiQueue Mops/s", "mutex PQueue Mops/s");
+    for (int threads = 1; threads <= 64; threads *= 2) {
+        MultiQueue<int> relaxed(threads, 2);
+        LockedPQueue locked;
+        double relaxed_rate = run(relaxed, threads);
+        double locked_rate = run(locked, threads);
+        std::printf("%8d %19.1f %19.1f\n", threads, relaxed_rate, locked_rate);
+    }
+    return 0;
+}
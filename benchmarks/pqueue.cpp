@@ -0,0 +1,46 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int ITEMS = 2000000;
+
+template <int Arity>
+static void throughput(const std::vector<int>& values) {
+    PQueue<int, std::less<>, std::identity, Arity> pqueue(ITEMS);
+
+    auto start = Clock::now();
+    for (int value : values) {
+        pqueue.push(value);
+    }
+    auto pushed = Clock::now();
+    long long checksum = 0;
+    while (!pqueue.isEmpty()) {
+        checksum += pqueue.pop();
+    }
+    auto popped = Clock::now();
+
+    double push_secs = std::chrono::duration<double>(pushed - start).count();
+    double pop_secs = std::chrono::duration<double>(popped - pushed).count();
+    std::printf("%6d %14.2f %14.2f %20lld\n", Arity, ITEMS / push_secs / 1e6, ITEMS / pop_secs / 1e6, checksum);
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::vector<int> values(ITEMS);
+    for (int& value : values) {
+        value = static_cast<int>(rng() >> 1);
+    }
+
+    std::printf("PQueue<int> push/pop throughput over %d random keys\n", ITEMS);
+    std::printf("%6s %14s %14s %20s\n", "arity", "push Mops/s", "pop Mops/s", "checksum");
+    throughput<2>(values);
+    throughput<4>(values);
+    throughput<8>(values);
+    throughput<16>(values);
+    return 0;
+}
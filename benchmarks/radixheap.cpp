@@ -0,0 +1,94 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int NODES = 200000;
+static const int DEGREE = 8;
+static const int MAX_WEIGHT = 1000;
+static const std::uint32_t INF = ~0u;
+
+struct Edge {
+    int to;
+    std::uint32_t weight;
+};
+
+// Dijkstra with lazy deletion: stale entries are skipped when popped
+static std::vector<std::uint32_t> radixDijkstra(const std::vector<std::vector<Edge>>& graph) {
+    std::vector<std::uint32_t> dist(graph.size(), INF);
+    RadixHeap<std::uint32_t, int> heap;
+    dist[0] = 0;
+    heap.push(0, 0);
+    while (!heap.isEmpty()) {
+        std::pair<std::uint32_t, int> top = heap.pop();
+        if (top.first != dist[top.second]) {
+            continue;
+        }
+        for (const Edge& edge : graph[top.second]) {
+            std::uint32_t next = top.first + edge.weight;
+            if (next < dist[edge.to]) {
+                dist[edge.to] = next;
+                heap.push(next, edge.to);
+            }
+        }
+    }
+    return dist;
+}
+
+static std::vector<std::uint32_t> pqueueDijkstra(const std::vector<std::vector<Edge>>& graph) {
+    std::vector<std::uint32_t> dist(graph.size(), INF);
+    PQueue<std::pair<std::uint32_t, int>> heap;
+    dist[0] = 0;
+    heap.push({0, 0});
+    while (!heap.isEmpty()) {
+        std::pair<std::uint32_t, int> top = heap.pop();
+        if (top.first != dist[top.second]) {
+            continue;
+        }
+        for (const Edge& edge : graph[top.second]) {
+            std::uint32_t next = top.first + edge.weight;
+            if (next < dist[edge.to]) {
+                dist[edge.to] = next;
+                heap.push({next, edge.to});
+            }
+        }
+    }
+    return dist;
+}
+
+template <class Fn>
+static double timed(Fn fn, std::vector<std::uint32_t>& result) {
+    auto start = Clock::now();
+    result = fn();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main() {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> node(0, NODES - 1);
+    std::uniform_int_distribution<std::uint32_t> weight(1, MAX_WEIGHT);
+    std::vector<std::vector<Edge>> graph(NODES);
+    for (int from = 0; from < NODES; from++) {
+        for (int i = 0; i < DEGREE; i++) {
+            graph[from].push_back({node(rng), weight(rng)});
+        }
+    }
+
+    std::vector<std::uint32_t> radix_dist;
+    std::vector<std::uint32_t> pqueue_dist;
+    double radix_secs = timed([&]() { return radixDijkstra(graph); }, radix_dist);
+    double pqueue_secs = timed([&]() { return pqueueDijkstra(graph); }, pqueue_dist);
+
+    std::printf("Dijkstra on %d nodes, %d edges, weights 1..%d\n", NODES, NODES * DEGREE, MAX_WEIGHT);
+    std::printf("%12s %10s\n", "heap", "ms");
+    std::printf("%12s %10.1f\n", "RadixHeap", radix_secs * 1e3);
+    std::printf("%12s %10.1f\n", "PQueue", pqueue_secs * 1e3);
+    std::printf("distances %s\n", radix_dist == pqueue_dist ? "match" : "DIFFER");
+    return radix_dist == pqueue_dist ? 0 : 1;
+}
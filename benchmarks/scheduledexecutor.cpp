@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int SCHEDULE_OPS = 200000;
+static const int JITTER_TIMERS = 2000;
+// Spacing between the deadlines of consecutive timers in the jitter run
+static const int SPACING_US = 250;
+
+static double nsPerOp(Clock::time_point start, int ops) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ops;
+}
+
+// Measures the cost of scheduling and cancelling timers that never come due
+static void overhead() {
+    ThreadPool pool(1);
+    ScheduledExecutor executor(pool);
+    std::vector<ScheduledExecutor::Handle> handles(SCHEDULE_OPS);
+
+    auto start = Clock::now();
+    for (int i = 0; i < SCHEDULE_OPS; i++) {
+        handles[i] = executor.schedule([]() {}, std::chrono::seconds(60) + std::chrono::microseconds(i % 1000));
+    }
+    double schedule_ns = nsPerOp(start, SCHEDULE_OPS);
+
+    start = Clock::now();
+    for (int i = 0; i < SCHEDULE_OPS; i++) {
+        executor.cancel(handles[i]);
+    }
+    double cancel_ns = nsPerOp(start, SCHEDULE_OPS);
+
+    std::printf("%d timers: schedule %.1f ns/op, cancel %.1f ns/op\n\n", SCHEDULE_OPS, schedule_ns, cancel_ns);
+}
+
+// Schedules evenly spaced timers and records how late each one runs
+static void jitter(Clock::duration tolerance) {
+    ThreadPool pool(2);
+    ScheduledExecutor executor(pool, tolerance);
+    std::vector<long long> lateness(JITTER_TIMERS);
+    std::atomic<int> done(0);
+
+    Clock::time_point base = Clock::now() + std::chrono::milliseconds(10);
+    for (int i = 0; i < JITTER_TIMERS; i++) {
+        Clock::time_point deadline = base + std::chrono::microseconds(i * SPACING_US);
+        executor.scheduleAt([&, i, deadline]() {
+            lateness[i] = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - deadline).count();
+            done.fetch_add(1, std::memory_order_release);
+        }, deadline);
+    }
+    while (done.load(std::memory_order_acquire) < JITTER_TIMERS) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    std::sort(lateness.begin(), lateness.end());
+    double mean = 0;
+    for (long long value : lateness) {
+        mean += value;
+    }
+    mean /= JITTER_TIMERS;
+    long long tolerance_us = std::chrono::duration_cast<std::chrono::microseconds>(tolerance).count();
+    std::printf("%12lld %10llu %10.1f %10lld %10lld %10lld %10lld\n", tolerance_us, (unsigned long long)executor.wakeups(), mean,
+                lateness[0], lateness[JITTER_TIMERS / 2], lateness[JITTER_TIMERS * 99 / 100], lateness[JITTER_TIMERS - 1]);
+}
+
+int main() {
+    overhead();
+
+    std::printf("%d timers %d us apart, lateness in us (at most the tolerance plus wakeup latency)\n", JITTER_TIMERS, SPACING_US);
+    std::printf("%12s %10s %10s %10s %10s %10s %10s\n", "tolerance us", "wakeups", "mean", "min", "p50", "p99", "max");
+    int tolerances[] = {0, 100, 1000, 5000};
+    for (int tolerance : tolerances) {
+        jitter(std::chrono::microseconds(tolerance));
+    }
+    return 0;
+}
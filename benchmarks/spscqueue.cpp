@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int ITEMS = 20000000;
+static const int ROUND_TRIPS = 200000;
+static const int CAPACITY = 1024;
+
+// Spins briefly before yielding, so the benchmark still makes progress when both threads share a core
+static void backoff(int& spins) {
+    if (++spins > 64) {
+        std::this_thread::yield();
+        spins = 0;
+    }
+}
+
+static double throughput(int batch) {
+    SPSCQueue<int> queue(CAPACITY);
+    auto start = Clock::now();
+
+    std::thread producer([&]() {
+        std::vector<int> buffer(batch);
+        int next = 0;
+        while (next < ITEMS) {
+            int size = std::min(batch, ITEMS - next);
+            for (int i = 0; i < size; i++) {
+                buffer[i] = next + i;
+            }
+            int sent = 0;
+            int spins = 0;
+            while (sent < size) {
+                int pushed = queue.pushMany(buffer.data() + sent, size - sent);
+                if (pushed == 0) {
+                    backoff(spins);
+                }
+                sent += pushed;
+            }
+            next += size;
+        }
+    });
+
+    std::vector<int> buffer(batch);
+    long long sum = 0;
+    int received = 0;
+    int spins = 0;
+    while (received < ITEMS) {
+        int got = queue.popMany(buffer.data(), batch);
+        if (got == 0) {
+            backoff(spins);
+        }
+        for (int i = 0; i < got; i++) {
+            sum += buffer[i];
+        }
+        received += got;
+    }
+    producer.join();
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (sum != (long long)ITEMS * (ITEMS - 1) / 2) {
+        std::printf("checksum mismatch\n");
+    }
+    return ITEMS / seconds / 1e6;
+}
+
+static void latency() {
+    SPSCQueue<int> ping(CAPACITY);
+    SPSCQueue<int> pong(CAPACITY);
+    std::vector<double> samples(ROUND_TRIPS);
+
+    std::thread echo([&]() {
+        int value;
+        int spins = 0;
+        for (int i = 0; i < ROUND_TRIPS; i++) {
+            while (!ping.tryPop(value)) {
+                backoff(spins);
+            }
+            while (!pong.tryPush(value)) {
+                backoff(spins);
+            }
+        }
+    });
+
+    int value;
+    int spins = 0;
+    for (int i = 0; i < ROUND_TRIPS; i++) {
+        auto start = Clock::now();
+        while (!ping.tryPush(i)) {
+            backoff(spins);
+        }
+        while (!pong.tryPop(value)) {
+            backoff(spins);
+        }
+        samples[i] = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+    echo.join();
+
+    std::sort(samples.begin(), samples.end());
+    std::printf("round-trip latency: p50 %.0f ns, p99 %.0f ns, p99.9 %.0f ns\n",
+                samples[ROUND_TRIPS / 2], samples[ROUND_TRIPS * 99 / 100], samples[ROUND_TRIPS * 999 / 1000]);
+}
+
+int main() {
+    std::printf("SPSCQueue, %d items, capacity %d\n", ITEMS, CAPACITY);
+    int batches[] = {1, 8, 64, 256};
+    for (int batch : batches) {
+        std::printf("throughput (batch %3d): %.1f Mops/s\n", batch, throughput(batch));
+    }
+    latency();
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "../include/strux.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static const int FIB_N = 32;
+static const int FIB_CUTOFF = 16;
+static const int TREE_DEPTH = 22;
+
+static long long serialFib(int n) {
+    return n < 2 ? n : serialFib(n - 1) + serialFib(n - 2);
+}
+
+static long long parallelFib(ThreadPool& pool, int n) {
+    if (n < FIB_CUTOFF) {
+        return serialFib(n);
+    }
+    long long a = 0;
+    ThreadPool::TaskGroup group(pool);
+    group.run([&]() { a = parallelFib(pool, n - 1); });
+    long long b = parallelFib(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+// Sums an implicit complete binary tree where node i holds i % 7
+static long long serialTreeSum(long long node, int depth) {
+    if (depth == 0) {
+        return node % 7;
+    }
+    return node % 7 + serialTreeSum(2 * node + 1, depth - 1) + serialTreeSum(2 * node + 2, depth - 1);
+}
+
+static long long parallelTreeSum(ThreadPool& pool, long long node, int depth) {
+    if (depth < 12) {
+        return serialTreeSum(node, depth);
+    }
+    long long left = 0;
+    ThreadPool::TaskGroup group(pool);
+    group.run([&]() { left = parallelTreeSum(pool, 2 * node + 1, depth - 1); });
+    long long right = parallelTreeSum(pool, 2 * node + 2, depth - 1);
+    group.wait();
+    return node % 7 + left + right;
+}
+
+template <class F>
+static double time(F fn, long long& result) {
+    auto start = Clock::now();
+    result = fn();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int main() {
+    int hardware = std::max(1, (int)std::thread::hardware_concurrency());
+    long long fib_expected;
+    long long tree_expected;
+    double fib_serial = time([]() { return serialFib(FIB_N); }, fib_expected);
+    double tree_serial = time([]() { return serialTreeSum(0, TREE_DEPTH); }, tree_expected);
+
+    std::printf("fib(%d) and tree-sum(depth %d), %d hardware threads\n", FIB_N, TREE_DEPTH, hardware);
+    std::printf("%8s %12s %10s %12s %10s\n", "threads", "fib ms", "speedup", "tree ms", "speedup");
+    std::printf("%8s %12.1f %10s %12.1f %10s\n", "serial", fib_serial, "1.00", tree_serial, "1.00");
+
+    for (int threads = 1; threads <= hardware * 2; threads *= 2) {
+        ThreadPool pool(threads);
+        long long fib_result;
+        long long tree_result;
+        double fib_ms = time([&]() { return parallelFib(pool, FIB_N); }, fib_result);
+        double tree_ms = time([&]() { return parallelTreeSum(pool, 0, TREE_DEPTH); }, tree_result);
+        if (fib_result != fib_expected || tree_result != tree_expected) {
+            std::printf("result mismatch\n");
+        }
+        std::printf("%8d %12.1f %10.2f %12.1f %10.2f\n", threads, fib_ms, fib_serial / fib_ms, tree_ms, tree_serial / tree_ms);
+    }
+    return 0;
+}
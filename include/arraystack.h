@@ -0,0 +1,123 @@
+/**
+ * @file arraystack.h
+ * @brief Stack implementation using vectors.
+ *
+ * This class implements a stack using a vector, so consecutive elements are contiguous in
+ * memory and push and pop only allocate when the vector resizes. Reserving capacity up
+ * front removes even those allocations.
+ *
+ * @tparam T The data type stored in the stack.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include "vector.h"
+
+/**
+ * @class ArrayStack
+ * @brief A stack implemented using a vector.
+ *
+ * @tparam T The data type stored in the stack.
+ */
+template <class T>
+class ArrayStack {
+private:
+	Vector<T> vector;
+
+public:
+	/**
+	 * @brief Constructs an empty stack (O(1)).
+	 */
+	ArrayStack() {}
+
+	/**
+	 * @brief Constructs a stack with a single element (O(1)).
+	 * @param data The data to push onto the stack.
+	 */
+	ArrayStack(T data) { push(data); }
+
+	/**
+	 * @brief Constructs a stack with elements from an array (O(n)).
+	 * @param data The array of data to push onto the stack.
+	 * @param size The size of the array.
+	 */
+	ArrayStack(T data[], int size) : vector(data, size) {}
+
+	ArrayStack(const ArrayStack&) = delete;
+	ArrayStack& operator=(const ArrayStack&) = delete;
+
+	/**
+	 * @brief Destroys the stack (O(1)).
+	 */
+	~ArrayStack() {}
+
+	/**
+	 * @brief Pushes an element onto the stack (amortized O(1)).
+	 * @param data The data to push onto the stack.
+	 */
+	void push(T data) { vector.push(data); }
+
+	/**
+	 * @brief Reserves space for a number of elements so that the stack never reallocates below that depth (O(n)).
+	 * @param size The number of elements to reserve space for.
+	 */
+	void reserve(int size) { vector.reserve(size); }
+
+	/**
+	 * @brief Clears the stack, keeping any reserved capacity (O(1)).
+	 */
+	void clear() { vector.clear(); }
+
+	/**
+	 * @brief Displays the stack from bottom to top (O(n)).
+	 */
+	void show() const { vector.show(); }
+
+	/**
+	 * @brief Returns the length of the stack (O(1)).
+	 * @return The length of the stack.
+	 */
+	int length() const { return vector.length(); }
+
+	/**
+	 * @brief Returns the number of elements the stack can hold before it must grow (O(1)).
+	 * @return The capacity of the stack.
+	 */
+	int capacity() const { return vector.capacity(); }
+
+	/**
+	 * @brief Checks if the stack is empty (O(1)).
+	 * @return True if the stack is empty, false otherwise.
+	 */
+	bool isEmpty() const { return vector.isEmpty(); }
+
+	/**
+	 * @brief Checks if the stack contains a specific value (O(n)).
+	 * @param data The value to check for.
+	 * @return True if the value is present, false otherwise.
+	 */
+	bool contains(T data) const { return vector.contains(data); }
+
+	/**
+	 * @brief Pops an element off the stack (amortized O(1)).
+	 * @return The data popped from the stack.
+	 * @throws std::runtime_error If the stack is empty.
+	 */
+	T pop() { if (isEmpty()) throw std::runtime_error("Cannot pop from an empty stack"); return vector.pop(); }
+
+	/**
+	 * @brief Returns a reference to the element at the top of the stack without removing it (O(1)).
+	 * @return A reference to the data at the top of the stack, valid until the stack next resizes.
+	 * @throws std::runtime_error If the stack is empty.
+	 */
+	T& peek() { if (isEmpty()) throw std::runtime_error("Cannot peek an empty stack"); return vector.back(); }
+
+	/**
+	 * @brief Returns a reference to the element at the top of the stack without removing it (O(1)).
+	 * @return A const reference to the data at the top of the stack.
+	 * @throws std::runtime_error If the stack is empty.
+	 */
+	const T& peek() const { if (isEmpty()) throw std::runtime_error("Cannot peek an empty stack"); return vector.back(); }
+};
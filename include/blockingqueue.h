@@ -0,0 +1,325 @@
+/**
+ * @file blockingqueue.h
+ * @brief Thread-safe blocking queue implementation using a queue guarded by a mutex.
+ *
+ * This class wraps the linked-list queue with a mutex and condition variables so that
+ * consumers sleep while it is empty and, when a capacity is set, producers sleep while it
+ * is full. Waiting threads spin briefly on a lock-free length snapshot before parking, and
+ * threads only signal a condition variable when someone is parked on it.
+ *
+ * @tparam T The data type stored in the queue.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "queue.h"
+
+/**
+ * @class BlockingQueue
+ * @brief A thread-safe queue with blocking, timed and batched pops and optional back-pressure.
+ *
+ * Closing the queue rejects further pushes and wakes every waiting thread, while the
+ * elements already queued can still be drained by consumers.
+ *
+ * @tparam T The data type stored in the queue.
+ */
+template <class T>
+class BlockingQueue {
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	// Number of times a waiting thread polls before parking on a condition variable
+	static const int SPIN_LIMIT = 128;
+
+	Queue<T> queue;
+	int cap;
+	int waiting_consumers;
+	int waiting_producers;
+	std::atomic<int> len;
+	std::atomic<bool> closed;
+
+	mutable std::mutex mutex;
+	std::condition_variable not_empty;
+	std::condition_variable not_full;
+
+	/**
+	 * @brief Checks if the queue has reached its capacity. Requires the lock.
+	 * @return True if the queue is bounded and full, false otherwise.
+	 */
+	bool full() const { return cap > 0 && queue.length() >= cap; }
+
+	/**
+	 * @brief Polls a condition without the lock for a short while, yielding between later attempts.
+	 * @param ready The condition to poll.
+	 */
+	template <class Pred>
+	static void spin(Pred ready);
+
+	/**
+	 * @brief Waits until the queue has an element or is closed, parking after a brief spin. Requires the lock.
+	 * @param lock The held lock on the queue's mutex.
+	 * @param deadline The time to give up at, or nullptr to wait indefinitely.
+	 * @return True if the queue has an element, false if it is closed and drained or the deadline passed.
+	 */
+	bool awaitElement(std::unique_lock<std::mutex>& lock, const Clock::time_point* deadline);
+
+	/**
+	 * @brief Removes up to a given number of elements from the front of the queue and wakes parked producers. Requires the lock.
+	 * @param out The array to move the elements into.
+	 * @param max The maximum number of elements to remove.
+	 * @return The number of elements removed.
+	 */
+	int take(T out[], int max);
+
+	/**
+	 * @brief Adds an element to the back of the queue and wakes a parked consumer. Requires the lock.
+	 * @param lock The held lock on the queue's mutex, which is released before signalling.
+	 * @param data The data to push into the queue.
+	 */
+	void give(std::unique_lock<std::mutex>& lock, T data);
+
+public:
+	/**
+	 * @brief Constructs an empty queue (O(1)).
+	 * @param size The maximum number of elements, or 0 for an unbounded queue.
+	 * @throws std::invalid_argument If the capacity is negative.
+	 */
+	BlockingQueue(int size = 0);
+
+	BlockingQueue(const BlockingQueue&) = delete;
+	BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+	/**
+	 * @brief Destroys the queue (O(n)). No thread may still be using it.
+	 */
+	~BlockingQueue() {}
+
+	/**
+	 * @brief Adds an element to the back of the queue, waiting while it is full (O(1)).
+	 * @param data The data to push into the queue.
+	 * @return True if the element was added, false if the queue was closed.
+	 */
+	bool push(T data);
+
+	/**
+	 * @brief Adds an element to the back of the queue if there is room, without waiting (O(1)).
+	 * @param data The data to push into the queue.
+	 * @return True if the element was added, false if the queue was full or closed.
+	 */
+	bool tryPush(T data);
+
+	/**
+	 * @brief Closes the queue, rejecting further pushes and waking every waiting thread (O(1)).
+	 */
+	void close();
+
+	/**
+	 * @brief Removes an element from the front of the queue, waiting while it is empty (O(1)).
+	 * @return The data removed from the queue.
+	 * @throws std::runtime_error If the queue is closed and drained.
+	 */
+	T pop();
+
+	/**
+	 * @brief Removes an element from the front of the queue if there is one, without waiting (O(1)).
+	 * @param out Receives the removed element.
+	 * @return True if an element was removed, false if the queue was empty.
+	 */
+	bool tryPop(T& out);
+
+	/**
+	 * @brief Removes an element from the front of the queue, waiting at most a given time (O(1)).
+	 * @param timeout The longest time to wait for an element.
+	 * @param out Receives the removed element.
+	 * @return True if an element was removed, false if the timeout expired or the queue is closed and drained.
+	 */
+	template <class Rep, class Period>
+	bool popFor(const std::chrono::duration<Rep, Period>& timeout, T& out);
+
+	/**
+	 * @brief Removes up to a given number of elements, waiting only until the first is available (O(k)).
+	 *
+	 * All elements are taken under a single acquisition of the lock, amortizing the wakeup across the batch.
+	 *
+	 * @param max The maximum number of elements to remove.
+	 * @param out The array to move the elements into.
+	 * @return The number of elements removed, which is 0 only if the queue is closed and drained.
+	 */
+	int popMany(int max, T out[]);
+
+	/**
+	 * @brief Returns a snapshot of the length of the queue (O(1)).
+	 * @return The number of elements in the queue.
+	 */
+	int length() const { return len.load(std::memory_order_acquire); }
+
+	/**
+	 * @brief Returns the maximum number of elements the queue can hold (O(1)).
+	 * @return The capacity of the queue, or 0 if it is unbounded.
+	 */
+	int capacity() const { return cap; }
+
+	/**
+	 * @brief Checks if the queue is empty at the time of the call (O(1)).
+	 * @return True if the queue is empty, false otherwise.
+	 */
+	bool isEmpty() const { return length() == 0; }
+
+	/**
+	 * @brief Checks if the queue has been closed (O(1)).
+	 * @return True if the queue is closed, false otherwise.
+	 */
+	bool isClosed() const { return closed.load(std::memory_order_acquire); }
+};
+
+
+template <class T>
+BlockingQueue<T>::BlockingQueue(int size) : cap(size), waiting_consumers(0), waiting_producers(0), len(0), closed(false) {
+	if (size < 0) {
+		throw std::invalid_argument("Capacity must not be negative");
+	}
+}
+
+template <class T>
+template <class Pred>
+void BlockingQueue<T>::spin(Pred ready) {
+	for (int i = 0; i < SPIN_LIMIT && !ready(); i++) {
+		if (i >= SPIN_LIMIT / 2) {
+			std::this_thread::yield();
+		}
+	}
+}
+
+template <class T>
+bool BlockingQueue<T>::awaitElement(std::unique_lock<std::mutex>& lock, const Clock::time_point* deadline) {
+	if (queue.isEmpty() && !isClosed()) {
+		lock.unlock();
+		spin([this]() { return length() > 0 || isClosed(); });
+		lock.lock();
+	}
+
+	auto ready = [this]() { return !queue.isEmpty() || isClosed(); };
+	waiting_consumers++;
+	if (deadline == nullptr) {
+		not_empty.wait(lock, ready);
+	} else {
+		not_empty.wait_until(lock, *deadline, ready);
+	}
+	waiting_consumers--;
+	return !queue.isEmpty();
+}
+
+template <class T>
+int BlockingQueue<T>::take(T out[], int max) {
+	int count = 0;
+	while (count < max && !queue.isEmpty()) {
+		out[count++] = queue.pop();
+	}
+	len.store(queue.length(), std::memory_order_release);
+
+	if (count > 0 && waiting_producers > 0) {
+		if (count == 1) {
+			not_full.notify_one();
+		} else {
+			not_full.notify_all();
+		}
+	}
+	return count;
+}
+
+template <class T>
+void BlockingQueue<T>::give(std::unique_lock<std::mutex>& lock, T data) {
+	queue.push(data);
+	len.store(queue.length(), std::memory_order_release);
+	bool wake = waiting_consumers > 0;
+	lock.unlock();
+	if (wake) {
+		not_empty.notify_one();
+	}
+}
+
+template <class T>
+bool BlockingQueue<T>::push(T data) {
+	std::unique_lock<std::mutex> lock(mutex);
+	if (full() && !isClosed()) {
+		lock.unlock();
+		spin([this]() { return length() < cap || isClosed(); });
+		lock.lock();
+
+		waiting_producers++;
+		not_full.wait(lock, [this]() { return !full() || isClosed(); });
+		waiting_producers--;
+	}
+	if (isClosed()) {
+		return false;
+	}
+	give(lock, data);
+	return true;
+}
+
+template <class T>
+bool BlockingQueue<T>::tryPush(T data) {
+	std::unique_lock<std::mutex> lock(mutex);
+	if (full() || isClosed()) {
+		return false;
+	}
+	give(lock, data);
+	return true;
+}
+
+template <class T>
+void BlockingQueue<T>::close() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		closed.store(true, std::memory_order_release);
+	}
+	not_empty.notify_all();
+	not_full.notify_all();
+}
+
+template <class T>
+T BlockingQueue<T>::pop() {
+	std::unique_lock<std::mutex> lock(mutex);
+	if (!awaitElement(lock, nullptr)) {
+		throw std::runtime_error("Cannot pop from a closed and drained queue");
+	}
+	T data;
+	take(&data, 1);
+	return data;
+}
+
+template <class T>
+bool BlockingQueue<T>::tryPop(T& out) {
+	std::lock_guard<std::mutex> lock(mutex);
+	return take(&out, 1) == 1;
+}
+
+template <class T>
+template <class Rep, class Period>
+bool BlockingQueue<T>::popFor(const std::chrono::duration<Rep, Period>& timeout, T& out) {
+	Clock::time_point deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(timeout);
+	std::unique_lock<std::mutex> lock(mutex);
+	if (!awaitElement(lock, &deadline)) {
+		return false;
+	}
+	return take(&out, 1) == 1;
+}
+
+template <class T>
+int BlockingQueue<T>::popMany(int max, T out[]) {
+	if (max <= 0) {
+		return 0;
+	}
+	std::unique_lock<std::mutex> lock(mutex);
+	if (!awaitElement(lock, nullptr)) {
+		return 0;
+	}
+	return take(out, max);
+}
@@ -0,0 +1,325 @@
+/**
+ * @file clockcache.h
+ * @brief CLOCK (second-chance) cache implementation using a ring of slots and a HashTable.
+ *
+ * This class approximates least-recently-used eviction without keeping entries in recency
+ * order. Entries sit in a vector of slots treated as a ring, indexed by a HashTable whose
+ * elements are slot indices projected onto their keys, and each slot carries a referenced
+ * bit. A hit only sets that bit, so unlike an LRU list a hit writes one byte and moves
+ * nothing. To evict, a hand sweeps the ring: a referenced entry has its bit cleared and is
+ * passed over, and the first unreferenced entry is evicted. Every entry the hand passes
+ * loses its bit, so a sweep finds a victim within one revolution and eviction is amortized
+ * O(1). Freed slots are reused by later insertions.
+ *
+ * Capacity is measured in weight. By default every entry weighs 1, so the capacity is a
+ * number of entries; given a weight function, it can be a number of bytes or any other cost.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ * @tparam Hash The hash function on keys. If it declares is_transparent, lookups accept any type it can hash.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include "hashtable.h"
+#include "vector.h"
+
+/**
+ * @class ClockCache
+ * @brief A bounded map that evicts entries not used since the hand last passed them, with O(1) get and amortized O(1) put.
+ *
+ * The eviction callback runs after its entry has left the cache. It must not throw or modify the cache.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ * @tparam Hash The hash function on keys. If it declares is_transparent, lookups accept any type it can hash.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<>>
+class ClockCache {
+public:
+	typedef K KeyType;
+	typedef V ValueType;
+	typedef Hash Hasher;
+	typedef KeyEqual KeyEquality;
+	typedef std::function<std::int64_t(const K&, const V&)> Weigher;
+	typedef std::function<void(const K&, const V&)> Evictor;
+
+private:
+	/**
+	 * @struct Slot
+	 * @brief An entry, its weight and whether it has been used since the hand last passed it.
+	 */
+	struct Slot {
+		K key;
+		V value;
+		std::int64_t weight;
+		bool used;
+		bool referenced;
+	};
+
+	/**
+	 * @struct SlotKey
+	 * @brief Projects a slot index onto the slot's key.
+	 */
+	struct SlotKey {
+		const Vector<Slot>* slots;
+
+		const K& operator()(int idx) const { return (*slots)[idx].key; }
+	};
+
+	std::int64_t cap;
+	std::int64_t total;
+	Weigher weigh;
+	Evictor evict;
+	Vector<Slot> slots;
+	Vector<int> free_slots;
+	HashTable<int, SlotKey, Hash, KeyEqual> table;
+	int hand;
+
+	/**
+	 * @brief Returns the weight of an entry, checking it fits in the cache.
+	 * @param key The key.
+	 * @param value The value.
+	 * @return The weight.
+	 * @throws std::invalid_argument If the weight is negative or exceeds the capacity.
+	 */
+	std::int64_t weightOf(const K& key, const V& value) const;
+
+	/**
+	 * @brief Removes a slot's entry from the index.
+	 * @param idx The slot.
+	 */
+	void discard(int idx);
+
+	/**
+	 * @brief Returns a discarded slot to the free list, dropping its key and value.
+	 * @param idx The slot.
+	 */
+	void release(int idx);
+
+	/**
+	 * @brief Sweeps the hand, evicting unreferenced entries until an extra weight fits.
+	 * @param extra The weight to make room for.
+	 * @param keep A slot that must not be evicted, or -1 for none.
+	 */
+	void shrink(std::int64_t extra, int keep);
+
+public:
+	/**
+	 * @brief Constructs an empty cache (O(1)).
+	 * @param capacity The maximum total weight of the entries.
+	 * @param weigh The function giving the weight of an entry, or empty to give every entry a weight of 1.
+	 * @param evict The function to call with each entry evicted to make room, or empty for none.
+	 * @param hash The hash function on keys.
+	 * @param equal The equality predicate on keys.
+	 * @throws std::invalid_argument If the capacity is not positive.
+	 */
+	ClockCache(std::int64_t capacity, Weigher weigh = Weigher(), Evictor evict = Evictor(), Hash hash = Hash(), KeyEqual equal = KeyEqual());
+
+	ClockCache(const ClockCache&) = delete;
+	ClockCache& operator=(const ClockCache&) = delete;
+
+	/**
+	 * @brief Returns the value of a key and marks the entry as referenced (O(1) expected).
+	 * @param key The key to find.
+	 * @return A pointer to the value, valid until the cache is next modified, or nullptr if the key is not present.
+	 */
+	template <class Q>
+	V* get(const Q& key);
+
+	/**
+	 * @brief Returns the value of a key without marking the entry as referenced (O(1) expected).
+	 * @param key The key to find.
+	 * @return A pointer to the value, valid until the cache is next modified, or nullptr if the key is not present.
+	 */
+	template <class Q>
+	const V* peek(const Q& key) const;
+
+	/**
+	 * @brief Sets the value of a key, evicting entries to make room (amortized O(1)).
+	 *
+	 * A new entry starts unreferenced, so it is evicted on the hand's next pass unless it is used first.
+	 *
+	 * @param key The key.
+	 * @param value The value.
+	 * @return True if the key was inserted, false if its value was replaced.
+	 * @throws std::invalid_argument If the entry's weight is negative or exceeds the capacity.
+	 */
+	bool put(K key, V value);
+
+	/**
+	 * @brief Checks if a key is present, without marking the entry as referenced (O(1) expected).
+	 * @param key The key to find.
+	 * @return True if the key is present, false otherwise.
+	 */
+	template <class Q>
+	bool contains(const Q& key) const { return table.contains(key); }
+
+	/**
+	 * @brief Removes a key and its value without calling the eviction callback (O(1) expected).
+	 * @param key The key to remove.
+	 * @return True if the key was removed, false if it was not present.
+	 */
+	template <class Q>
+	bool remove(const Q& key);
+
+	/**
+	 * @brief Removes every entry without calling the eviction callback (O(n)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Returns the number of entries (O(1)).
+	 * @return The number of entries in the cache.
+	 */
+	int length() const { return table.length(); }
+
+	/**
+	 * @brief Returns the total weight of the entries (O(1)).
+	 * @return The weight in use.
+	 */
+	std::int64_t weight() const { return total; }
+
+	/**
+	 * @brief Returns the maximum total weight of the entries (O(1)).
+	 * @return The capacity.
+	 */
+	std::int64_t capacity() const { return cap; }
+
+	/**
+	 * @brief Checks if the cache is empty (O(1)).
+	 * @return True if the cache is empty, false otherwise.
+	 */
+	bool isEmpty() const { return table.isEmpty(); }
+};
+
+
+template <class K, class V, class Hash, class KeyEqual>
+ClockCache<K, V, Hash, KeyEqual>::ClockCache(std::int64_t capacity, Weigher weigh, Evictor evict, Hash hash, KeyEqual equal) : cap(capacity), total(0), weigh(std::move(weigh)), evict(std::move(evict)), table(0, SlotKey{&slots}, hash, equal), hand(0) {
+	if (capacity <= 0) {
+		throw std::invalid_argument("Capacity must be positive");
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+std::int64_t ClockCache<K, V, Hash, KeyEqual>::weightOf(const K& key, const V& value) const {
+	std::int64_t w = weigh ? weigh(key, value) : 1;
+	if (w < 0 || w > cap) {
+		throw std::invalid_argument("Entry weight must be between 0 and the capacity");
+	}
+	return w;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ClockCache<K, V, Hash, KeyEqual>::discard(int idx) {
+	table.remove(slots[idx].key);
+	total -= slots[idx].weight;
+	slots[idx].used = false;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ClockCache<K, V, Hash, KeyEqual>::release(int idx) {
+	slots[idx].key = K();
+	slots[idx].value = V();
+	free_slots.push(idx);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ClockCache<K, V, Hash, KeyEqual>::shrink(std::int64_t extra, int keep) {
+	while (total + extra > cap && table.length() > (keep == -1 ? 0 : 1)) {
+		if (hand >= slots.length()) {
+			hand = 0;
+		}
+		int idx = hand++;
+		Slot& slot = slots[idx];
+		if (!slot.used || idx == keep) {
+			continue;
+		}
+		if (slot.referenced) {
+			slot.referenced = false;
+			continue;
+		}
+		discard(idx);
+		if (evict) {
+			evict(slot.key, slot.value);
+		}
+		release(idx);
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Q>
+V* ClockCache<K, V, Hash, KeyEqual>::get(const Q& key) {
+	int* idx = table.find(key);
+	if (idx == nullptr) {
+		return nullptr;
+	}
+	Slot& slot = slots[*idx];
+	slot.referenced = true;
+	return &slot.value;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Q>
+const V* ClockCache<K, V, Hash, KeyEqual>::peek(const Q& key) const {
+	const int* idx = table.find(key);
+	return idx == nullptr ? nullptr : &slots[*idx].value;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+bool ClockCache<K, V, Hash, KeyEqual>::put(K key, V value) {
+	std::int64_t w = weightOf(key, value);
+	int* found = table.find(key);
+	if (found != nullptr) {
+		int idx = *found;
+		Slot& slot = slots[idx];
+		total += w - slot.weight;
+		slot.value = std::move(value);
+		slot.weight = w;
+		slot.referenced = true;
+		shrink(0, idx);
+		return false;
+	}
+
+	shrink(w, -1);
+	int idx;
+	if (free_slots.isEmpty()) {
+		idx = slots.length();
+		slots.push({std::move(key), std::move(value), w, true, false});
+	} else {
+		idx = free_slots.pop();
+		slots[idx] = {std::move(key), std::move(value), w, true, false};
+	}
+	table.insert(idx);
+	total += w;
+	return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Q>
+bool ClockCache<K, V, Hash, KeyEqual>::remove(const Q& key) {
+	int* idx = table.find(key);
+	if (idx == nullptr) {
+		return false;
+	}
+	int slot = *idx;
+	discard(slot);
+	release(slot);
+	return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ClockCache<K, V, Hash, KeyEqual>::clear() {
+	table.clear();
+	slots.clear();
+	free_slots.clear();
+	total = 0;
+	hand = 0;
+}
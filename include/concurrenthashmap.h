@@ -0,0 +1,711 @@
+/**
+ * @file concurrenthashmap.h
+ * @brief Concurrent hash map implementation using sharded open-addressing tables with seqlock reads.
+ *
+ * This class splits keys over shards by the top bits of their hash. Each shard is a linear
+ * probing table guarded by a mutex that only writers take, and a sequence counter that
+ * writers make odd for the duration of each change. Readers take no lock: they note the
+ * counter, probe the table, and retry if the counter was odd or has moved since, falling
+ * back to the mutex after a few failed attempts. Slots are stored as relaxed atomic words,
+ * so a read that overlaps a write is merely discarded rather than a data race.
+ *
+ * Each shard grows on its own, holding only its own mutex while it rehashes. A replaced
+ * table is retired rather than freed, since an optimistic reader may still be probing it;
+ * as tables double, the retired ones never take more memory than the live one. Removal
+ * shifts later entries of a cluster back instead of leaving tombstones.
+ *
+ * @tparam K The key type. It must be trivially copyable.
+ * @tparam V The value type. It must be trivially copyable.
+ * @tparam Hash The hash function on keys.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include "vector.h"
+
+/**
+ * @class ConcurrentHashMap
+ * @brief A hash map for any number of concurrent readers and writers, with lock-free reads.
+ *
+ * @tparam K The key type. It must be trivially copyable.
+ * @tparam V The value type. It must be trivially copyable.
+ * @tparam Hash The hash function on keys.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<>>
+class ConcurrentHashMap {
+	static_assert(std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>, "ConcurrentHashMap keys and values are read optimistically word by word");
+
+private:
+	// Assumed size of a cache line, used to keep shards from false sharing
+	static const std::size_t CACHE_LINE = 64;
+	// The minimum number of slots in a shard
+	static const int MIN_CAPACITY = 16;
+	// Maximum number of entries per 8 slots before a shard grows
+	static const int MAX_LOAD = 7;
+	// Number of lock-free read attempts before a reader takes the shard mutex
+	static const int OPTIMISTIC_ATTEMPTS = 4;
+	// Maximum number of keys looked up under a single sequence check by findMany
+	static const int READ_BATCH = 16;
+	// Number of 64-bit words holding a key and a value
+	static const int KEY_WORDS = (sizeof(K) + 7) / 8;
+	static const int VALUE_WORDS = (sizeof(V) + 7) / 8;
+	// Index returned by probes that find nothing
+	static const int NONE = -1;
+
+	/**
+	 * @struct Slot
+	 * @brief An entry stored as atomic words. Its tag is 0 when empty, and otherwise the key's hash with the low bit set.
+	 */
+	struct Slot {
+		std::atomic<std::uint64_t> tag;
+		std::atomic<std::uint64_t> key[KEY_WORDS];
+		std::atomic<std::uint64_t> value[VALUE_WORDS];
+	};
+
+	/**
+	 * @struct Table
+	 * @brief A power-of-two array of slots.
+	 */
+	struct Table {
+		int cap;
+		Slot* slots;
+	};
+
+	/**
+	 * @struct Shard
+	 * @brief A table, the writers' mutex and the sequence counter readers validate against.
+	 */
+	struct alignas(CACHE_LINE) Shard {
+		std::atomic<std::uint64_t> seq;
+		std::atomic<Table*> table;
+		std::atomic<int> len;
+		std::mutex lock;
+		Vector<Table*> retired;
+	};
+
+	Shard* shards;
+	int n_shards;
+	Hash hash;
+	KeyEqual equal;
+
+	/**
+	 * @brief Hashes a key, mixing the bits so that the shard and slot are independent.
+	 * @param key The key.
+	 * @return The mixed hash with its low bit set, as stored in a slot's tag.
+	 */
+	std::uint64_t hashOf(const K& key) const;
+
+	/**
+	 * @brief Returns the shard a hash belongs to.
+	 * @param h The tagged hash.
+	 * @return The index of the shard.
+	 */
+	int shardOf(std::uint64_t h) const { return static_cast<int>(((h >> 32) * static_cast<std::uint64_t>(n_shards)) >> 32); }
+
+	/**
+	 * @brief Returns the slot a probe for a hash starts at.
+	 * @param table The table.
+	 * @param h The tagged hash.
+	 * @return The home slot.
+	 */
+	static int home(const Table* table, std::uint64_t h) { return static_cast<int>((h >> 1) & static_cast<std::uint64_t>(table->cap - 1)); }
+
+	/**
+	 * @brief Stores a value into atomic words.
+	 * @param words The words to store into.
+	 * @param data The value.
+	 */
+	template <class X, int N>
+	static void storeWords(std::atomic<std::uint64_t> (&words)[N], const X& data);
+
+	/**
+	 * @brief Loads a value from atomic words.
+	 * @param words The words to load from.
+	 * @return The value.
+	 */
+	template <class X, int N>
+	static X loadWords(const std::atomic<std::uint64_t> (&words)[N]);
+
+	/**
+	 * @brief Copies the contents of one slot into another.
+	 * @param to The destination slot.
+	 * @param from The source slot.
+	 */
+	static void copySlot(Slot& to, const Slot& from);
+
+	/**
+	 * @brief Finds the slot holding a key. Safe to call without the lock, though the result is then only a guess.
+	 * @param table The table to probe.
+	 * @param key The key to find.
+	 * @param h The tagged hash of the key.
+	 * @return The slot of the key, or NONE if it was not found.
+	 */
+	int probe(const Table* table, const K& key, std::uint64_t h) const;
+
+	/**
+	 * @brief Makes a shard's sequence counter odd before a change. Requires the lock.
+	 * @param shard The shard.
+	 */
+	static void beginWrite(Shard& shard);
+
+	/**
+	 * @brief Makes a shard's sequence counter even again after a change. Requires the lock.
+	 * @param shard The shard.
+	 */
+	static void endWrite(Shard& shard) { shard.seq.store(shard.seq.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+	/**
+	 * @brief Grows a shard's table if it cannot take a number of further entries under the maximum load. Requires the lock.
+	 * @param shard The shard.
+	 * @param extra The number of entries about to be inserted.
+	 */
+	void ensure(Shard& shard, int extra);
+
+	/**
+	 * @brief Inserts a key, growing the table only if it is new, or updates its value if assign is set. Requires the lock and an odd sequence.
+	 * @param shard The shard.
+	 * @param key The key.
+	 * @param value The value.
+	 * @param h The tagged hash of the key.
+	 * @param assign Whether an existing key has its value replaced.
+	 * @return True if the key was inserted, false if it was already present.
+	 */
+	bool place(Shard& shard, const K& key, const V& value, std::uint64_t h, bool assign);
+
+	/**
+	 * @brief Looks up a batch of keys in one shard under a single sequence check, falling back to the lock.
+	 * @param shard The shard.
+	 * @param keys The keys.
+	 * @param hashes The tagged hashes of the keys.
+	 * @param idx The positions in keys of the batch.
+	 * @param count The number of keys in the batch.
+	 * @param out Receives the value of each key found, at its position.
+	 * @param found Receives whether each key was found, at its position.
+	 */
+	void readBatch(Shard& shard, const K keys[], const std::uint64_t hashes[], const int idx[], int count, V out[], bool found[]) const;
+
+	/**
+	 * @brief Sorts the positions of a batch of keys by shard.
+	 * @param hashes The tagged hashes of the keys.
+	 * @param size The number of keys.
+	 * @param order Receives the positions, grouped by shard.
+	 * @param starts Receives the start of each shard's group in order, followed by size.
+	 */
+	void groupByShard(const std::uint64_t hashes[], int size, int order[], int starts[]) const;
+
+public:
+	/**
+	 * @brief Constructs an empty map (O(shards)).
+	 * @param shards The number of shards, or 0 for four per hardware thread.
+	 * @param hash The hash function on keys.
+	 * @param equal The equality predicate on keys.
+	 * @throws std::invalid_argument If shards is negative.
+	 */
+	ConcurrentHashMap(int shards = 0, Hash hash = Hash(), KeyEqual equal = KeyEqual());
+
+	ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+	ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+	/**
+	 * @brief Destroys the map and every table, live or retired (O(capacity)). No thread may still be using it.
+	 */
+	~ConcurrentHashMap();
+
+	/**
+	 * @brief Inserts a key and value unless the key is present (amortized O(1)).
+	 * @param key The key.
+	 * @param value The value.
+	 * @return True if the entry was inserted, false if the key was already present.
+	 */
+	bool insert(const K& key, const V& value);
+
+	/**
+	 * @brief Sets the value of a key, inserting the key if it is not present (amortized O(1)).
+	 * @param key The key.
+	 * @param value The value.
+	 * @return True if the key was inserted, false if its value was replaced.
+	 */
+	bool set(const K& key, const V& value);
+
+	/**
+	 * @brief Sets the values of many keys, taking each shard's lock once (amortized O(n)).
+	 * @param keys The keys.
+	 * @param values The value of each key.
+	 * @param size The number of keys.
+	 * @return The number of keys that were inserted rather than updated.
+	 */
+	int insertMany(const K keys[], const V values[], int size);
+
+	/**
+	 * @brief Copies the value of a key, without locking unless writers keep interfering (O(1) expected).
+	 * @param key The key to find.
+	 * @param out Receives the value, if the key is present.
+	 * @return True if the key is present, false otherwise.
+	 */
+	bool find(const K& key, V& out) const;
+
+	/**
+	 * @brief Copies the values of many keys, checking each shard's sequence once per batch (O(n) expected).
+	 * @param keys The keys to find.
+	 * @param size The number of keys.
+	 * @param out Receives the value of each key found, at the key's position.
+	 * @param found Receives whether each key was found, at the key's position.
+	 * @return The number of keys found.
+	 */
+	int findMany(const K keys[], int size, V out[], bool found[]) const;
+
+	/**
+	 * @brief Checks if a key is present (O(1) expected).
+	 * @param key The key to find.
+	 * @return True if the key is present, false otherwise.
+	 */
+	bool contains(const K& key) const;
+
+	/**
+	 * @brief Removes a key and its value (O(1) expected).
+	 * @param key The key to remove.
+	 * @return True if the key was removed, false if it was not present.
+	 */
+	bool remove(const K& key);
+
+	/**
+	 * @brief Makes room for a number of entries spread evenly over the shards (O(capacity)).
+	 * @param size The number of entries to make room for.
+	 */
+	void reserve(int size);
+
+	/**
+	 * @brief Removes every entry, keeping the capacity of each shard (O(capacity)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Returns a snapshot of the number of entries (O(shards)).
+	 * @return The number of entries in the map.
+	 */
+	int length() const;
+
+	/**
+	 * @brief Checks if the map is empty at the time of the call (O(shards)).
+	 * @return True if the map is empty, false otherwise.
+	 */
+	bool isEmpty() const { return length() == 0; }
+
+	/**
+	 * @brief Returns the number of slots over all shards at the time of the call (O(shards)).
+	 * @return The total capacity of the live tables.
+	 */
+	int capacity() const;
+
+	/**
+	 * @brief Returns the number of shards (O(1)).
+	 * @return The number of independently locked tables.
+	 */
+	int shardCount() const { return n_shards; }
+};
+
+
+template <class K, class V, class Hash, class KeyEqual>
+ConcurrentHashMap<K, V, Hash, KeyEqual>::ConcurrentHashMap(int shards, Hash hash, KeyEqual equal) : shards(nullptr), n_shards(0), hash(hash), equal(equal) {
+	if (shards < 0) {
+		throw std::invalid_argument("Shard count must not be negative");
+	}
+	if (shards == 0) {
+		shards = 4 * std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+	n_shards = shards;
+	this->shards = new Shard[n_shards];
+	for (int i = 0; i < n_shards; i++) {
+		Shard& shard = this->shards[i];
+		shard.seq.store(0, std::memory_order_relaxed);
+		shard.len.store(0, std::memory_order_relaxed);
+		shard.table.store(new Table{MIN_CAPACITY, new Slot[MIN_CAPACITY]()}, std::memory_order_relaxed);
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+ConcurrentHashMap<K, V, Hash, KeyEqual>::~ConcurrentHashMap() {
+	for (int i = 0; i < n_shards; i++) {
+		Shard& shard = shards[i];
+		shard.retired.push(shard.table.load(std::memory_order_relaxed));
+		for (int j = 0; j < shard.retired.length(); j++) {
+			delete[] shard.retired[j]->slots;
+			delete shard.retired[j];
+		}
+	}
+	delete[] shards;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+std::uint64_t ConcurrentHashMap<K, V, Hash, KeyEqual>::hashOf(const K& key) const {
+	std::uint64_t h = static_cast<std::uint64_t>(hash(key)) * 0x9E3779B97F4A7C15ull;
+	return (h ^ (h >> 29)) | 1;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class X, int N>
+void ConcurrentHashMap<K, V, Hash, KeyEqual>::storeWords(std::atomic<std::uint64_t> (&words)[N], const X& data) {
+	std::uint64_t buffer[N] = {};
+	std::memcpy(buffer, &data, sizeof(X));
+	for (int i = 0; i < N; i++) {
+		words[i].store(buffer[i], std::memory_order_relaxed);
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class X, int N>
+X ConcurrentHashMap<K, V, Hash, KeyEqual>::loadWords(const std::atomic<std::uint64_t> (&words)[N]) {
+	std::uint64_t buffer[N];
+	for (int i = 0; i < N; i++) {
+		buffer[i] = words[i].load(std::memory_order_relaxed);
+	}
+	X data;
+	std::memcpy(&data, buffer, sizeof(X));
+	return data;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ConcurrentHashMap<K, V, Hash, KeyEqual>::copySlot(Slot& to, const Slot& from) {
+	for (int i = 0; i < KEY_WORDS; i++) {
+		to.key[i].store(from.key[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+	for (int i = 0; i < VALUE_WORDS; i++) {
+		to.value[i].store(from.value[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+	to.tag.store(from.tag.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+int ConcurrentHashMap<K, V, Hash, KeyEqual>::probe(const Table* table, const K& key, std::uint64_t h) const {
+	int mask = table->cap - 1;
+	int pos = home(table, h);
+	// A reader racing a writer may never see an empty slot, so the probe is bounded by the table
+	for (int step = 0; step < table->cap; step++) {
+		std::uint64_t tag = table->slots[pos].tag.load(std::memory_order_relaxed);
+		if (tag == 0) {
+			return NONE;
+		}
+		if (tag == h && equal(loadWords<K>(table->slots[pos].key), key)) {
+			return pos;
+		}
+		pos = (pos + 1) & mask;
+	}
+	return NONE;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ConcurrentHashMap<K, V, Hash, KeyEqual>::beginWrite(Shard& shard) {
+	shard.seq.store(shard.seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ConcurrentHashMap<K, V, Hash, KeyEqual>::ensure(Shard& shard, int extra) {
+	Table* table = shard.table.load(std::memory_order_relaxed);
+	long long needed = static_cast<long long>(shard.len.load(std::memory_order_relaxed)) + extra;
+	if (needed * 8 <= static_cast<long long>(table->cap) * MAX_LOAD) {
+		return;
+	}
+	int cap = table->cap;
+	while (needed * 8 > static_cast<long long>(cap) * MAX_LOAD) {
+		cap *= 2;
+	}
+
+	// The new table is private until published, and the old one is never written again
+	Table* grown = new Table{cap, new Slot[cap]()};
+	for (int i = 0; i < table->cap; i++) {
+		std::uint64_t tag = table->slots[i].tag.load(std::memory_order_relaxed);
+		if (tag == 0) {
+			continue;
+		}
+		int pos = home(grown, tag);
+		while (grown->slots[pos].tag.load(std::memory_order_relaxed) != 0) {
+			pos = (pos + 1) & (cap - 1);
+		}
+		copySlot(grown->slots[pos], table->slots[i]);
+	}
+	shard.retired.push(table);
+	shard.table.store(grown, std::memory_order_release);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual>::place(Shard& shard, const K& key, const V& value, std::uint64_t h, bool assign) {
+	Table* table = shard.table.load(std::memory_order_relaxed);
+	int idx = probe(table, key, h);
+	if (idx != NONE) {
+		if (assign) {
+			storeWords(table->slots[idx].value, value);
+		}
+		return false;
+	}
+	// Updates never grow the table, since a retired table is only freed with the map
+	ensure(shard, 1);
+	table = shard.table.load(std::memory_order_relaxed);
+	int pos = home(table, h);
+	while (table->slots[pos].tag.load(std::memory_order_relaxed) != 0) {
+		pos = (pos + 1) & (table->cap - 1);
+	}
+	storeWords(table->slots[pos].key, key);
+	storeWords(table->slots[pos].value, value);
+	table->slots[pos].tag.store(h, std::memory_order_relaxed);
+	shard.len.fetch_add(1, std::memory_order_relaxed);
+	return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual>::insert(const K& key, const V& value) {
+	std::uint64_t h = hashOf(key);
+	Shard& shard = shards[shardOf(h)];
+	std::lock_guard<std::mutex> lock(shard.lock);
+	Table* table = shard.table.load(std::memory_order_relaxed);
+	if (probe(table, key, h) != NONE) {
+		return false;
+	}
+	beginWrite(shard);
+	place(shard, key, value, h, false);
+	endWrite(shard);
+	return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual>::set(const K& key, const V& value) {
+	std::uint64_t h = hashOf(key);
+	Shard& shard = shards[shardOf(h)];
+	std::lock_guard<std::mutex> lock(shard.lock);
+	beginWrite(shard);
+	bool inserted = place(shard, key, value, h, true);
+	endWrite(shard);
+	return inserted;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ConcurrentHashMap<K, V, Hash, KeyEqual>::groupByShard(const std::uint64_t hashes[], int size, int order[], int starts[]) const {
+	for (int i = 0; i <= n_shards; i++) {
+		starts[i] = 0;
+	}
+	for (int i = 0; i < size; i++) {
+		starts[shardOf(hashes[i]) + 1]++;
+	}
+	for (int i = 0; i < n_shards; i++) {
+		starts[i + 1] += starts[i];
+	}
+	// Fill each group from its start, then shift the starts back into place
+	for (int i = 0; i < size; i++) {
+		order[starts[shardOf(hashes[i])]++] = i;
+	}
+	for (int i = n_shards; i > 0; i--) {
+		starts[i] = starts[i - 1];
+	}
+	starts[0] = 0;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+int ConcurrentHashMap<K, V, Hash, KeyEqual>::insertMany(const K keys[], const V values[], int size) {
+	if (size <= 0) {
+		return 0;
+	}
+	Vector<std::uint64_t> hashes(size);
+	Vector<int> order(size);
+	Vector<int> starts(n_shards + 1);
+	for (int i = 0; i < size; i++) {
+		hashes.push(hashOf(keys[i]));
+		order.push(0);
+	}
+	for (int i = 0; i <= n_shards; i++) {
+		starts.push(0);
+	}
+	groupByShard(&hashes[0], size, &order[0], &starts[0]);
+
+	int inserted = 0;
+	for (int s = 0; s < n_shards; s++) {
+		if (starts[s] == starts[s + 1]) {
+			continue;
+		}
+		Shard& shard = shards[s];
+		std::lock_guard<std::mutex> lock(shard.lock);
+		beginWrite(shard);
+		for (int j = starts[s]; j < starts[s + 1]; j++) {
+			int i = order[j];
+			if (place(shard, keys[i], values[i], hashes[i], true)) {
+				inserted++;
+			}
+		}
+		endWrite(shard);
+	}
+	return inserted;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ConcurrentHashMap<K, V, Hash, KeyEqual>::readBatch(Shard& shard, const K keys[], const std::uint64_t hashes[], const int idx[], int count, V out[], bool found[]) const {
+	for (int attempt = 0; attempt < OPTIMISTIC_ATTEMPTS; attempt++) {
+		std::uint64_t seq = shard.seq.load(std::memory_order_acquire);
+		if (seq & 1) {
+			std::this_thread::yield();
+			continue;
+		}
+		Table* table = shard.table.load(std::memory_order_acquire);
+#if defined(__GNUC__)
+		// Touch every home slot first, so the cache misses of a batch overlap
+		for (int j = 1; j < count; j++) {
+			__builtin_prefetch(&table->slots[home(table, hashes[idx[j]])]);
+		}
+#endif
+		for (int j = 0; j < count; j++) {
+			int i = idx[j];
+			int pos = probe(table, keys[i], hashes[i]);
+			found[i] = pos != NONE;
+			if (found[i]) {
+				out[i] = loadWords<V>(table->slots[pos].value);
+			}
+		}
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (shard.seq.load(std::memory_order_relaxed) == seq) {
+			return;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(shard.lock);
+	Table* table = shard.table.load(std::memory_order_relaxed);
+	for (int j = 0; j < count; j++) {
+		int i = idx[j];
+		int pos = probe(table, keys[i], hashes[i]);
+		found[i] = pos != NONE;
+		if (found[i]) {
+			out[i] = loadWords<V>(table->slots[pos].value);
+		}
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual>::find(const K& key, V& out) const {
+	std::uint64_t h = hashOf(key);
+	int idx = 0;
+	bool found;
+	readBatch(shards[shardOf(h)], &key, &h, &idx, 1, &out, &found);
+	return found;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+int ConcurrentHashMap<K, V, Hash, KeyEqual>::findMany(const K keys[], int size, V out[], bool found[]) const {
+	if (size <= 0) {
+		return 0;
+	}
+	Vector<std::uint64_t> hashes(size);
+	Vector<int> order(size);
+	Vector<int> starts(n_shards + 1);
+	for (int i = 0; i < size; i++) {
+		hashes.push(hashOf(keys[i]));
+		order.push(0);
+	}
+	for (int i = 0; i <= n_shards; i++) {
+		starts.push(0);
+	}
+	groupByShard(&hashes[0], size, &order[0], &starts[0]);
+
+	for (int s = 0; s < n_shards; s++) {
+		for (int j = starts[s]; j < starts[s + 1]; j += READ_BATCH) {
+			int count = starts[s + 1] - j < READ_BATCH ? starts[s + 1] - j : READ_BATCH;
+			readBatch(shards[s], keys, &hashes[0], &order[j], count, out, found);
+		}
+	}
+	int count = 0;
+	for (int i = 0; i < size; i++) {
+		count += found[i] ? 1 : 0;
+	}
+	return count;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual>::contains(const K& key) const {
+	V value;
+	return find(key, value);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+bool ConcurrentHashMap<K, V, Hash, KeyEqual>::remove(const K& key) {
+	std::uint64_t h = hashOf(key);
+	Shard& shard = shards[shardOf(h)];
+	std::lock_guard<std::mutex> lock(shard.lock);
+	Table* table = shard.table.load(std::memory_order_relaxed);
+	int idx = probe(table, key, h);
+	if (idx == NONE) {
+		return false;
+	}
+
+	int mask = table->cap - 1;
+	int hole = idx;
+	int next = idx;
+	beginWrite(shard);
+	while (true) {
+		next = (next + 1) & mask;
+		std::uint64_t tag = table->slots[next].tag.load(std::memory_order_relaxed);
+		if (tag == 0) {
+			break;
+		}
+		// An entry may fill the hole only if the hole lies between its home slot and where it is now
+		int start = home(table, tag);
+		if (((next - start) & mask) >= ((next - hole) & mask)) {
+			copySlot(table->slots[hole], table->slots[next]);
+			hole = next;
+		}
+	}
+	table->slots[hole].tag.store(0, std::memory_order_relaxed);
+	shard.len.fetch_sub(1, std::memory_order_relaxed);
+	endWrite(shard);
+	return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ConcurrentHashMap<K, V, Hash, KeyEqual>::reserve(int size) {
+	int per_shard = (size + n_shards - 1) / n_shards;
+	for (int i = 0; i < n_shards; i++) {
+		std::lock_guard<std::mutex> lock(shards[i].lock);
+		ensure(shards[i], per_shard - shards[i].len.load(std::memory_order_relaxed));
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void ConcurrentHashMap<K, V, Hash, KeyEqual>::clear() {
+	for (int i = 0; i < n_shards; i++) {
+		Shard& shard = shards[i];
+		std::lock_guard<std::mutex> lock(shard.lock);
+		Table* table = shard.table.load(std::memory_order_relaxed);
+		beginWrite(shard);
+		for (int j = 0; j < table->cap; j++) {
+			table->slots[j].tag.store(0, std::memory_order_relaxed);
+		}
+		shard.len.store(0, std::memory_order_relaxed);
+		endWrite(shard);
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+int ConcurrentHashMap<K, V, Hash, KeyEqual>::length() const {
+	int total = 0;
+	for (int i = 0; i < n_shards; i++) {
+		total += shards[i].len.load(std::memory_order_relaxed);
+	}
+	return total;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+int ConcurrentHashMap<K, V, Hash, KeyEqual>::capacity() const {
+	int total = 0;
+	for (int i = 0; i < n_shards; i++) {
+		total += shards[i].table.load(std::memory_order_acquire)->cap;
+	}
+	return total;
+}
@@ -0,0 +1,538 @@
+/**
+ * @file externalpqueue.h
+ * @brief External-memory priority queue implementation using sorted runs on disk.
+ *
+ * This class keeps a bounded in-memory PQueue for recently pushed elements. When it fills,
+ * its contents are written out in priority order as a sorted run, a temporary file written
+ * and later read back in large sequential blocks. Only one block of each run is held in
+ * memory, and the heads of those blocks are k-way merged through a second PQueue, so the
+ * next element is always the better of the in-memory top and the merge top.
+ *
+ * Runs are merged by level, as in a tiered log-structured merge. A spill writes a run at level
+ * 0, and whenever a level holds MAX_RUNS runs, the remaining contents of just those runs are
+ * merged into one run at the next level. Each element is therefore rewritten once per level,
+ * O(log(n / h)) times in all with h the size of the in-memory heap, rather than on every merge.
+ * The number of levels is capped, so the number of runs, and with it the memory taken by their
+ * blocks, is bounded however many elements the queue holds; only past MAX_RUNS ^ MAX_LEVELS
+ * spills does the top level start merging into itself.
+ *
+ * @tparam T The data type stored in the priority queue. It must be trivially copyable.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include "pqueue.h"
+#include "vector.h"
+
+/**
+ * @class ExternalPQueue
+ * @brief A priority queue whose size is limited by disk space rather than memory.
+ *
+ * @tparam T The data type stored in the priority queue. It must be trivially copyable.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+template <class T, class Compare = std::less<>, class Key = std::identity>
+class ExternalPQueue {
+	static_assert(std::is_trivially_copyable_v<T>, "ExternalPQueue elements are written to disk byte for byte");
+
+private:
+	// Number of runs at one level that are merged into a single run at the next level
+	static const int MAX_RUNS = 16;
+	// Number of levels of runs, the last of which merges into itself
+	static const int MAX_LEVELS = 4;
+	// Maximum number of runs with a block in memory at once: MAX_RUNS - 1 at every level but the one
+	// being merged, MAX_RUNS at that one, and the output of the merge
+	static const int MAX_OPEN = MAX_LEVELS * MAX_RUNS;
+	// Preferred size of a single read or write, in bytes
+	static const int BLOCK_BYTES = 1 << 20;
+	// Number of names tried before creating a spill file is given up on
+	static const int CREATE_ATTEMPTS = 16;
+
+	/**
+	 * @struct Run
+	 * @brief A sorted run on disk and the block of it currently in memory.
+	 */
+	struct Run {
+		std::FILE* file;
+		std::filesystem::path path;
+		T* block;
+		int pos;
+		int filled;
+		int level;
+	};
+
+	/**
+	 * @struct Cursor
+	 * @brief Where a run was being read from, so that its block can be read back after a failed merge.
+	 */
+	struct Cursor {
+		int run;
+		long offset;
+		int pos;
+		int filled;
+	};
+
+	/**
+	 * @struct Head
+	 * @brief The next element of a run, as ordered in the merge heap.
+	 */
+	struct Head {
+		T data;
+		int run;
+	};
+
+	/**
+	 * @struct HeadKey
+	 * @brief Projects a run head onto the key of its element.
+	 */
+	struct HeadKey {
+		Key key;
+
+		decltype(auto) operator()(const Head& head) const { return std::invoke(key, head.data); }
+	};
+
+	PQueue<T, Compare, Key> head;
+	PQueue<Head, Compare, HeadKey> merge;
+	Vector<Run*> runs;
+	T* staging;
+	int head_capacity;
+	int block;
+	int n_runs;
+	int level_runs[MAX_LEVELS];
+	std::uint64_t len;
+	std::uint64_t n_spilled;
+	std::filesystem::path directory;
+	bool max_heap;
+	Compare comp;
+	Key key;
+
+	/**
+	 * @brief Checks if one element has strictly higher priority than another.
+	 * @param data_1 The first element.
+	 * @param data_2 The second element.
+	 * @return True if data_1 would be popped before data_2, false otherwise.
+	 */
+	bool outranks(const T& data_1, const T& data_2) const;
+
+	/**
+	 * @brief Creates an empty spill file under a fresh name.
+	 * @return A run with an open file and an allocated block.
+	 * @throws std::runtime_error If no file could be created.
+	 */
+	Run* create();
+
+	/**
+	 * @brief Writes a block of elements to the end of a run.
+	 * @param run The run being written.
+	 * @param data The elements to write.
+	 * @param count The number of elements.
+	 * @throws std::runtime_error If the write fails.
+	 */
+	void write(Run* run, const T* data, int count);
+
+	/**
+	 * @brief Flushes everything written to a run out to its file.
+	 * @param run The run being written.
+	 * @throws std::runtime_error If the flush fails.
+	 */
+	void flush(Run* run);
+
+	/**
+	 * @brief Rewinds a finished run and adds it to the merge.
+	 * @param run The run that has been written.
+	 * @param level The level of the run.
+	 */
+	void open(Run* run, int level);
+
+	/**
+	 * @brief Deletes a run's file and frees its block.
+	 * @param run The run to destroy.
+	 */
+	void destroy(Run* run);
+
+	/**
+	 * @brief Moves a run on to its next element, reading its next block as needed.
+	 * @param run The run to move on.
+	 * @return True if the run has another element, false if it is exhausted.
+	 */
+	bool next(Run* run);
+
+	/**
+	 * @brief Pushes the next element of a run into the merge heap, destroying the run once it is exhausted.
+	 * @param idx The index of the run.
+	 */
+	void advance(int idx);
+
+	/**
+	 * @brief Writes the in-memory heap to a new run at level 0, then merges every level that has filled up.
+	 *
+	 * The heap is sorted in place and written straight from its array, and only cleared once the whole run
+	 * is on disk, so a failed write leaves every element in memory and the partial run deleted.
+	 */
+	void spill();
+
+	/**
+	 * @brief Merges the remaining contents of the runs at a level into a single run at the next level.
+	 *
+	 * The runs are read through their own blocks, but neither they nor the merge heap are changed until
+	 * the merged run is on disk. A failed merge deletes the partial run and reads each block back from
+	 * where it was, leaving the queue as it was before.
+	 *
+	 * @param level The level to merge.
+	 */
+	void mergeLevel(int level);
+
+public:
+	/**
+	 * @brief Constructs an empty priority queue (O(1)).
+	 * @param memory The number of elements held in memory, split between the in-memory heap and the run blocks.
+	 * @param directory The directory to create spill files in, or empty for the system temporary directory.
+	 * @param max_heap Indicates whether the queue pops its maximum (true) or minimum (false).
+	 * @param comp The comparator to order keys with.
+	 * @param key The projection from elements to keys.
+	 * @throws std::invalid_argument If memory is less than 2 * (MAX_OPEN + 1).
+	 */
+	ExternalPQueue(int memory = 1 << 22, std::string directory = "", bool max_heap = false, Compare comp = Compare(), Key key = Key());
+
+	ExternalPQueue(const ExternalPQueue&) = delete;
+	ExternalPQueue& operator=(const ExternalPQueue&) = delete;
+
+	/**
+	 * @brief Destroys the priority queue and deletes its spill files (O(r)).
+	 */
+	~ExternalPQueue();
+
+	/**
+	 * @brief Inserts an element, spilling the in-memory heap to disk if it is full (amortized O(log(n))).
+	 * @param data The element to be added.
+	 * @throws std::runtime_error If a spill file cannot be created or written.
+	 */
+	void push(T data);
+
+	/**
+	 * @brief Removes and returns the highest priority element (amortized O(log(n))).
+	 * @return The highest priority element.
+	 * @throws std::runtime_error If the priority queue is empty.
+	 */
+	T pop();
+
+	/**
+	 * @brief Returns the highest priority element (O(1)).
+	 * @return The highest priority element.
+	 * @throws std::runtime_error If the priority queue is empty.
+	 */
+	T peek() const;
+
+	/**
+	 * @brief Clears the priority queue and deletes its spill files (O(r)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Returns the length of the priority queue (O(1)).
+	 * @return The number of elements in the priority queue.
+	 */
+	std::uint64_t length() const { return len; }
+
+	/**
+	 * @brief Checks if the priority queue is empty (O(1)).
+	 * @return True if the priority queue is empty, false otherwise.
+	 */
+	bool isEmpty() const { return len == 0; }
+
+	/**
+	 * @brief Returns the number of elements the in-memory heap holds before it spills (O(1)).
+	 * @return The capacity of the in-memory heap.
+	 */
+	int heapCapacity() const { return head.capacity(); }
+
+	/**
+	 * @brief Returns the number of runs currently on disk (O(1)).
+	 * @return The number of runs.
+	 */
+	int runCount() const { return n_runs; }
+
+	/**
+	 * @brief Returns the number of elements written to disk so far, including rewrites by merges (O(1)).
+	 * @return The number of elements spilled.
+	 */
+	std::uint64_t spilled() const { return n_spilled; }
+
+	/**
+	 * @brief Checks if the priority queue is a maximum heap (O(1)).
+	 * @return True if the priority queue is a maximum heap, false otherwise.
+	 */
+	bool isMax() const { return max_heap; }
+
+	/**
+	 * @brief Checks if the priority queue is a minimum heap (O(1)).
+	 * @return True if the priority queue is a minimum heap, false otherwise.
+	 */
+	bool isMin() const { return !max_heap; }
+};
+
+
+template <class T, class Compare, class Key>
+ExternalPQueue<T, Compare, Key>::ExternalPQueue(int memory, std::string directory, bool max_heap, Compare comp, Key key) : head(max_heap, comp, key), merge(max_heap, comp, HeadKey{key}), staging(nullptr), head_capacity(0), block(0), n_runs(0), len(0), n_spilled(0), max_heap(max_heap), comp(comp), key(key) {
+	if (memory < 2 * (MAX_OPEN + 1)) {
+		throw std::invalid_argument("Memory must hold at least one block per run and the in-memory heap");
+	}
+	// Half of the budget goes to the in-memory heap, less the unused slot before its root, and half to the
+	// blocks of the runs and the staging buffer. The heap is allocated once at full size so it never regrows.
+	head_capacity = memory / 2 - 1;
+	head.reserve(head_capacity);
+	block = std::min(memory / 2 / (MAX_OPEN + 1), std::max(1, BLOCK_BYTES / static_cast<int>(sizeof(T))));
+	for (int i = 0; i < MAX_LEVELS; i++) {
+		level_runs[i] = 0;
+	}
+	this->directory = directory.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(directory);
+	staging = new T[block];
+}
+
+template <class T, class Compare, class Key>
+ExternalPQueue<T, Compare, Key>::~ExternalPQueue() {
+	clear();
+	delete[] staging;
+}
+
+template <class T, class Compare, class Key>
+bool ExternalPQueue<T, Compare, Key>::outranks(const T& data_1, const T& data_2) const {
+	if (max_heap) {
+		return comp(std::invoke(key, data_2), std::invoke(key, data_1));
+	}
+	return comp(std::invoke(key, data_1), std::invoke(key, data_2));
+}
+
+template <class T, class Compare, class Key>
+typename ExternalPQueue<T, Compare, Key>::Run* ExternalPQueue<T, Compare, Key>::create() {
+	std::random_device device;
+	for (int attempt = 0; attempt < CREATE_ATTEMPTS; attempt++) {
+		std::filesystem::path path = directory / ("strux-" + std::to_string(device()) + "-" + std::to_string(device()) + ".run");
+		// Exclusive mode fails rather than reuse a file another queue or process already owns
+		std::FILE* file = std::fopen(path.string().c_str(), "w+bx");
+		if (file != nullptr) {
+			return new Run{file, path, new T[block], 0, 0, 0};
+		}
+	}
+	throw std::runtime_error("Cannot create a spill file in " + directory.string());
+}
+
+template <class T, class Compare, class Key>
+void ExternalPQueue<T, Compare, Key>::write(Run* run, const T* data, int count) {
+	if (std::fwrite(data, sizeof(T), count, run->file) != static_cast<std::size_t>(count)) {
+		throw std::runtime_error("Cannot write to a spill file");
+	}
+	n_spilled += count;
+}
+
+template <class T, class Compare, class Key>
+void ExternalPQueue<T, Compare, Key>::flush(Run* run) {
+	if (std::fflush(run->file) != 0) {
+		throw std::runtime_error("Cannot write to a spill file");
+	}
+}
+
+template <class T, class Compare, class Key>
+void ExternalPQueue<T, Compare, Key>::open(Run* run, int level) {
+	std::fflush(run->file);
+	std::rewind(run->file);
+	int idx = 0;
+	while (idx < runs.length() && runs[idx] != nullptr) {
+		idx++;
+	}
+	if (idx == runs.length()) {
+		runs.push(run);
+	} else {
+		runs[idx] = run;
+	}
+	n_runs++;
+	run->level = level;
+	level_runs[level]++;
+	// An empty block makes advancing read the first one
+	run->pos = 0;
+	run->filled = 0;
+	advance(idx);
+}
+
+template <class T, class Compare, class Key>
+void ExternalPQueue<T, Compare, Key>::destroy(Run* run) {
+	std::fclose(run->file);
+	std::error_code error;
+	std::filesystem::remove(run->path, error);
+	delete[] run->block;
+	delete run;
+}
+
+template <class T, class Compare, class Key>
+bool ExternalPQueue<T, Compare, Key>::next(Run* run) {
+	run->pos++;
+	if (run->pos >= run->filled) {
+		run->filled = static_cast<int>(std::fread(run->block, sizeof(T), block, run->file));
+		run->pos = 0;
+	}
+	return run->filled > 0;
+}
+
+template <class T, class Compare, class Key>
+void ExternalPQueue<T, Compare, Key>::advance(int idx) {
+	Run* run = runs[idx];
+	if (!next(run)) {
+		level_runs[run->level]--;
+		destroy(run);
+		runs[idx] = nullptr;
+		n_runs--;
+		return;
+	}
+	merge.push({run->block[run->pos], idx});
+}
+
+template <class T, class Compare, class Key>
+void ExternalPQueue<T, Compare, Key>::mergeLevel(int level) {
+	// The head of every run is the element at the current position of its block, so the level's runs
+	// can be merged from copies of their heads while the main merge heap keeps the originals
+	PQueue<Head, Compare, HeadKey> group(max_heap, comp, HeadKey{key});
+	Vector<Cursor> cursors;
+	for (int i = 0; i < runs.length(); i++) {
+		Run* run = runs[i];
+		if (run != nullptr && run->level == level) {
+			cursors.push({i, std::ftell(run->file), run->pos, run->filled});
+			group.push({run->block[run->pos], i});
+		}
+	}
+
+	Run* out = nullptr;
+	try {
+		out = create();
+		int count = 0;
+		while (!group.isEmpty()) {
+			Head top = group.pop();
+			staging[count++] = top.data;
+			if (count == block) {
+				write(out, staging, count);
+				count = 0;
+			}
+			Run* run = runs[top.run];
+			if (next(run)) {
+				group.push({run->block[run->pos], top.run});
+			}
+		}
+		write(out, staging, count);
+		flush(out);
+	} catch (...) {
+		if (out != nullptr) {
+			destroy(out);
+		}
+		// Read each block back from where it started, so the runs continue from their old positions
+		for (int i = 0; i < cursors.length(); i++) {
+			Run* run = runs[cursors[i].run];
+			std::fseek(run->file, cursors[i].offset - static_cast<long>(cursors[i].filled * sizeof(T)), SEEK_SET);
+			run->filled = static_cast<int>(std::fread(run->block, sizeof(T), cursors[i].filled, run->file));
+			run->pos = cursors[i].pos;
+		}
+		throw;
+	}
+
+	// Only now that the merged run is on disk are the level's heads and runs retired
+	Vector<Head> others;
+	while (!merge.isEmpty()) {
+		Head top = merge.pop();
+		if (runs[top.run]->level != level) {
+			others.push(top);
+		}
+	}
+	for (int i = 0; i < others.length(); i++) {
+		merge.push(others[i]);
+	}
+	for (int i = 0; i < cursors.length(); i++) {
+		destroy(runs[cursors[i].run]);
+		runs[cursors[i].run] = nullptr;
+		n_runs--;
+	}
+	level_runs[level] = 0;
+	open(out, level + 1 < MAX_LEVELS ? level + 1 : level);
+}
+
+template <class T, class Compare, class Key>
+void ExternalPQueue<T, Compare, Key>::spill() {
+	Run* run = create();
+	try {
+		const T* sorted = head.sort();
+		for (int i = 0; i < head.length(); i += block) {
+			write(run, sorted + i, std::min(block, head.length() - i));
+		}
+		flush(run);
+	} catch (...) {
+		destroy(run);
+		throw;
+	}
+	head.clear();
+	open(run, 0);
+	// Merging a level adds a run to the next, which may fill that one in turn
+	for (int level = 0; level < MAX_LEVELS && level_runs[level] >= MAX_RUNS; level++) {
+		mergeLevel(level);
+	}
+}
+
+template <class T, class Compare, class Key>
+void ExternalPQueue<T, Compare, Key>::push(T data) {
+	if (head.length() >= head_capacity) {
+		spill();
+	}
+	head.push(data);
+	len++;
+}
+
+template <class T, class Compare, class Key>
+T ExternalPQueue<T, Compare, Key>::pop() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty priority queue");
+	}
+	len--;
+	if (!merge.isEmpty() && (head.isEmpty() || outranks(merge.peek().data, head.peek()))) {
+		Head top = merge.pop();
+		advance(top.run);
+		return top.data;
+	}
+	return head.pop();
+}
+
+template <class T, class Compare, class Key>
+T ExternalPQueue<T, Compare, Key>::peek() const {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot peek an empty priority queue");
+	}
+	if (!merge.isEmpty() && (head.isEmpty() || outranks(merge.peek().data, head.peek()))) {
+		return merge.peek().data;
+	}
+	return head.peek();
+}
+
+template <class T, class Compare, class Key>
+void ExternalPQueue<T, Compare, Key>::clear() {
+	for (int i = 0; i < runs.length(); i++) {
+		if (runs[i] != nullptr) {
+			destroy(runs[i]);
+		}
+	}
+	runs.clear();
+	merge.clear();
+	head.clear();
+	n_runs = 0;
+	for (int i = 0; i < MAX_LEVELS; i++) {
+		level_runs[i] = 0;
+	}
+	len = 0;
+}
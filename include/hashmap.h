@@ -0,0 +1,235 @@
+/**
+ * @file hashmap.h
+ * @brief Hash map implementation using an open-addressing HashTable of key-value entries.
+ *
+ * Keys are looked up with SIMD probing over control bytes and removed without tombstones,
+ * as described in hashtable.h. Lookups accept any type the hash and equality accept, so a
+ * map keyed by std::string can be searched with a std::string_view or a string literal
+ * when given a transparent hash.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ * @tparam Hash The hash function on keys. If it declares is_transparent, lookups accept any type it can hash.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <functional>
+#include <utility>
+#include "hashtable.h"
+
+/**
+ * @class HashMap
+ * @brief An unordered map from keys to values with O(1) expected lookup, insertion and removal.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ * @tparam Hash The hash function on keys. If it declares is_transparent, lookups accept any type it can hash.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<>>
+class HashMap {
+private:
+	/**
+	 * @struct Entry
+	 * @brief A key and its value.
+	 */
+	struct Entry {
+		K key;
+		V value;
+	};
+
+	/**
+	 * @struct EntryKey
+	 * @brief Projects an entry onto its key.
+	 */
+	struct EntryKey {
+		const K& operator()(const Entry& entry) const { return entry.key; }
+	};
+
+	HashTable<Entry, EntryKey, Hash, KeyEqual> table;
+
+public:
+	/**
+	 * @brief Constructs an empty map (O(size)).
+	 * @param size The number of entries to make room for.
+	 * @param hash The hash function on keys.
+	 * @param equal The equality predicate on keys.
+	 * @throws std::invalid_argument If size is negative.
+	 */
+	HashMap(int size = 0, Hash hash = Hash(), KeyEqual equal = KeyEqual()) : table(size, EntryKey(), hash, equal) {}
+
+	/**
+	 * @brief Inserts a key and value unless the key is present (amortized O(1)).
+	 * @param key The key.
+	 * @param value The value.
+	 * @return True if the entry was inserted, false if the key was already present.
+	 */
+	bool insert(K key, V value);
+
+	/**
+	 * @brief Sets the value of a key, inserting the key if it is not present (amortized O(1)).
+	 * @param key The key.
+	 * @param value The value.
+	 * @return True if the key was inserted, false if its value was replaced.
+	 */
+	bool set(K key, V value);
+
+	/**
+	 * @brief Returns the value of a key, inserting a default value if the key is not present (amortized O(1)).
+	 * @param key The key.
+	 * @return A reference to the value, valid until the map is next modified.
+	 */
+	V& operator[](const K& key);
+
+	/**
+	 * @brief Returns the value of a key (O(1) expected).
+	 * @param key The key to find.
+	 * @return A reference to the value, valid until the map is next modified.
+	 * @throws std::out_of_range If the key is not present.
+	 */
+	template <class Q>
+	V& get(const Q& key);
+
+	/**
+	 * @brief Returns the value of a key (O(1) expected).
+	 * @param key The key to find.
+	 * @return A const reference to the value, valid until the map is next modified.
+	 * @throws std::out_of_range If the key is not present.
+	 */
+	template <class Q>
+	const V& get(const Q& key) const;
+
+	/**
+	 * @brief Returns the value of a key, if present (O(1) expected).
+	 * @param key The key to find.
+	 * @return A pointer to the value, valid until the map is next modified, or nullptr if the key is not present.
+	 */
+	template <class Q>
+	V* find(const Q& key);
+
+	/**
+	 * @brief Returns the value of a key, if present (O(1) expected).
+	 * @param key The key to find.
+	 * @return A pointer to the value, valid until the map is next modified, or nullptr if the key is not present.
+	 */
+	template <class Q>
+	const V* find(const Q& key) const;
+
+	/**
+	 * @brief Checks if a key is present (O(1) expected).
+	 * @param key The key to find.
+	 * @return True if the key is present, false otherwise.
+	 */
+	template <class Q>
+	bool contains(const Q& key) const { return table.contains(key); }
+
+	/**
+	 * @brief Removes a key and its value (O(1) expected).
+	 * @param key The key to remove.
+	 * @return True if the key was removed, false if it was not present.
+	 */
+	template <class Q>
+	bool remove(const Q& key) { return table.remove(key); }
+
+	/**
+	 * @brief Makes room for a number of entries, so that inserting up to that many does not rehash (O(n)).
+	 * @param size The number of entries to make room for.
+	 */
+	void reserve(int size) { table.reserve(size); }
+
+	/**
+	 * @brief Removes every entry, keeping the capacity (O(capacity)).
+	 */
+	void clear() { table.clear(); }
+
+	/**
+	 * @brief Calls a function on every entry, in no particular order (O(capacity)).
+	 * @param fn The function to call with each key and a reference to its value.
+	 */
+	template <class F>
+	void forEach(F fn) { table.forEach([&](Entry& entry) { fn(static_cast<const K&>(entry.key), entry.value); }); }
+
+	/**
+	 * @brief Calls a function on every entry, in no particular order (O(capacity)).
+	 * @param fn The function to call with each key and a const reference to its value.
+	 */
+	template <class F>
+	void forEach(F fn) const { table.forEach([&](const Entry& entry) { fn(entry.key, entry.value); }); }
+
+	/**
+	 * @brief Returns the number of entries (O(1)).
+	 * @return The number of entries in the map.
+	 */
+	int length() const { return table.length(); }
+
+	/**
+	 * @brief Returns the number of slots (O(1)).
+	 * @return The capacity of the map.
+	 */
+	int capacity() const { return table.capacity(); }
+
+	/**
+	 * @brief Checks if the map is empty (O(1)).
+	 * @return True if the map is empty, false otherwise.
+	 */
+	bool isEmpty() const { return table.isEmpty(); }
+};
+
+
+template <class K, class V, class Hash, class KeyEqual>
+bool HashMap<K, V, Hash, KeyEqual>::insert(K key, V value) {
+	bool inserted;
+	table.findOrInsert(key, [&]() { return Entry{std::move(key), std::move(value)}; }, &inserted);
+	return inserted;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+bool HashMap<K, V, Hash, KeyEqual>::set(K key, V value) {
+	bool inserted;
+	Entry& entry = table.findOrInsert(key, [&]() { return Entry{key, V()}; }, &inserted);
+	entry.value = std::move(value);
+	return inserted;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+V& HashMap<K, V, Hash, KeyEqual>::operator[](const K& key) {
+	return table.findOrInsert(key, [&]() { return Entry{key, V()}; }).value;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Q>
+V& HashMap<K, V, Hash, KeyEqual>::get(const Q& key) {
+	Entry* entry = table.find(key);
+	if (entry == nullptr) {
+		throw std::out_of_range("Key not found");
+	}
+	return entry->value;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Q>
+const V& HashMap<K, V, Hash, KeyEqual>::get(const Q& key) const {
+	const Entry* entry = table.find(key);
+	if (entry == nullptr) {
+		throw std::out_of_range("Key not found");
+	}
+	return entry->value;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Q>
+V* HashMap<K, V, Hash, KeyEqual>::find(const Q& key) {
+	Entry* entry = table.find(key);
+	return entry == nullptr ? nullptr : &entry->value;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Q>
+const V* HashMap<K, V, Hash, KeyEqual>::find(const Q& key) const {
+	const Entry* entry = table.find(key);
+	return entry == nullptr ? nullptr : &entry->value;
+}
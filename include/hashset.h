@@ -0,0 +1,102 @@
+/**
+ * @file hashset.h
+ * @brief Hash set implementation using an open-addressing HashTable of keys.
+ *
+ * Keys are looked up with SIMD probing over control bytes and removed without tombstones,
+ * as described in hashtable.h.
+ *
+ * @tparam K The key type.
+ * @tparam Hash The hash function on keys. If it declares is_transparent, lookups accept any type it can hash.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <functional>
+#include <utility>
+#include "hashtable.h"
+
+/**
+ * @class HashSet
+ * @brief An unordered set of keys with O(1) expected lookup, insertion and removal.
+ *
+ * @tparam K The key type.
+ * @tparam Hash The hash function on keys. If it declares is_transparent, lookups accept any type it can hash.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+template <class K, class Hash = std::hash<K>, class KeyEqual = std::equal_to<>>
+class HashSet {
+private:
+	HashTable<K, std::identity, Hash, KeyEqual> table;
+
+public:
+	/**
+	 * @brief Constructs an empty set (O(size)).
+	 * @param size The number of keys to make room for.
+	 * @param hash The hash function on keys.
+	 * @param equal The equality predicate on keys.
+	 * @throws std::invalid_argument If size is negative.
+	 */
+	HashSet(int size = 0, Hash hash = Hash(), KeyEqual equal = KeyEqual()) : table(size, std::identity(), hash, equal) {}
+
+	/**
+	 * @brief Inserts a key unless it is present (amortized O(1)).
+	 * @param key The key to be added.
+	 * @return True if the key was inserted, false if it was already present.
+	 */
+	bool insert(K key) { return table.insert(std::move(key)); }
+
+	/**
+	 * @brief Checks if a key is present (O(1) expected).
+	 * @param key The key to find.
+	 * @return True if the key is present, false otherwise.
+	 */
+	template <class Q>
+	bool contains(const Q& key) const { return table.contains(key); }
+
+	/**
+	 * @brief Removes a key (O(1) expected).
+	 * @param key The key to remove.
+	 * @return True if the key was removed, false if it was not present.
+	 */
+	template <class Q>
+	bool remove(const Q& key) { return table.remove(key); }
+
+	/**
+	 * @brief Makes room for a number of keys, so that inserting up to that many does not rehash (O(n)).
+	 * @param size The number of keys to make room for.
+	 */
+	void reserve(int size) { table.reserve(size); }
+
+	/**
+	 * @brief Removes every key, keeping the capacity (O(capacity)).
+	 */
+	void clear() { table.clear(); }
+
+	/**
+	 * @brief Calls a function on every key, in no particular order (O(capacity)).
+	 * @param fn The function to call with a const reference to each key.
+	 */
+	template <class F>
+	void forEach(F fn) const { table.forEach(fn); }
+
+	/**
+	 * @brief Returns the number of keys (O(1)).
+	 * @return The number of keys in the set.
+	 */
+	int length() const { return table.length(); }
+
+	/**
+	 * @brief Returns the number of slots (O(1)).
+	 * @return The capacity of the set.
+	 */
+	int capacity() const { return table.capacity(); }
+
+	/**
+	 * @brief Checks if the set is empty (O(1)).
+	 * @return True if the set is empty, false otherwise.
+	 */
+	bool isEmpty() const { return table.isEmpty(); }
+};
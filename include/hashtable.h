@@ -0,0 +1,480 @@
+/**
+ * @file hashtable.h
+ * @brief Open-addressing hash table implementation using SIMD probing over control bytes.
+ *
+ * This class stores elements in a power-of-two array of slots alongside one control byte
+ * per slot, in the style of SwissTable. An empty slot's control byte is 0x80, and a full
+ * slot's holds 7 bits of its element's hash, so a probe compares 16 control bytes at once
+ * with SSE2 and only compares keys where those bits match. The first 15 control bytes are
+ * mirrored past the end of the array, so a group read never has to wrap around.
+ *
+ * Probing is linear from the slot selected by the remaining hash bits. Every element
+ * therefore lies between its home slot and the next empty slot, and a probe stops at the
+ * first group containing an empty slot. Removal keeps that invariant without tombstones:
+ * later elements of the cluster are shifted back into the hole whenever their home slot
+ * allows it, so lookups never slow down as elements are removed.
+ *
+ * @tparam T The data type stored in the table.
+ * @tparam Key The projection applied to each element to obtain its key.
+ * @tparam Hash The hash function on keys. If it declares is_transparent, lookups accept any type it can hash.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * @class HashTable
+ * @brief A hash table of elements identified by a key projected from each element.
+ *
+ * @tparam T The data type stored in the table.
+ * @tparam Key The projection applied to each element to obtain its key.
+ * @tparam Hash The hash function on keys. If it declares is_transparent, lookups accept any type it can hash.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+template <class T, class Key = std::identity, class Hash = std::hash<std::remove_cvref_t<std::invoke_result_t<Key&, const T&>>>, class KeyEqual = std::equal_to<>>
+class HashTable {
+private:
+	typedef std::remove_cvref_t<std::invoke_result_t<Key&, const T&>> KeyType;
+
+	// Number of control bytes compared in one probe step, the width of an SSE2 register
+	static const int GROUP = 16;
+	// Control byte of an empty slot; full slots hold 7 bits of their hash, so their top bit is clear
+	static const std::int8_t EMPTY = -128;
+	// Maximum number of elements per 8 slots before the table grows
+	static const int MAX_LOAD = 7;
+	// Index returned by lookups that find nothing
+	static const int NONE = -1;
+
+	std::int8_t* ctrl;
+	T* slots;
+	int cap;
+	int len;
+	Key key;
+	Hash hash;
+	KeyEqual equal;
+
+	/**
+	 * @brief Hashes a key, mixing the bits so that the home slot and tag are independent.
+	 * @param lookup The key, or a value comparable with keys if the hash is transparent.
+	 * @return The mixed 64-bit hash.
+	 */
+	template <class Q>
+	std::uint64_t hashOf(const Q& lookup) const;
+
+	/**
+	 * @brief Returns the slot a probe for a hash starts at.
+	 * @param h The mixed hash.
+	 * @return The home slot.
+	 */
+	int home(std::uint64_t h) const { return static_cast<int>((h >> 7) & static_cast<std::uint64_t>(cap - 1)); }
+
+	/**
+	 * @brief Returns the control byte of a full slot for a hash.
+	 * @param h The mixed hash.
+	 * @return The 7-bit tag.
+	 */
+	static std::int8_t tag(std::uint64_t h) { return static_cast<std::int8_t>(h & 0x7F); }
+
+	/**
+	 * @brief Returns a bit for each control byte in a group equal to a value.
+	 * @param group The first control byte of the group.
+	 * @param value The control byte to look for.
+	 * @return A mask with bit i set if group[i] equals value.
+	 */
+	static std::uint32_t match(const std::int8_t* group, std::int8_t value);
+
+	/**
+	 * @brief Sets a slot's control byte, along with its mirror if it has one.
+	 * @param idx The slot.
+	 * @param value The control byte.
+	 */
+	void setCtrl(int idx, std::int8_t value);
+
+	/**
+	 * @brief Finds the slot holding a key.
+	 * @param lookup The key to find.
+	 * @param h The mixed hash of the key.
+	 * @return The slot of the key, or NONE if it is not in the table.
+	 */
+	template <class Q>
+	int locate(const Q& lookup, std::uint64_t h) const;
+
+	/**
+	 * @brief Finds the first empty slot at or after the home slot of a hash.
+	 * @param h The mixed hash.
+	 * @return The empty slot.
+	 */
+	int firstEmpty(std::uint64_t h) const;
+
+	/**
+	 * @brief Moves every element into a new array of slots.
+	 * @param capacity The new number of slots, a power of two of at least GROUP.
+	 */
+	void rehash(int capacity);
+
+	/**
+	 * @brief Empties a slot, shifting later elements of its cluster back to fill the hole.
+	 * @param idx The slot to empty.
+	 */
+	void erase(int idx);
+
+	/**
+	 * @brief Returns the smallest valid capacity that holds a number of elements under the maximum load.
+	 * @param size The number of elements.
+	 * @return The capacity.
+	 */
+	static int capacityFor(int size);
+
+public:
+	/**
+	 * @brief Constructs an empty table (O(size)).
+	 * @param size The number of elements to make room for.
+	 * @param key The projection from elements to keys.
+	 * @param hash The hash function on keys.
+	 * @param equal The equality predicate on keys.
+	 * @throws std::invalid_argument If size is negative.
+	 */
+	HashTable(int size = 0, Key key = Key(), Hash hash = Hash(), KeyEqual equal = KeyEqual());
+
+	HashTable(const HashTable&) = delete;
+	HashTable& operator=(const HashTable&) = delete;
+
+	/**
+	 * @brief Destroys the table and frees the associated memory (O(n)).
+	 */
+	~HashTable() { delete[] ctrl; delete[] slots; }
+
+	/**
+	 * @brief Inserts an element unless one with the same key is present (amortized O(1)).
+	 * @param data The element to be added.
+	 * @return True if the element was inserted, false if its key was already present.
+	 */
+	bool insert(T data);
+
+	/**
+	 * @brief Returns the element with a key, first inserting one built by a function if there is none (amortized O(1)).
+	 * @param lookup The key to find.
+	 * @param make A function returning the element to insert, whose key must equal lookup.
+	 * @param inserted Receives whether an element was inserted, if not nullptr.
+	 * @return A reference to the element, valid until the table is next modified.
+	 */
+	template <class Q, class Make>
+	T& findOrInsert(const Q& lookup, Make make, bool* inserted = nullptr);
+
+	/**
+	 * @brief Returns the element with a key (O(1) expected).
+	 * @param lookup The key to find.
+	 * @return A pointer to the element, valid until the table is next modified, or nullptr if there is none.
+	 */
+	template <class Q>
+	T* find(const Q& lookup);
+
+	/**
+	 * @brief Returns the element with a key (O(1) expected).
+	 * @param lookup The key to find.
+	 * @return A pointer to the element, valid until the table is next modified, or nullptr if there is none.
+	 */
+	template <class Q>
+	const T* find(const Q& lookup) const;
+
+	/**
+	 * @brief Checks if an element with a key is present (O(1) expected).
+	 * @param lookup The key to find.
+	 * @return True if the key is present, false otherwise.
+	 */
+	template <class Q>
+	bool contains(const Q& lookup) const { return locate(lookup, hashOf(lookup)) != NONE; }
+
+	/**
+	 * @brief Removes the element with a key (O(1) expected).
+	 * @param lookup The key to remove.
+	 * @return True if an element was removed, false if the key was not present.
+	 */
+	template <class Q>
+	bool remove(const Q& lookup);
+
+	/**
+	 * @brief Makes room for a number of elements, so that inserting up to that many does not rehash (O(n)).
+	 * @param size The number of elements to make room for.
+	 */
+	void reserve(int size);
+
+	/**
+	 * @brief Removes every element, keeping the capacity (O(capacity)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Calls a function on every element, in no particular order (O(capacity)).
+	 * @param fn The function to call with a reference to each element. It must not modify keys.
+	 */
+	template <class F>
+	void forEach(F fn);
+
+	/**
+	 * @brief Calls a function on every element, in no particular order (O(capacity)).
+	 * @param fn The function to call with a const reference to each element.
+	 */
+	template <class F>
+	void forEach(F fn) const;
+
+	/**
+	 * @brief Returns the number of elements (O(1)).
+	 * @return The number of elements in the table.
+	 */
+	int length() const { return len; }
+
+	/**
+	 * @brief Returns the number of slots (O(1)).
+	 * @return The capacity of the table.
+	 */
+	int capacity() const { return cap; }
+
+	/**
+	 * @brief Checks if the table is empty (O(1)).
+	 * @return True if the table is empty, false otherwise.
+	 */
+	bool isEmpty() const { return len == 0; }
+};
+
+
+template <class T, class Key, class Hash, class KeyEqual>
+HashTable<T, Key, Hash, KeyEqual>::HashTable(int size, Key key, Hash hash, KeyEqual equal) : ctrl(nullptr), slots(nullptr), cap(0), len(0), key(key), hash(hash), equal(equal) {
+	if (size < 0) {
+		throw std::invalid_argument("Size must not be negative");
+	}
+	rehash(capacityFor(size));
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+template <class Q>
+std::uint64_t HashTable<T, Key, Hash, KeyEqual>::hashOf(const Q& lookup) const {
+	std::uint64_t h;
+	if constexpr (requires { typename Hash::is_transparent; }) {
+		h = static_cast<std::uint64_t>(hash(lookup));
+	} else {
+		h = static_cast<std::uint64_t>(hash(static_cast<const KeyType&>(lookup)));
+	}
+	// Standard hashes may be the identity, so spread every input bit over the whole word
+	h *= 0x9E3779B97F4A7C15ull;
+	return h ^ (h >> 32);
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+std::uint32_t HashTable<T, Key, Hash, KeyEqual>::match(const std::int8_t* group, std::int8_t value) {
+#if defined(__SSE2__)
+	__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+	return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#else
+	std::uint32_t mask = 0;
+	for (int i = 0; i < GROUP; i++) {
+		if (group[i] == value) {
+			mask |= 1u << i;
+		}
+	}
+	return mask;
+#endif
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+void HashTable<T, Key, Hash, KeyEqual>::setCtrl(int idx, std::int8_t value) {
+	ctrl[idx] = value;
+	if (idx < GROUP - 1) {
+		ctrl[cap + idx] = value;
+	}
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+int HashTable<T, Key, Hash, KeyEqual>::capacityFor(int size) {
+	long long needed = (static_cast<long long>(size) * 8 + MAX_LOAD - 1) / MAX_LOAD;
+	return static_cast<int>(std::bit_ceil(static_cast<unsigned long long>(needed > GROUP ? needed : GROUP)));
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+template <class Q>
+int HashTable<T, Key, Hash, KeyEqual>::locate(const Q& lookup, std::uint64_t h) const {
+	std::int8_t t = tag(h);
+	int pos = home(h);
+	while (true) {
+		const std::int8_t* group = ctrl + pos;
+		std::uint32_t empty = match(group, EMPTY);
+		// Elements never lie past the first empty slot of their probe
+		std::uint32_t candidates = match(group, t) & (empty != 0 ? (empty & -empty) - 1 : ~0u);
+		while (candidates != 0) {
+			int idx = (pos + std::countr_zero(candidates)) & (cap - 1);
+			if (equal(std::invoke(key, slots[idx]), lookup)) {
+				return idx;
+			}
+			candidates &= candidates - 1;
+		}
+		if (empty != 0) {
+			return NONE;
+		}
+		pos = (pos + GROUP) & (cap - 1);
+	}
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+int HashTable<T, Key, Hash, KeyEqual>::firstEmpty(std::uint64_t h) const {
+	int pos = home(h);
+	while (true) {
+		std::uint32_t empty = match(ctrl + pos, EMPTY);
+		if (empty != 0) {
+			return (pos + std::countr_zero(empty)) & (cap - 1);
+		}
+		pos = (pos + GROUP) & (cap - 1);
+	}
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+void HashTable<T, Key, Hash, KeyEqual>::rehash(int capacity) {
+	std::int8_t* old_ctrl = ctrl;
+	T* old_slots = slots;
+	int old_cap = cap;
+
+	cap = capacity;
+	ctrl = new std::int8_t[cap + GROUP - 1];
+	slots = new T[cap];
+	for (int i = 0; i < cap + GROUP - 1; i++) {
+		ctrl[i] = EMPTY;
+	}
+	for (int i = 0; i < old_cap; i++) {
+		if (old_ctrl[i] != EMPTY) {
+			std::uint64_t h = hashOf(std::invoke(key, old_slots[i]));
+			int idx = firstEmpty(h);
+			slots[idx] = std::move(old_slots[i]);
+			setCtrl(idx, tag(h));
+		}
+	}
+	delete[] old_ctrl;
+	delete[] old_slots;
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+void HashTable<T, Key, Hash, KeyEqual>::erase(int idx) {
+	int hole = idx;
+	int next = idx;
+	while (true) {
+		next = (next + 1) & (cap - 1);
+		if (ctrl[next] == EMPTY) {
+			break;
+		}
+		// An element may fill the hole only if the hole lies between its home slot and where it is now
+		int start = home(hashOf(std::invoke(key, slots[next])));
+		if (((next - start) & (cap - 1)) >= ((next - hole) & (cap - 1))) {
+			slots[hole] = std::move(slots[next]);
+			setCtrl(hole, ctrl[next]);
+			hole = next;
+		}
+	}
+	slots[hole] = T();
+	setCtrl(hole, EMPTY);
+	len--;
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+template <class Q, class Make>
+T& HashTable<T, Key, Hash, KeyEqual>::findOrInsert(const Q& lookup, Make make, bool* inserted) {
+	std::uint64_t h = hashOf(lookup);
+	int idx = locate(lookup, h);
+	if (inserted != nullptr) {
+		*inserted = idx == NONE;
+	}
+	if (idx != NONE) {
+		return slots[idx];
+	}
+
+	if (static_cast<long long>(len + 1) * 8 > static_cast<long long>(cap) * MAX_LOAD) {
+		rehash(cap * 2);
+	}
+	idx = firstEmpty(h);
+	slots[idx] = make();
+	setCtrl(idx, tag(h));
+	len++;
+	return slots[idx];
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+bool HashTable<T, Key, Hash, KeyEqual>::insert(T data) {
+	bool inserted;
+	findOrInsert(std::invoke(key, data), [&]() { return std::move(data); }, &inserted);
+	return inserted;
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+template <class Q>
+T* HashTable<T, Key, Hash, KeyEqual>::find(const Q& lookup) {
+	int idx = locate(lookup, hashOf(lookup));
+	return idx == NONE ? nullptr : &slots[idx];
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+template <class Q>
+const T* HashTable<T, Key, Hash, KeyEqual>::find(const Q& lookup) const {
+	int idx = locate(lookup, hashOf(lookup));
+	return idx == NONE ? nullptr : &slots[idx];
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+template <class Q>
+bool HashTable<T, Key, Hash, KeyEqual>::remove(const Q& lookup) {
+	int idx = locate(lookup, hashOf(lookup));
+	if (idx == NONE) {
+		return false;
+	}
+	erase(idx);
+	return true;
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+void HashTable<T, Key, Hash, KeyEqual>::reserve(int size) {
+	int capacity = capacityFor(size);
+	if (capacity > cap) {
+		rehash(capacity);
+	}
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+void HashTable<T, Key, Hash, KeyEqual>::clear() {
+	for (int i = 0; i < cap; i++) {
+		if (ctrl[i] != EMPTY) {
+			slots[i] = T();
+		}
+	}
+	for (int i = 0; i < cap + GROUP - 1; i++) {
+		ctrl[i] = EMPTY;
+	}
+	len = 0;
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+template <class F>
+void HashTable<T, Key, Hash, KeyEqual>::forEach(F fn) {
+	for (int i = 0; i < cap; i++) {
+		if (ctrl[i] != EMPTY) {
+			fn(slots[i]);
+		}
+	}
+}
+
+template <class T, class Key, class Hash, class KeyEqual>
+template <class F>
+void HashTable<T, Key, Hash, KeyEqual>::forEach(F fn) const {
+	for (int i = 0; i < cap; i++) {
+		if (ctrl[i] != EMPTY) {
+			fn(static_cast<const T&>(slots[i]));
+		}
+	}
+}
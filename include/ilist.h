@@ -0,0 +1,323 @@
+/**
+ * @file ilist.h
+ * @brief Intrusive doubly linked list implementation with zero allocation.
+ *
+ * This class links objects through a hook embedded in the objects themselves, so
+ * insertion and removal never allocate and an object can be removed in O(1) given a
+ * reference to it. An object may sit on several lists at once by inheriting one hook
+ * per list, each distinguished by a tag type.
+ *
+ * @tparam T The object type linked into the list.
+ * @tparam Tag The tag selecting which of the object's hooks the list uses.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * @struct ListHook
+ * @brief A hook embedded in an object so that it can be linked into an IntrusiveList.
+ *
+ * Objects inherit one hook per list they can belong to simultaneously. Copying an
+ * object never copies its links, so a copy always starts unlinked. The hook records the
+ * list it is linked into, so an object moving between lists with the same tag cannot be
+ * unlinked through the wrong one.
+ *
+ * @tparam Tag The tag distinguishing this hook from the object's other hooks.
+ */
+template <class Tag = void>
+struct ListHook {
+	ListHook* prev;
+	ListHook* next;
+	const void* owner;
+
+	ListHook() : prev(nullptr), next(nullptr), owner(nullptr) {}
+	ListHook(const ListHook&) : prev(nullptr), next(nullptr), owner(nullptr) {}
+	ListHook& operator=(const ListHook&) { return *this; }
+
+	/**
+	 * @brief Checks if the hook is currently linked into a list (O(1)).
+	 * @return True if the hook is linked, false otherwise.
+	 */
+	bool isLinked() const { return next != nullptr; }
+};
+
+/**
+ * @class IntrusiveList
+ * @brief A circular doubly linked list that links objects through an embedded ListHook.
+ *
+ * The list never owns its objects: they must outlive their membership of the list,
+ * and clearing or destroying the list only unlinks them.
+ *
+ * @tparam T The object type linked into the list, which must inherit ListHook<Tag>.
+ * @tparam Tag The tag selecting which of the object's hooks the list uses.
+ */
+template <class T, class Tag = void>
+class IntrusiveList {
+private:
+	typedef ListHook<Tag> Hook;
+
+	// Sentinel node, linked to itself when the list is empty
+	Hook root;
+	int len;
+
+	static Hook* hook(T& data) { return static_cast<Hook*>(&data); }
+	static const Hook* hook(const T& data) { return static_cast<const Hook*>(&data); }
+	static T& object(Hook* node) { return *static_cast<T*>(node); }
+
+	/**
+	 * @brief Links a hook directly before another hook.
+	 * @param pos The hook to link before.
+	 * @param node The hook to link.
+	 * @throws std::runtime_error If the hook is already linked into a list.
+	 */
+	void link(Hook* pos, Hook* node);
+
+	/**
+	 * @brief Unlinks a hook from the list and resets it.
+	 * @param node The hook to unlink.
+	 */
+	void unlink(Hook* node);
+
+public:
+	/**
+	 * @class Iterator
+	 * @brief A bidirectional iterator over the objects in the list.
+	 */
+	class Iterator {
+	private:
+		Hook* node;
+
+	public:
+		Iterator(Hook* node) : node(node) {}
+		T& operator*() const { return object(node); }
+		T* operator->() const { return &object(node); }
+		Iterator& operator++() { node = node->next; return *this; }
+		Iterator& operator--() { node = node->prev; return *this; }
+		bool operator==(const Iterator& other) const { return node == other.node; }
+		bool operator!=(const Iterator& other) const { return node != other.node; }
+	};
+
+	/**
+	 * @brief Constructs a new empty intrusive list (O(1)).
+	 */
+	IntrusiveList() : len(0) { root.prev = root.next = &root; }
+
+	IntrusiveList(const IntrusiveList&) = delete;
+	IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+	/**
+	 * @brief Destroys the list, unlinking but not freeing every object (O(n)).
+	 */
+	~IntrusiveList() { clear(); }
+
+	/**
+	 * @brief Links an object to the back of the list (O(1)).
+	 * @param data The object to link.
+	 * @throws std::runtime_error If the object is already linked into a list with this tag.
+	 */
+	void push(T& data) { link(&root, hook(data)); }
+
+	/**
+	 * @brief Links an object to the front of the list (O(1)).
+	 * @param data The object to link.
+	 * @throws std::runtime_error If the object is already linked into a list with this tag.
+	 */
+	void pushFront(T& data) { link(root.next, hook(data)); }
+
+	/**
+	 * @brief Links an object directly after an object already in the list (O(1)).
+	 * @param pos An object in this list.
+	 * @param data The object to link.
+	 * @throws std::runtime_error If pos is not in this list, or the object is already linked into a list with this tag.
+	 */
+	void insertAfter(T& pos, T& data);
+
+	/**
+	 * @brief Unlinks an object from anywhere in the list (O(1)).
+	 * @param data An object in this list.
+	 * @return True if the object was unlinked, false if it was not linked.
+	 * @throws std::runtime_error If the object is linked into a different list with this tag.
+	 */
+	bool remove(T& data);
+
+	/**
+	 * @brief Unlinks every object from the list (O(n)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Reverses the list (O(n)).
+	 */
+	void reverse();
+
+	/**
+	 * @brief Displays the list (O(n)).
+	 */
+	void show() const;
+
+	/**
+	 * @brief Returns the length of the list (O(1)).
+	 * @return The length of the list.
+	 */
+	int length() const { return len; }
+
+	/**
+	 * @brief Checks if the list is empty (O(1)).
+	 * @return True if the list is empty, false otherwise.
+	 */
+	bool isEmpty() const { return len == 0; }
+
+	/**
+	 * @brief Checks if a specific object is linked into this list (O(1)).
+	 * @param data The object to check for.
+	 * @return True if the object is in this list, false otherwise.
+	 */
+	bool contains(const T& data) const;
+
+	/**
+	 * @brief Unlinks the object at the back of the list and returns it (O(1)).
+	 * @return The object at the back of the list.
+	 * @throws std::runtime_error If the list is empty.
+	 */
+	T& pop();
+
+	/**
+	 * @brief Unlinks the object at the front of the list and returns it (O(1)).
+	 * @return The object at the front of the list.
+	 * @throws std::runtime_error If the list is empty.
+	 */
+	T& popFront();
+
+	/**
+	 * @brief Returns the object at the front of the list without unlinking it (O(1)).
+	 * @return The object at the front of the list.
+	 * @throws std::runtime_error If the list is empty.
+	 */
+	T& peek() const { if (isEmpty()) throw std::runtime_error("Cannot peek an empty list"); return object(root.next); }
+
+	/**
+	 * @brief Returns the object at the back of the list without unlinking it (O(1)).
+	 * @return The object at the back of the list.
+	 * @throws std::runtime_error If the list is empty.
+	 */
+	T& peekBack() const { if (isEmpty()) throw std::runtime_error("Cannot peek an empty list"); return object(root.prev); }
+
+	/**
+	 * @brief Returns an iterator to the front of the list (O(1)).
+	 * @return An iterator to the first object.
+	 */
+	Iterator begin() { return Iterator(root.next); }
+
+	/**
+	 * @brief Returns an iterator past the back of the list (O(1)).
+	 * @return An iterator to the sentinel.
+	 */
+	Iterator end() { return Iterator(&root); }
+};
+
+
+template <class T, class Tag>
+void IntrusiveList<T, Tag>::link(Hook* pos, Hook* node) {
+	if (node->isLinked()) {
+		throw std::runtime_error("Cannot link an object that is already in a list");
+	}
+	node->next = pos;
+	node->prev = pos->prev;
+	node->owner = this;
+	pos->prev->next = node;
+	pos->prev = node;
+	len++;
+}
+
+template <class T, class Tag>
+void IntrusiveList<T, Tag>::unlink(Hook* node) {
+	node->prev->next = node->next;
+	node->next->prev = node->prev;
+	node->prev = node->next = nullptr;
+	node->owner = nullptr;
+	len--;
+}
+
+template <class T, class Tag>
+void IntrusiveList<T, Tag>::insertAfter(T& pos, T& data) {
+	if (hook(pos)->owner != this) {
+		throw std::runtime_error("Cannot insert after an object that is not in this list");
+	}
+	link(hook(pos)->next, hook(data));
+}
+
+template <class T, class Tag>
+bool IntrusiveList<T, Tag>::remove(T& data) {
+	Hook* node = hook(data);
+	if (!node->isLinked()) {
+		return false;
+	}
+	if (node->owner != this) {
+		throw std::runtime_error("Cannot remove an object linked into a different list");
+	}
+	unlink(node);
+	return true;
+}
+
+template <class T, class Tag>
+void IntrusiveList<T, Tag>::clear() {
+	Hook* curr = root.next;
+	while (curr != &root) {
+		Hook* temp = curr->next;
+		curr->prev = curr->next = nullptr;
+		curr->owner = nullptr;
+		curr = temp;
+	}
+	root.prev = root.next = &root;
+	len = 0;
+}
+
+template <class T, class Tag>
+void IntrusiveList<T, Tag>::reverse() {
+	Hook* curr = &root;
+	do {
+		Hook* temp = curr->next;
+		curr->next = curr->prev;
+		curr->prev = temp;
+		curr = temp;
+	} while (curr != &root);
+}
+
+template <class T, class Tag>
+void IntrusiveList<T, Tag>::show() const {
+	for (const Hook* curr = root.next; curr != &root; curr = curr->next) {
+		if (curr != root.next) {
+			std::cout << ", ";
+		}
+		std::cout << *static_cast<const T*>(curr);
+	}
+	std::cout << std::endl;
+}
+
+template <class T, class Tag>
+bool IntrusiveList<T, Tag>::contains(const T& data) const {
+	return hook(data)->owner == this;
+}
+
+template <class T, class Tag>
+T& IntrusiveList<T, Tag>::pop() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty list");
+	}
+	Hook* node = root.prev;
+	unlink(node);
+	return object(node);
+}
+
+template <class T, class Tag>
+T& IntrusiveList<T, Tag>::popFront() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty list");
+	}
+	Hook* node = root.next;
+	unlink(node);
+	return object(node);
+}
@@ -0,0 +1,427 @@
+/**
+ * @file indexedpqueue.h
+ * @brief Indexed priority queue implementation using a binary heap of handles.
+ *
+ * This class implements a priority queue whose elements are addressed by stable handles
+ * returned from push. The heap stores handles rather than elements, and a position map
+ * records where each handle sits in the heap, updated on every move. This lets an
+ * element's priority be changed or the element be erased in O(log n) without searching,
+ * as needed by Dijkstra's algorithm, A* and deadline schedulers.
+ *
+ * @tparam T The data type stored in the priority queue.
+ * @tparam Compare The strict weak ordering on keys, where Compare(a, b) means a has higher priority in a min-heap.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <functional>
+#include <string>
+#include <utility>
+#include "vector.h"
+
+/**
+ * @class IndexedPQueue
+ * @brief A priority queue with handles supporting decrease-key, increase-key and erase in O(log n).
+ *
+ * A handle stays valid until its element is popped or erased, after which it may be
+ * handed out again by a later push. As in PQueue, the heap direction is chosen once per
+ * operation and the sift loops are instantiated separately for each.
+ *
+ * @tparam T The data type stored in the priority queue.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+template <class T, class Compare = std::less<>, class Key = std::identity>
+class IndexedPQueue {
+private:
+	// Position recorded for a handle that is not in the heap
+	static const int NONE = -1;
+
+	Vector<int> heap;
+	Vector<int> positions;
+	Vector<T> values;
+	Vector<int> free_handles;
+	bool max_heap;
+	Compare comp;
+	Key key;
+
+	/**
+	 * @brief Checks if one element must sit above another.
+	 * @param data_1 The first element.
+	 * @param data_2 The second element.
+	 * @return True if data_1 has strictly higher priority than data_2, false otherwise.
+	 */
+	template <bool Max>
+	bool compare(const T& data_1, const T& data_2) const;
+
+	/**
+	 * @brief Writes a handle into a heap position and records the position in the map.
+	 * @param idx The heap position.
+	 * @param handle The handle to place.
+	 */
+	void place(int idx, int handle) { heap[idx] = handle; positions[handle] = idx; }
+
+	/**
+	 * @brief Moves the handle at a position up until its parent has no lower priority.
+	 * @param idx The position of the handle to move up.
+	 * @return The position the handle settled at.
+	 */
+	template <bool Max>
+	int heapifyUp(int idx);
+
+	/**
+	 * @brief Moves the handle at a position down until no child has higher priority.
+	 * @param idx The position of the handle to move down.
+	 * @return The position the handle settled at.
+	 */
+	template <bool Max>
+	int heapifyDown(int idx);
+
+	/**
+	 * @brief Restores the heap property after the element at a position has changed in either direction.
+	 * @param idx The position of the changed element.
+	 */
+	void restore(int idx);
+
+	/**
+	 * @brief Checks that a handle refers to an element in the priority queue.
+	 * @param handle The handle to check.
+	 * @throws std::out_of_range If the handle is not in the priority queue.
+	 */
+	void check(int handle) const;
+
+	/**
+	 * @brief Removes the element at a heap position and releases its handle.
+	 * @param idx The heap position of the element.
+	 * @return The removed element.
+	 */
+	T remove(int idx);
+
+public:
+	/**
+	 * @brief Constructs a new indexed priority queue (O(1)).
+	 * @param max_heap Indicates whether the heap is a max-heap (true) or min-heap (false).
+	 * @param comp The comparator to order keys with.
+	 * @param key The projection from elements to keys.
+	 */
+	IndexedPQueue(bool max_heap = false, Compare comp = Compare(), Key key = Key()) : max_heap(max_heap), comp(comp), key(key) {}
+
+	IndexedPQueue(const IndexedPQueue&) = delete;
+	IndexedPQueue& operator=(const IndexedPQueue&) = delete;
+
+	/**
+	 * @brief Inserts an element into the priority queue (O(log(n))).
+	 * @param data The element to be added.
+	 * @return The handle of the new element.
+	 */
+	int push(T data);
+
+	/**
+	 * @brief Replaces an element with one of equal or higher priority (O(log(n))).
+	 * @param handle The handle of the element.
+	 * @param data The new value of the element.
+	 * @throws std::out_of_range If the handle is not in the priority queue.
+	 * @throws std::invalid_argument If the new value has lower priority than the old one.
+	 */
+	void decreaseKey(int handle, T data);
+
+	/**
+	 * @brief Replaces an element with one of equal or lower priority (O(log(n))).
+	 * @param handle The handle of the element.
+	 * @param data The new value of the element.
+	 * @throws std::out_of_range If the handle is not in the priority queue.
+	 * @throws std::invalid_argument If the new value has higher priority than the old one.
+	 */
+	void increaseKey(int handle, T data);
+
+	/**
+	 * @brief Replaces an element with a value of any priority (O(log(n))).
+	 * @param handle The handle of the element.
+	 * @param data The new value of the element.
+	 * @throws std::out_of_range If the handle is not in the priority queue.
+	 */
+	void update(int handle, T data);
+
+	/**
+	 * @brief Removes an element by its handle (O(log(n))).
+	 * @param handle The handle of the element.
+	 * @return True if the element was removed, false if the handle was not in the priority queue.
+	 */
+	bool erase(int handle);
+
+	/**
+	 * @brief Clears the priority queue, invalidating every handle (O(1)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Returns the length of the priority queue (O(1)).
+	 * @return The number of elements in the priority queue.
+	 */
+	int length() const { return heap.length(); }
+
+	/**
+	 * @brief Checks if the priority queue is empty (O(1)).
+	 * @return True if the priority queue is empty, false otherwise.
+	 */
+	bool isEmpty() const { return length() == 0; }
+
+	/**
+	 * @brief Checks if a handle refers to an element in the priority queue (O(1)).
+	 * @param handle The handle to check for.
+	 * @return True if the handle is in the priority queue, false otherwise.
+	 */
+	bool contains(int handle) const { return handle >= 0 && handle < positions.length() && positions[handle] != NONE; }
+
+	/**
+	 * @brief Returns the element with a given handle (O(1)).
+	 * @param handle The handle of the element.
+	 * @return The value of the element.
+	 * @throws std::out_of_range If the handle is not in the priority queue.
+	 */
+	T get(int handle) const;
+
+	/**
+	 * @brief Checks if the priority queue is a maximum heap (O(1)).
+	 * @return True if the priority queue is a maximum heap, false otherwise.
+	 */
+	bool isMax() const { return max_heap; }
+
+	/**
+	 * @brief Checks if the priority queue is a minimum heap (O(1)).
+	 * @return True if the priority queue is a minimum heap, false otherwise.
+	 */
+	bool isMin() const { return !max_heap; }
+
+	/**
+	 * @brief Checks if the heap property and the position map are still consistent (O(n)).
+	 * @return True if both hold, false otherwise.
+	 */
+	bool validHeap() const;
+
+	/**
+	 * @brief Removes and returns the element with the highest priority (O(log(n))).
+	 * @return The element with the highest priority.
+	 * @throws std::runtime_error If the priority queue is empty.
+	 */
+	T pop();
+
+	/**
+	 * @brief Returns the element with the highest priority (O(1)).
+	 * @return The element with the highest priority.
+	 * @throws std::runtime_error If the priority queue is empty.
+	 */
+	T peek() const;
+
+	/**
+	 * @brief Returns the handle of the element with the highest priority (O(1)).
+	 * @return The handle of the element with the highest priority.
+	 * @throws std::runtime_error If the priority queue is empty.
+	 */
+	int peekHandle() const;
+};
+
+
+template <class T, class Compare, class Key>
+template <bool Max>
+bool IndexedPQueue<T, Compare, Key>::compare(const T& data_1, const T& data_2) const {
+	if constexpr (Max) {
+		return comp(std::invoke(key, data_2), std::invoke(key, data_1));
+	} else {
+		return comp(std::invoke(key, data_1), std::invoke(key, data_2));
+	}
+}
+
+template <class T, class Compare, class Key>
+template <bool Max>
+int IndexedPQueue<T, Compare, Key>::heapifyUp(int idx) {
+	int handle = heap[idx];
+	while (idx > 0) {
+		int parent = (idx - 1) / 2;
+		if (!compare<Max>(values[handle], values[heap[parent]])) {
+			break;
+		}
+		place(idx, heap[parent]);
+		idx = parent;
+	}
+	place(idx, handle);
+	return idx;
+}
+
+template <class T, class Compare, class Key>
+template <bool Max>
+int IndexedPQueue<T, Compare, Key>::heapifyDown(int idx) {
+	int handle = heap[idx];
+	int n = length();
+	while (true) {
+		int best = 2 * idx + 1;
+		if (best >= n) {
+			break;
+		}
+		if (best + 1 < n && compare<Max>(values[heap[best + 1]], values[heap[best]])) {
+			best++;
+		}
+		if (!compare<Max>(values[heap[best]], values[handle])) {
+			break;
+		}
+		place(idx, heap[best]);
+		idx = best;
+	}
+	place(idx, handle);
+	return idx;
+}
+
+template <class T, class Compare, class Key>
+void IndexedPQueue<T, Compare, Key>::restore(int idx) {
+	if (max_heap) {
+		if (heapifyDown<true>(idx) == idx) {
+			heapifyUp<true>(idx);
+		}
+	} else {
+		if (heapifyDown<false>(idx) == idx) {
+			heapifyUp<false>(idx);
+		}
+	}
+}
+
+template <class T, class Compare, class Key>
+void IndexedPQueue<T, Compare, Key>::check(int handle) const {
+	if (!contains(handle)) {
+		throw std::out_of_range("Handle " + std::to_string(handle) + " is not in the priority queue");
+	}
+}
+
+template <class T, class Compare, class Key>
+T IndexedPQueue<T, Compare, Key>::remove(int idx) {
+	int handle = heap[idx];
+	T r_data = std::move(values[handle]);
+	positions[handle] = NONE;
+	free_handles.push(handle);
+
+	int last = heap.pop();
+	if (idx < length()) {
+		place(idx, last);
+		restore(idx);
+	}
+	return r_data;
+}
+
+template <class T, class Compare, class Key>
+int IndexedPQueue<T, Compare, Key>::push(T data) {
+	int handle;
+	if (free_handles.isEmpty()) {
+		handle = values.length();
+		values.push(data);
+		positions.push(NONE);
+	} else {
+		handle = free_handles.pop();
+		values[handle] = data;
+	}
+	heap.push(handle);
+	positions[handle] = length() - 1;
+	if (max_heap) {
+		heapifyUp<true>(length() - 1);
+	} else {
+		heapifyUp<false>(length() - 1);
+	}
+	return handle;
+}
+
+template <class T, class Compare, class Key>
+void IndexedPQueue<T, Compare, Key>::decreaseKey(int handle, T data) {
+	check(handle);
+	if (max_heap ? compare<true>(values[handle], data) : compare<false>(values[handle], data)) {
+		throw std::invalid_argument("New key has lower priority than the current key");
+	}
+	values[handle] = data;
+	if (max_heap) {
+		heapifyUp<true>(positions[handle]);
+	} else {
+		heapifyUp<false>(positions[handle]);
+	}
+}
+
+template <class T, class Compare, class Key>
+void IndexedPQueue<T, Compare, Key>::increaseKey(int handle, T data) {
+	check(handle);
+	if (max_heap ? compare<true>(data, values[handle]) : compare<false>(data, values[handle])) {
+		throw std::invalid_argument("New key has higher priority than the current key");
+	}
+	values[handle] = data;
+	if (max_heap) {
+		heapifyDown<true>(positions[handle]);
+	} else {
+		heapifyDown<false>(positions[handle]);
+	}
+}
+
+template <class T, class Compare, class Key>
+void IndexedPQueue<T, Compare, Key>::update(int handle, T data) {
+	check(handle);
+	values[handle] = data;
+	restore(positions[handle]);
+}
+
+template <class T, class Compare, class Key>
+bool IndexedPQueue<T, Compare, Key>::erase(int handle) {
+	if (!contains(handle)) {
+		return false;
+	}
+	remove(positions[handle]);
+	return true;
+}
+
+template <class T, class Compare, class Key>
+void IndexedPQueue<T, Compare, Key>::clear() {
+	heap.clear();
+	positions.clear();
+	values.clear();
+	free_handles.clear();
+}
+
+template <class T, class Compare, class Key>
+T IndexedPQueue<T, Compare, Key>::get(int handle) const {
+	check(handle);
+	return values[handle];
+}
+
+template <class T, class Compare, class Key>
+bool IndexedPQueue<T, Compare, Key>::validHeap() const {
+	for (int i = 0; i < length(); i++) {
+		if (positions[heap[i]] != i) {
+			return false;
+		}
+		if (i == 0) {
+			continue;
+		}
+		const T& parent = values[heap[(i - 1) / 2]];
+		if (max_heap ? compare<true>(values[heap[i]], parent) : compare<false>(values[heap[i]], parent)) {
+			return false;
+		}
+	}
+	return length() + free_handles.length() == values.length();
+}
+
+template <class T, class Compare, class Key>
+T IndexedPQueue<T, Compare, Key>::pop() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty priority queue");
+	}
+	return remove(0);
+}
+
+template <class T, class Compare, class Key>
+T IndexedPQueue<T, Compare, Key>::peek() const {
+	return values[peekHandle()];
+}
+
+template <class T, class Compare, class Key>
+int IndexedPQueue<T, Compare, Key>::peekHandle() const {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot peek an empty priority queue");
+	}
+	return heap[0];
+}
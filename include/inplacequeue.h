@@ -0,0 +1,175 @@
+/**
+ * @file inplacequeue.h
+ * @brief Fixed-capacity queue implementation using a circular buffer inside the object.
+ *
+ * This class never touches the heap: its elements are stored in a circular array member,
+ * so an InplaceQueue can live on the stack or inside another object and is safe to use
+ * where allocation is banned. Once the capacity is reached, pushes fail instead of growing.
+ *
+ * @tparam T The data type stored in the queue.
+ * @tparam N The capacity of the queue.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @class InplaceQueue
+ * @brief A fixed-capacity queue implemented using an in-place circular buffer.
+ *
+ * @tparam T The data type stored in the queue.
+ * @tparam N The capacity of the queue.
+ */
+template <class T, int N>
+class InplaceQueue {
+	static_assert(N > 0, "InplaceQueue capacity must be positive");
+
+private:
+	T s_array[N];
+	int head;
+	int len;
+
+	/**
+	 * @brief Returns the physical index of a logical position in the queue.
+	 * @param idx The logical position, counted from the front.
+	 * @return The index into the circular buffer.
+	 */
+	int wrap(int idx) const { idx += head; return idx >= N ? idx - N : idx; }
+
+public:
+	/**
+	 * @brief Constructs an empty queue (O(1)).
+	 */
+	InplaceQueue() : head(0), len(0) {}
+
+	/**
+	 * @brief Adds an element to the back of the queue (O(1)).
+	 * @param data The data to push into the queue.
+	 * @throws std::length_error If the queue is full.
+	 */
+	void push(T data) { if (!tryPush(data)) throw std::length_error("Cannot push to a full queue"); }
+
+	/**
+	 * @brief Clears the queue (O(1)).
+	 */
+	void clear() { head = len = 0; }
+
+	/**
+	 * @brief Displays the queue (O(n)).
+	 */
+	void show() const;
+
+	/**
+	 * @brief Returns the length of the queue (O(1)).
+	 * @return The length of the queue.
+	 */
+	int length() const { return len; }
+
+	/**
+	 * @brief Returns the fixed capacity of the queue (O(1)).
+	 * @return The capacity of the queue.
+	 */
+	int capacity() const { return N; }
+
+	/**
+	 * @brief Adds an element to the back of the queue if there is room (O(1)).
+	 * @param data The data to push into the queue.
+	 * @return True if the element was added, false if the queue was full.
+	 */
+	bool tryPush(T data);
+
+	/**
+	 * @brief Checks if the queue is empty (O(1)).
+	 * @return True if the queue is empty, false otherwise.
+	 */
+	bool isEmpty() const { return len == 0; }
+
+	/**
+	 * @brief Checks if the queue is at full capacity (O(1)).
+	 * @return True if the queue is full, false otherwise.
+	 */
+	bool isFull() const { return len == N; }
+
+	/**
+	 * @brief Checks if the queue contains a specific value (O(n)).
+	 * @param data The value to check for.
+	 * @return True if the value is present, false otherwise.
+	 */
+	bool contains(T data) const;
+
+	/**
+	 * @brief Returns the element at a specific position from the front of the queue (O(1)).
+	 * @param idx The position to get the element from.
+	 * @return The element at the position.
+	 * @throws std::out_of_range If the index is out of bounds.
+	 */
+	T get(int idx) const;
+
+	/**
+	 * @brief Removes an element from the front of the queue (O(1)).
+	 * @return The data removed from the queue.
+	 * @throws std::runtime_error If the queue is empty.
+	 */
+	T pop();
+
+	/**
+	 * @brief Returns the element at the front of the queue without removing it (O(1)).
+	 * @return The data at the front of the queue.
+	 * @throws std::runtime_error If the queue is empty.
+	 */
+	T peek() const { if (isEmpty()) throw std::runtime_error("Cannot peek an empty queue"); return s_array[head]; }
+};
+
+
+template <class T, int N>
+void InplaceQueue<T, N>::show() const {
+	for (int i = 0; i < len; i++) {
+		if (i != 0) {
+			std::cout << ", ";
+		}
+		std::cout << s_array[wrap(i)];
+	}
+	std::cout << std::endl;
+}
+
+template <class T, int N>
+bool InplaceQueue<T, N>::tryPush(T data) {
+	if (isFull()) {
+		return false;
+	}
+	s_array[wrap(len)] = data;
+	len++;
+	return true;
+}
+
+template <class T, int N>
+bool InplaceQueue<T, N>::contains(T data) const {
+	for (int i = 0; i < len; i++) {
+		if (s_array[wrap(i)] == data) {
+			return true;
+		}
+	}
+	return false;
+}
+
+template <class T, int N>
+T InplaceQueue<T, N>::get(int idx) const {
+	if (idx >= len || idx < 0) {
+		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
+	}
+	return s_array[wrap(idx)];
+}
+
+template <class T, int N>
+T InplaceQueue<T, N>::pop() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty queue");
+	}
+	T data = std::move(s_array[head]);
+	head = wrap(1);
+	len--;
+	return data;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file inplacestack.h
+ * @brief Fixed-capacity stack implementation using in-place vectors.
+ *
+ * This class implements a stack using an InplaceVector, so it never touches the heap and
+ * can live on the stack or inside another object. Once the capacity is reached, pushes
+ * fail instead of growing.
+ *
+ * @tparam T The data type stored in the stack.
+ * @tparam N The capacity of the stack.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include "inplacevector.h"
+
+/**
+ * @class InplaceStack
+ * @brief A fixed-capacity stack implemented using an in-place vector.
+ *
+ * @tparam T The data type stored in the stack.
+ * @tparam N The capacity of the stack.
+ */
+template <class T, int N>
+class InplaceStack {
+private:
+	InplaceVector<T, N> vector;
+
+public:
+	/**
+	 * @brief Constructs an empty stack (O(1)).
+	 */
+	InplaceStack() {}
+
+	/**
+	 * @brief Pushes an element onto the stack (O(1)).
+	 * @param data The data to push onto the stack.
+	 * @throws std::length_error If the stack is full.
+	 */
+	void push(T data) { if (!tryPush(data)) throw std::length_error("Cannot push to a full stack"); }
+
+	/**
+	 * @brief Clears the stack (O(1)).
+	 */
+	void clear() { vector.clear(); }
+
+	/**
+	 * @brief Displays the stack from bottom to top (O(n)).
+	 */
+	void show() const { vector.show(); }
+
+	/**
+	 * @brief Returns the length of the stack (O(1)).
+	 * @return The length of the stack.
+	 */
+	int length() const { return vector.length(); }
+
+	/**
+	 * @brief Returns the fixed capacity of the stack (O(1)).
+	 * @return The capacity of the stack.
+	 */
+	int capacity() const { return N; }
+
+	/**
+	 * @brief Pushes an element onto the stack if there is room (O(1)).
+	 * @param data The data to push onto the stack.
+	 * @return True if the element was pushed, false if the stack was full.
+	 */
+	bool tryPush(T data) { return vector.tryPush(data); }
+
+	/**
+	 * @brief Checks if the stack is empty (O(1)).
+	 * @return True if the stack is empty, false otherwise.
+	 */
+	bool isEmpty() const { return vector.isEmpty(); }
+
+	/**
+	 * @brief Checks if the stack is at full capacity (O(1)).
+	 * @return True if the stack is full, false otherwise.
+	 */
+	bool isFull() const { return vector.isFull(); }
+
+	/**
+	 * @brief Checks if the stack contains a specific value (O(n)).
+	 * @param data The value to check for.
+	 * @return True if the value is present, false otherwise.
+	 */
+	bool contains(T data) const { return vector.contains(data); }
+
+	/**
+	 * @brief Pops an element off the stack (O(1)).
+	 * @return The data popped from the stack.
+	 * @throws std::runtime_error If the stack is empty.
+	 */
+	T pop() { if (isEmpty()) throw std::runtime_error("Cannot pop from an empty stack"); return vector.pop(); }
+
+	/**
+	 * @brief Returns a reference to the element at the top of the stack without removing it (O(1)).
+	 * @return A reference to the data at the top of the stack.
+	 * @throws std::runtime_error If the stack is empty.
+	 */
+	T& peek() { if (isEmpty()) throw std::runtime_error("Cannot peek an empty stack"); return vector.back(); }
+
+	/**
+	 * @brief Returns a reference to the element at the top of the stack without removing it (O(1)).
+	 * @return A const reference to the data at the top of the stack.
+	 * @throws std::runtime_error If the stack is empty.
+	 */
+	const T& peek() const { if (isEmpty()) throw std::runtime_error("Cannot peek an empty stack"); return vector.back(); }
+};
@@ -0,0 +1,290 @@
+/**
+ * @file inplacevector.h
+ * @brief Fixed-capacity vector implementation whose storage lives inside the object.
+ *
+ * This class never touches the heap: its elements are stored in an array member, so an
+ * InplaceVector can live on the stack or inside another object and is safe to use where
+ * allocation is banned. Once the capacity is reached, pushes fail instead of growing.
+ *
+ * @tparam T The data type stored in the vector.
+ * @tparam N The capacity of the vector.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @class InplaceVector
+ * @brief A fixed-capacity array with vector operations and no heap allocation.
+ *
+ * @tparam T The data type stored in the vector.
+ * @tparam N The capacity of the vector.
+ */
+template <class T, int N>
+class InplaceVector {
+	static_assert(N > 0, "InplaceVector capacity must be positive");
+
+private:
+	T s_array[N];
+	int len;
+
+public:
+	/**
+	 * @brief Constructs an empty vector (O(1)).
+	 */
+	InplaceVector() : len(0) {}
+
+	/**
+	 * @brief Constructs a vector with elements from an array (O(n)).
+	 * @param data The array of data to initialize the vector.
+	 * @param size The size of the array.
+	 * @throws std::invalid_argument If the size is negative.
+	 * @throws std::length_error If the array is larger than the capacity.
+	 */
+	InplaceVector(T data[], int size);
+
+	/**
+	 * @brief Sets an index in the vector to a particular value (O(1)).
+	 * @param idx The index to set.
+	 * @param data The value to set at the index.
+	 * @throws std::out_of_range If the index is out of bounds.
+	 */
+	void set(int idx, T data);
+
+	/**
+	 * @brief Adds a single value to the end of the vector (O(1)).
+	 * @param data The value to add.
+	 * @throws std::length_error If the vector is full.
+	 */
+	void push(T data) { if (!tryPush(data)) throw std::length_error("Cannot push to a full vector"); }
+
+	/**
+	 * @brief Adds a single value to a particular index in the vector (O(n)).
+	 * @param idx The index to insert at.
+	 * @param data The value to insert.
+	 * @throws std::out_of_range If the index is out of bounds.
+	 * @throws std::length_error If the vector is full.
+	 */
+	void insert(int idx, T data);
+
+	/**
+	 * @brief Clears the vector (O(1)).
+	 */
+	void clear() { len = 0; }
+
+	/**
+	 * @brief Reverses the vector in place (O(n)).
+	 */
+	void reverse();
+
+	/**
+	 * @brief Displays the vector (O(n)).
+	 */
+	void show() const;
+
+	/**
+	 * @brief Returns the length of the vector (O(1)).
+	 * @return The length of the vector.
+	 */
+	int length() const { return len; }
+
+	/**
+	 * @brief Returns the fixed capacity of the vector (O(1)).
+	 * @return The capacity of the vector.
+	 */
+	int capacity() const { return N; }
+
+	/**
+	 * @brief Finds the first instance of a specific value in the vector (O(n)).
+	 * @param data The value to find.
+	 * @return The index of the value, or -1 if not found.
+	 */
+	int find(T data) const;
+
+	/**
+	 * @brief Adds a single value to the end of the vector if there is room (O(1)).
+	 * @param data The value to add.
+	 * @return True if the value was added, false if the vector was full.
+	 */
+	bool tryPush(T data);
+
+	/**
+	 * @brief Checks if the vector is empty (O(1)).
+	 * @return True if the vector is empty, false otherwise.
+	 */
+	bool isEmpty() const { return len == 0; }
+
+	/**
+	 * @brief Checks if the vector is at full capacity (O(1)).
+	 * @return True if the vector is full, false otherwise.
+	 */
+	bool isFull() const { return len == N; }
+
+	/**
+	 * @brief Removes a specific value from the vector (O(n)).
+	 * @param data The value to remove.
+	 * @return True if the value was removed, false otherwise.
+	 */
+	bool removeValue(T data);
+
+	/**
+	 * @brief Checks if the vector contains a specific value (O(n)).
+	 * @param data The value to check for.
+	 * @return True if the value is present, false otherwise.
+	 */
+	bool contains(T data) const { return find(data) != -1; }
+
+	/**
+	 * @brief Returns the value held at a specific index in the vector (O(1)).
+	 * @param idx The index to get the value from.
+	 * @return The value at the index.
+	 * @throws std::out_of_range If the index is out of bounds.
+	 */
+	T get(int idx) const;
+
+	/**
+	 * @brief Returns a reference to the last element in the vector (O(1)).
+	 * @return A reference to the last element.
+	 * @throws std::runtime_error If the vector is empty.
+	 */
+	T& back() { if (isEmpty()) throw std::runtime_error("Cannot access the back of an empty vector"); return s_array[len - 1]; }
+
+	/**
+	 * @brief Returns a reference to the last element in the vector (O(1)).
+	 * @return A const reference to the last element.
+	 * @throws std::runtime_error If the vector is empty.
+	 */
+	const T& back() const { if (isEmpty()) throw std::runtime_error("Cannot access the back of an empty vector"); return s_array[len - 1]; }
+
+	/**
+	 * @brief Removes the last element from the vector and returns its value (O(1)).
+	 * @return The value of the last element.
+	 * @throws std::runtime_error If the vector is empty.
+	 */
+	T pop();
+
+	/**
+	 * @brief Removes a particular element by its index in the vector and returns its value (O(n)).
+	 * @param idx The index of the element to remove.
+	 * @return The value of the removed element.
+	 * @throws std::out_of_range If the index is out of bounds.
+	 */
+	T remove(int idx);
+};
+
+
+template <class T, int N>
+InplaceVector<T, N>::InplaceVector(T data[], int size) : len(0) {
+	if (size < 0) {
+		throw std::invalid_argument("Array size " + std::to_string(size) + " is negative");
+	}
+	if (size > N) {
+		throw std::length_error("Array of size " + std::to_string(size) + " exceeds capacity " + std::to_string(N));
+	}
+	for (int i = 0; i < size; i++) {
+		s_array[i] = data[i];
+	}
+	len = size;
+}
+
+template <class T, int N>
+void InplaceVector<T, N>::set(int idx, T data) {
+	if (idx >= len || idx < 0) {
+		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
+	}
+	s_array[idx] = data;
+}
+
+template <class T, int N>
+void InplaceVector<T, N>::insert(int idx, T data) {
+	if (idx > len || idx < 0) {
+		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
+	}
+	if (isFull()) {
+		throw std::length_error("Cannot insert into a full vector");
+	}
+	for (int i = len; i > idx; i--) {
+		s_array[i] = std::move(s_array[i - 1]);
+	}
+	s_array[idx] = data;
+	len++;
+}
+
+template <class T, int N>
+void InplaceVector<T, N>::reverse() {
+	for (int i = 0; i < len / 2; i++) {
+		std::swap(s_array[i], s_array[len - i - 1]);
+	}
+}
+
+template <class T, int N>
+void InplaceVector<T, N>::show() const {
+	for (int i = 0; i < len; i++) {
+		if (i != 0) {
+			std::cout << ", ";
+		}
+		std::cout << s_array[i];
+	}
+	std::cout << std::endl;
+}
+
+template <class T, int N>
+int InplaceVector<T, N>::find(T data) const {
+	for (int i = 0; i < len; i++) {
+		if (s_array[i] == data) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+template <class T, int N>
+bool InplaceVector<T, N>::tryPush(T data) {
+	if (isFull()) {
+		return false;
+	}
+	s_array[len++] = data;
+	return true;
+}
+
+template <class T, int N>
+bool InplaceVector<T, N>::removeValue(T data) {
+	int idx = find(data);
+	if (idx == -1) {
+		return false;
+	}
+	remove(idx);
+	return true;
+}
+
+template <class T, int N>
+T InplaceVector<T, N>::get(int idx) const {
+	if (idx >= len || idx < 0) {
+		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
+	}
+	return s_array[idx];
+}
+
+template <class T, int N>
+T InplaceVector<T, N>::pop() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty vector");
+	}
+	return std::move(s_array[--len]);
+}
+
+template <class T, int N>
+T InplaceVector<T, N>::remove(int idx) {
+	if (idx >= len || idx < 0) {
+		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
+	}
+	T data = std::move(s_array[idx]);
+	for (int i = idx; i < len - 1; i++) {
+		s_array[i] = std::move(s_array[i + 1]);
+	}
+	len--;
+	return data;
+}
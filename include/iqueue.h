@@ -0,0 +1,99 @@
+/**
+ * @file iqueue.h
+ * @brief Queue implementation using intrusive linked lists.
+ *
+ * This class implements a queue using an intrusive linked list.
+ * It provides O(1) push and pop operations that never allocate, since objects are
+ * linked through a hook embedded in the objects themselves.
+ *
+ * @tparam T The object type linked into the queue.
+ * @tparam Tag The tag selecting which of the object's hooks the queue uses.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include "ilist.h"
+
+/**
+ * @class IntrusiveQueue
+ * @brief A queue implemented using an intrusive linked list.
+ *
+ * @tparam T The object type linked into the queue, which must inherit ListHook<Tag>.
+ * @tparam Tag The tag selecting which of the object's hooks the queue uses.
+ */
+template <class T, class Tag = void>
+class IntrusiveQueue {
+private:
+	IntrusiveList<T, Tag> list;
+
+public:
+	/**
+	 * @brief Constructs an empty queue (O(1)).
+	 */
+	IntrusiveQueue() {}
+
+	/**
+	 * @brief Destroys the queue, unlinking but not freeing every object (O(n)).
+	 */
+	~IntrusiveQueue() {}
+
+	/**
+	 * @brief Links an object to the back of the queue (O(1)).
+	 * @param data The object to push into the queue.
+	 * @throws std::runtime_error If the object is already linked into a list with this tag.
+	 */
+	void push(T& data) { list.push(data); }
+
+	/**
+	 * @brief Unlinks a specific object from anywhere in the queue (O(1)).
+	 * @param data An object in this queue.
+	 * @return True if the object was unlinked, false if it was not linked.
+	 * @throws std::runtime_error If the object is linked into a different queue with this tag.
+	 */
+	bool remove(T& data) { return list.remove(data); }
+
+	/**
+	 * @brief Unlinks every object from the queue (O(n)).
+	 */
+	void clear() { list.clear(); }
+
+	/**
+	 * @brief Displays the queue (O(n)).
+	 */
+	void show() const { list.show(); }
+
+	/**
+	 * @brief Returns the length of the queue (O(1)).
+	 * @return The length of the queue.
+	 */
+	int length() const { return list.length(); }
+
+	/**
+	 * @brief Checks if the queue is empty (O(1)).
+	 * @return True if the queue is empty, false otherwise.
+	 */
+	bool isEmpty() const { return list.isEmpty(); }
+
+	/**
+	 * @brief Checks if a specific object is linked into this queue (O(1)).
+	 * @param data The object to check for.
+	 * @return True if the object is in this queue, false otherwise.
+	 */
+	bool contains(const T& data) const { return list.contains(data); }
+
+	/**
+	 * @brief Unlinks the object at the front of the queue and returns it (O(1)).
+	 * @return The object removed from the queue.
+	 * @throws std::runtime_error If the queue is empty.
+	 */
+	T& pop() { if (isEmpty()) throw std::runtime_error("Cannot pop from an empty queue"); return list.popFront(); }
+
+	/**
+	 * @brief Returns the object at the front of the queue without unlinking it (O(1)).
+	 * @return The object at the front of the queue.
+	 * @throws std::runtime_error If the queue is empty.
+	 */
+	T& peek() const { if (isEmpty()) throw std::runtime_error("Cannot peek an empty queue"); return list.peek(); }
+};
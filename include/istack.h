@@ -0,0 +1,99 @@
+/**
+ * @file istack.h
+ * @brief Stack implementation using intrusive linked lists.
+ *
+ * This class implements a stack using an intrusive linked list.
+ * It provides O(1) push and pop operations that never allocate, since objects are
+ * linked through a hook embedded in the objects themselves.
+ *
+ * @tparam T The object type linked into the stack.
+ * @tparam Tag The tag selecting which of the object's hooks the stack uses.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include "ilist.h"
+
+/**
+ * @class IntrusiveStack
+ * @brief A stack implemented using an intrusive linked list.
+ *
+ * @tparam T The object type linked into the stack, which must inherit ListHook<Tag>.
+ * @tparam Tag The tag selecting which of the object's hooks the stack uses.
+ */
+template <class T, class Tag = void>
+class IntrusiveStack {
+private:
+	IntrusiveList<T, Tag> list;
+
+public:
+	/**
+	 * @brief Constructs an empty stack (O(1)).
+	 */
+	IntrusiveStack() {}
+
+	/**
+	 * @brief Destroys the stack, unlinking but not freeing every object (O(n)).
+	 */
+	~IntrusiveStack() {}
+
+	/**
+	 * @brief Links an object onto the top of the stack (O(1)).
+	 * @param data The object to push onto the stack.
+	 * @throws std::runtime_error If the object is already linked into a list with this tag.
+	 */
+	void push(T& data) { list.pushFront(data); }
+
+	/**
+	 * @brief Unlinks a specific object from anywhere in the stack (O(1)).
+	 * @param data An object in this stack.
+	 * @return True if the object was unlinked, false if it was not linked.
+	 * @throws std::runtime_error If the object is linked into a different stack with this tag.
+	 */
+	bool remove(T& data) { return list.remove(data); }
+
+	/**
+	 * @brief Unlinks every object from the stack (O(n)).
+	 */
+	void clear() { list.clear(); }
+
+	/**
+	 * @brief Displays the stack (O(n)).
+	 */
+	void show() const { list.show(); }
+
+	/**
+	 * @brief Returns the length of the stack (O(1)).
+	 * @return The length of the stack.
+	 */
+	int length() const { return list.length(); }
+
+	/**
+	 * @brief Checks if the stack is empty (O(1)).
+	 * @return True if the stack is empty, false otherwise.
+	 */
+	bool isEmpty() const { return list.isEmpty(); }
+
+	/**
+	 * @brief Checks if a specific object is linked into this stack (O(1)).
+	 * @param data The object to check for.
+	 * @return True if the object is in this stack, false otherwise.
+	 */
+	bool contains(const T& data) const { return list.contains(data); }
+
+	/**
+	 * @brief Unlinks the object at the top of the stack and returns it (O(1)).
+	 * @return The object popped from the stack.
+	 * @throws std::runtime_error If the stack is empty.
+	 */
+	T& pop() { if (isEmpty()) throw std::runtime_error("Cannot pop from an empty stack"); return list.popFront(); }
+
+	/**
+	 * @brief Returns the object at the top of the stack without unlinking it (O(1)).
+	 * @return The object at the top of the stack.
+	 * @throws std::runtime_error If the stack is empty.
+	 */
+	T& peek() const { if (isEmpty()) throw std::runtime_error("Cannot peek an empty stack"); return list.peek(); }
+};
@@ -0,0 +1,336 @@
+/**
+ * @file lrucache.h
+ * @brief Least-recently-used cache implementation using an IntrusiveList and a HashTable.
+ *
+ * This class keeps its entries in pooled nodes linked into an IntrusiveList from most to
+ * least recently used, and indexes them with a HashTable of node pointers projected onto
+ * their keys. A hit unlinks its node and relinks it at the front, and eviction unlinks the
+ * node at the back, so get, put and evict all take O(1) rather than the linear scan a List
+ * would need to find the node to move. Evicted nodes go on a free list and are reused, so a
+ * cache at capacity does not allocate.
+ *
+ * Capacity is measured in weight. By default every entry weighs 1, so the capacity is a
+ * number of entries; given a weight function, it can be a number of bytes or any other cost.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ * @tparam Hash The hash function on keys. If it declares is_transparent, lookups accept any type it can hash.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include "hashtable.h"
+#include "ilist.h"
+#include "vector.h"
+
+/**
+ * @class LRUCache
+ * @brief A bounded map that evicts its least recently used entries, with O(1) get, put and evict.
+ *
+ * The eviction callback runs after its entry has left the cache. It must not throw or modify the cache.
+ *
+ * @tparam K The key type.
+ * @tparam V The value type.
+ * @tparam Hash The hash function on keys. If it declares is_transparent, lookups accept any type it can hash.
+ * @tparam KeyEqual The equality predicate on keys.
+ */
+template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<>>
+class LRUCache {
+public:
+	typedef K KeyType;
+	typedef V ValueType;
+	typedef Hash Hasher;
+	typedef KeyEqual KeyEquality;
+	typedef std::function<std::int64_t(const K&, const V&)> Weigher;
+	typedef std::function<void(const K&, const V&)> Evictor;
+
+private:
+	/**
+	 * @struct Node
+	 * @brief A pooled entry, linked into the recency list while cached and into the free list otherwise.
+	 */
+	struct Node : ListHook<> {
+		K key;
+		V value;
+		std::int64_t weight;
+	};
+
+	/**
+	 * @struct NodeKey
+	 * @brief Projects a node onto its key.
+	 */
+	struct NodeKey {
+		const K& operator()(const Node* node) const { return node->key; }
+	};
+
+	std::int64_t cap;
+	std::int64_t total;
+	Weigher weigh;
+	Evictor evict;
+	IntrusiveList<Node> order;
+	IntrusiveList<Node> free_nodes;
+	Vector<Node*> nodes;
+	HashTable<Node*, NodeKey, Hash, KeyEqual> table;
+
+	/**
+	 * @brief Returns the weight of an entry, checking it fits in the cache.
+	 * @param key The key.
+	 * @param value The value.
+	 * @return The weight.
+	 * @throws std::invalid_argument If the weight is negative or exceeds the capacity.
+	 */
+	std::int64_t weightOf(const K& key, const V& value) const;
+
+	/**
+	 * @brief Takes a node from the free list, or allocates one if it is empty.
+	 * @return An unlinked node.
+	 */
+	Node* acquire();
+
+	/**
+	 * @brief Removes a node from the recency list and the index.
+	 * @param node The node.
+	 */
+	void discard(Node* node);
+
+	/**
+	 * @brief Returns a discarded node to the free list, dropping its key and value.
+	 * @param node The node.
+	 */
+	void release(Node* node);
+
+	/**
+	 * @brief Evicts least recently used entries until an extra weight fits.
+	 * @param extra The weight to make room for.
+	 */
+	void shrink(std::int64_t extra);
+
+public:
+	/**
+	 * @brief Constructs an empty cache (O(1)).
+	 * @param capacity The maximum total weight of the entries.
+	 * @param weigh The function giving the weight of an entry, or empty to give every entry a weight of 1.
+	 * @param evict The function to call with each entry evicted to make room, or empty for none.
+	 * @param hash The hash function on keys.
+	 * @param equal The equality predicate on keys.
+	 * @throws std::invalid_argument If the capacity is not positive.
+	 */
+	LRUCache(std::int64_t capacity, Weigher weigh = Weigher(), Evictor evict = Evictor(), Hash hash = Hash(), KeyEqual equal = KeyEqual());
+
+	LRUCache(const LRUCache&) = delete;
+	LRUCache& operator=(const LRUCache&) = delete;
+
+	/**
+	 * @brief Destroys the cache and frees the associated memory (O(n)).
+	 */
+	~LRUCache();
+
+	/**
+	 * @brief Returns the value of a key and marks the entry as most recently used (O(1) expected).
+	 * @param key The key to find.
+	 * @return A pointer to the value, valid until the cache is next modified, or nullptr if the key is not present.
+	 */
+	template <class Q>
+	V* get(const Q& key);
+
+	/**
+	 * @brief Returns the value of a key without marking the entry as used (O(1) expected).
+	 * @param key The key to find.
+	 * @return A pointer to the value, valid until the cache is next modified, or nullptr if the key is not present.
+	 */
+	template <class Q>
+	const V* peek(const Q& key) const;
+
+	/**
+	 * @brief Sets the value of a key and marks the entry as most recently used, evicting entries to make room (amortized O(1)).
+	 * @param key The key.
+	 * @param value The value.
+	 * @return True if the key was inserted, false if its value was replaced.
+	 * @throws std::invalid_argument If the entry's weight is negative or exceeds the capacity.
+	 */
+	bool put(K key, V value);
+
+	/**
+	 * @brief Checks if a key is present, without marking the entry as used (O(1) expected).
+	 * @param key The key to find.
+	 * @return True if the key is present, false otherwise.
+	 */
+	template <class Q>
+	bool contains(const Q& key) const { return table.contains(key); }
+
+	/**
+	 * @brief Removes a key and its value without calling the eviction callback (O(1) expected).
+	 * @param key The key to remove.
+	 * @return True if the key was removed, false if it was not present.
+	 */
+	template <class Q>
+	bool remove(const Q& key);
+
+	/**
+	 * @brief Removes every entry without calling the eviction callback (O(n)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Returns the number of entries (O(1)).
+	 * @return The number of entries in the cache.
+	 */
+	int length() const { return table.length(); }
+
+	/**
+	 * @brief Returns the total weight of the entries (O(1)).
+	 * @return The weight in use.
+	 */
+	std::int64_t weight() const { return total; }
+
+	/**
+	 * @brief Returns the maximum total weight of the entries (O(1)).
+	 * @return The capacity.
+	 */
+	std::int64_t capacity() const { return cap; }
+
+	/**
+	 * @brief Checks if the cache is empty (O(1)).
+	 * @return True if the cache is empty, false otherwise.
+	 */
+	bool isEmpty() const { return table.isEmpty(); }
+};
+
+
+template <class K, class V, class Hash, class KeyEqual>
+LRUCache<K, V, Hash, KeyEqual>::LRUCache(std::int64_t capacity, Weigher weigh, Evictor evict, Hash hash, KeyEqual equal) : cap(capacity), total(0), weigh(std::move(weigh)), evict(std::move(evict)), table(0, NodeKey(), hash, equal) {
+	if (capacity <= 0) {
+		throw std::invalid_argument("Capacity must be positive");
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+LRUCache<K, V, Hash, KeyEqual>::~LRUCache() {
+	// Unlink every node before freeing them, so the lists never touch freed memory
+	order.clear();
+	free_nodes.clear();
+	for (int i = 0; i < nodes.length(); i++) {
+		delete nodes[i];
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+std::int64_t LRUCache<K, V, Hash, KeyEqual>::weightOf(const K& key, const V& value) const {
+	std::int64_t w = weigh ? weigh(key, value) : 1;
+	if (w < 0 || w > cap) {
+		throw std::invalid_argument("Entry weight must be between 0 and the capacity");
+	}
+	return w;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+typename LRUCache<K, V, Hash, KeyEqual>::Node* LRUCache<K, V, Hash, KeyEqual>::acquire() {
+	if (!free_nodes.isEmpty()) {
+		return &free_nodes.popFront();
+	}
+	Node* node = new Node();
+	nodes.push(node);
+	return node;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void LRUCache<K, V, Hash, KeyEqual>::discard(Node* node) {
+	order.remove(*node);
+	table.remove(node->key);
+	total -= node->weight;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void LRUCache<K, V, Hash, KeyEqual>::release(Node* node) {
+	node->key = K();
+	node->value = V();
+	free_nodes.push(*node);
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void LRUCache<K, V, Hash, KeyEqual>::shrink(std::int64_t extra) {
+	while (!order.isEmpty() && total + extra > cap) {
+		Node* node = &order.peekBack();
+		discard(node);
+		if (evict) {
+			evict(node->key, node->value);
+		}
+		release(node);
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Q>
+V* LRUCache<K, V, Hash, KeyEqual>::get(const Q& key) {
+	Node** found = table.find(key);
+	if (found == nullptr) {
+		return nullptr;
+	}
+	Node* node = *found;
+	order.remove(*node);
+	order.pushFront(*node);
+	return &node->value;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Q>
+const V* LRUCache<K, V, Hash, KeyEqual>::peek(const Q& key) const {
+	Node* const* found = table.find(key);
+	return found == nullptr ? nullptr : &(*found)->value;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+bool LRUCache<K, V, Hash, KeyEqual>::put(K key, V value) {
+	std::int64_t w = weightOf(key, value);
+	Node** found = table.find(key);
+	if (found != nullptr) {
+		Node* node = *found;
+		total += w - node->weight;
+		node->value = std::move(value);
+		node->weight = w;
+		order.remove(*node);
+		order.pushFront(*node);
+		// The updated entry is now the most recent, so it is only reached once it fits on its own
+		shrink(0);
+		return false;
+	}
+
+	shrink(w);
+	Node* node = acquire();
+	node->key = std::move(key);
+	node->value = std::move(value);
+	node->weight = w;
+	table.insert(node);
+	order.pushFront(*node);
+	total += w;
+	return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+template <class Q>
+bool LRUCache<K, V, Hash, KeyEqual>::remove(const Q& key) {
+	Node** found = table.find(key);
+	if (found == nullptr) {
+		return false;
+	}
+	Node* node = *found;
+	discard(node);
+	release(node);
+	return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual>
+void LRUCache<K, V, Hash, KeyEqual>::clear() {
+	while (!order.isEmpty()) {
+		Node* node = &order.popFront();
+		release(node);
+	}
+	table.clear();
+	total = 0;
+}
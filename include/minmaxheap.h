@@ -0,0 +1,374 @@
+/**
+ * @file minmaxheap.h
+ * @brief Double-ended priority queue implementation using a min-max heap.
+ *
+ * This class implements Atkinson et al.'s min-max heap in a dynamic array. Nodes on even
+ * levels are no greater than all of their descendants and nodes on odd levels are no
+ * smaller, so the minimum is the root and the maximum is one of its children. Both ends
+ * can therefore be read in O(1) and popped in O(log n) from a single structure.
+ *
+ * An optional bound turns the heap into a fixed-size buffer: once full, each push drops
+ * whichever element sits at the evicting end, which may be the new element itself.
+ *
+ * @tparam T The data type stored in the heap.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <bit>
+#include <functional>
+#include <utility>
+#include "vector.h"
+
+/**
+ * @class MinMaxHeap
+ * @brief A priority queue that can pop both its minimum and its maximum.
+ *
+ * @tparam T The data type stored in the heap.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+template <class T, class Compare = std::less<>, class Key = std::identity>
+class MinMaxHeap {
+private:
+	Vector<T>* heap;
+	int bound;
+	bool evict_max;
+	Compare comp;
+	Key key;
+
+	/**
+	 * @brief Checks if one element orders strictly before another.
+	 * @param data_1 The first element.
+	 * @param data_2 The second element.
+	 * @return True if data_1 is less than data_2, false otherwise.
+	 */
+	bool less(const T& data_1, const T& data_2) const { return comp(std::invoke(key, data_1), std::invoke(key, data_2)); }
+
+	/**
+	 * @brief Checks if one element must sit above another on a min level (Min) or a max level (!Min).
+	 * @param data_1 The first element.
+	 * @param data_2 The second element.
+	 * @return True if data_1 is less than data_2 (Min) or greater than data_2 (!Min), false otherwise.
+	 */
+	template <bool Min>
+	bool before(const T& data_1, const T& data_2) const { return Min ? less(data_1, data_2) : less(data_2, data_1); }
+
+	/**
+	 * @brief Checks if a position lies on a min level.
+	 * @param idx The position to check.
+	 * @return True if the position is on an even level, false otherwise.
+	 */
+	static bool minLevel(int idx) { return std::bit_width(static_cast<unsigned>(idx + 1)) % 2 == 1; }
+
+	/**
+	 * @brief Swaps the elements at two positions.
+	 * @param idx_1 The first position.
+	 * @param idx_2 The second position.
+	 */
+	void swap(int idx_1, int idx_2) { std::swap((*heap)[idx_1], (*heap)[idx_2]); }
+
+	/**
+	 * @brief Moves an element up through the levels of its own kind.
+	 * @param idx The position of the element.
+	 */
+	template <bool Min>
+	void bubbleUp(int idx);
+
+	/**
+	 * @brief Moves an element down through its children and grandchildren.
+	 * @param idx The position of the element.
+	 */
+	template <bool Min>
+	void trickleDown(int idx);
+
+	/**
+	 * @brief Returns the position of the maximum element. Requires a non-empty heap.
+	 * @return The position of the maximum element.
+	 */
+	int maxIndex() const;
+
+	/**
+	 * @brief Inserts an element without regard to the bound.
+	 * @param data The element to be added.
+	 */
+	void insert(T data);
+
+	/**
+	 * @brief Removes the element at a position, refilling it with the last element.
+	 * @param idx The position of the element to remove.
+	 * @return The removed element.
+	 */
+	T remove(int idx);
+
+public:
+	/**
+	 * @brief Constructs an empty heap (O(1)).
+	 * @param bound The maximum number of elements, or 0 for an unbounded heap.
+	 * @param evict_max Whether a full heap drops its maximum (true) or its minimum (false) on push.
+	 * @param comp The comparator to order keys with.
+	 * @param key The projection from elements to keys.
+	 * @throws std::invalid_argument If the bound is negative.
+	 */
+	MinMaxHeap(int bound = 0, bool evict_max = true, Compare comp = Compare(), Key key = Key());
+
+	MinMaxHeap(const MinMaxHeap&) = delete;
+	MinMaxHeap& operator=(const MinMaxHeap&) = delete;
+
+	/**
+	 * @brief Destroys the heap and frees the associated memory (O(1)).
+	 */
+	~MinMaxHeap() { delete heap; }
+
+	/**
+	 * @brief Inserts an element, evicting from one end if the heap is bounded and full (O(log(n))).
+	 * @param data The element to be added.
+	 * @param evicted Receives the dropped element, if any and if not nullptr.
+	 * @return True if an element, possibly data itself, was dropped to stay within the bound, false otherwise.
+	 */
+	bool push(T data, T* evicted = nullptr);
+
+	/**
+	 * @brief Removes and returns the minimum element (O(log(n))).
+	 * @return The minimum element.
+	 * @throws std::runtime_error If the heap is empty.
+	 */
+	T popMin();
+
+	/**
+	 * @brief Removes and returns the maximum element (O(log(n))).
+	 * @return The maximum element.
+	 * @throws std::runtime_error If the heap is empty.
+	 */
+	T popMax();
+
+	/**
+	 * @brief Returns the minimum element (O(1)).
+	 * @return The minimum element.
+	 * @throws std::runtime_error If the heap is empty.
+	 */
+	T peekMin() const;
+
+	/**
+	 * @brief Returns the maximum element (O(1)).
+	 * @return The maximum element.
+	 * @throws std::runtime_error If the heap is empty.
+	 */
+	T peekMax() const;
+
+	/**
+	 * @brief Clears the heap, keeping room for its bound (O(1)).
+	 */
+	void clear() { heap->clear(); }
+
+	/**
+	 * @brief Returns the length of the heap (O(1)).
+	 * @return The number of elements in the heap.
+	 */
+	int length() const { return heap->length(); }
+
+	/**
+	 * @brief Returns the maximum number of elements the heap holds (O(1)).
+	 * @return The bound of the heap, or 0 if it is unbounded.
+	 */
+	int capacity() const { return bound; }
+
+	/**
+	 * @brief Checks if the heap is empty (O(1)).
+	 * @return True if the heap is empty, false otherwise.
+	 */
+	bool isEmpty() const { return length() == 0; }
+
+	/**
+	 * @brief Checks if the heap is bounded and holds as many elements as its bound (O(1)).
+	 * @return True if the heap is full, false otherwise.
+	 */
+	bool isFull() const { return bound > 0 && length() >= bound; }
+
+	/**
+	 * @brief Checks if the min-max heap property is still held (O(n)).
+	 * @return True if the heap property is still held, false otherwise.
+	 */
+	bool validHeap() const;
+};
+
+
+template <class T, class Compare, class Key>
+MinMaxHeap<T, Compare, Key>::MinMaxHeap(int bound, bool evict_max, Compare comp, Key key) : heap(new Vector<T>()), bound(bound), evict_max(evict_max), comp(comp), key(key) {
+	if (bound < 0) {
+		delete heap;
+		throw std::invalid_argument("Bound must not be negative");
+	}
+	heap->reserve(bound);
+}
+
+template <class T, class Compare, class Key>
+template <bool Min>
+void MinMaxHeap<T, Compare, Key>::bubbleUp(int idx) {
+	while (idx > 2) {
+		int grandparent = (idx - 3) / 4;
+		if (!before<Min>((*heap)[idx], (*heap)[grandparent])) {
+			break;
+		}
+		swap(idx, grandparent);
+		idx = grandparent;
+	}
+}
+
+template <class T, class Compare, class Key>
+template <bool Min>
+void MinMaxHeap<T, Compare, Key>::trickleDown(int idx) {
+	int n = length();
+	while (2 * idx + 1 < n) {
+		// Find the best of up to two children and four grandchildren
+		int best = 2 * idx + 1;
+		if (best + 1 < n && before<Min>((*heap)[best + 1], (*heap)[best])) {
+			best++;
+		}
+		int first_grandchild = 4 * idx + 3;
+		for (int i = first_grandchild; i < first_grandchild + 4 && i < n; i++) {
+			if (before<Min>((*heap)[i], (*heap)[best])) {
+				best = i;
+			}
+		}
+
+		if (!before<Min>((*heap)[best], (*heap)[idx])) {
+			return;
+		}
+		swap(idx, best);
+		if (best < first_grandchild) {
+			return;
+		}
+		// A grandchild moved up, so the element moved down may now be out of order with its new parent
+		int parent = (best - 1) / 2;
+		if (before<Min>((*heap)[parent], (*heap)[best])) {
+			swap(best, parent);
+		}
+		idx = best;
+	}
+}
+
+template <class T, class Compare, class Key>
+int MinMaxHeap<T, Compare, Key>::maxIndex() const {
+	if (length() == 1) {
+		return 0;
+	}
+	if (length() == 2 || !less((*heap)[1], (*heap)[2])) {
+		return 1;
+	}
+	return 2;
+}
+
+template <class T, class Compare, class Key>
+void MinMaxHeap<T, Compare, Key>::insert(T data) {
+	heap->push(data);
+	int idx = length() - 1;
+	if (idx == 0) {
+		return;
+	}
+	int parent = (idx - 1) / 2;
+	if (minLevel(idx)) {
+		if (less((*heap)[parent], (*heap)[idx])) {
+			swap(idx, parent);
+			bubbleUp<false>(parent);
+		} else {
+			bubbleUp<true>(idx);
+		}
+	} else {
+		if (less((*heap)[idx], (*heap)[parent])) {
+			swap(idx, parent);
+			bubbleUp<true>(parent);
+		} else {
+			bubbleUp<false>(idx);
+		}
+	}
+}
+
+template <class T, class Compare, class Key>
+T MinMaxHeap<T, Compare, Key>::remove(int idx) {
+	T r_data = std::move((*heap)[idx]);
+	T last = heap->pop();
+	if (idx < length()) {
+		(*heap)[idx] = std::move(last);
+		if (minLevel(idx)) {
+			trickleDown<true>(idx);
+		} else {
+			trickleDown<false>(idx);
+		}
+	}
+	return r_data;
+}
+
+template <class T, class Compare, class Key>
+bool MinMaxHeap<T, Compare, Key>::push(T data, T* evicted) {
+	if (!isFull()) {
+		insert(data);
+		return false;
+	}
+
+	// Data is dropped itself unless it lies strictly inside the evicting end
+	bool keep = evict_max ? less(data, (*heap)[maxIndex()]) : less((*heap)[0], data);
+	T dropped = data;
+	if (keep) {
+		dropped = evict_max ? popMax() : popMin();
+		insert(data);
+	}
+	if (evicted != nullptr) {
+		*evicted = dropped;
+	}
+	return true;
+}
+
+template <class T, class Compare, class Key>
+T MinMaxHeap<T, Compare, Key>::popMin() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty heap");
+	}
+	return remove(0);
+}
+
+template <class T, class Compare, class Key>
+T MinMaxHeap<T, Compare, Key>::popMax() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty heap");
+	}
+	return remove(maxIndex());
+}
+
+template <class T, class Compare, class Key>
+T MinMaxHeap<T, Compare, Key>::peekMin() const {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot peek an empty heap");
+	}
+	return (*heap)[0];
+}
+
+template <class T, class Compare, class Key>
+T MinMaxHeap<T, Compare, Key>::peekMax() const {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot peek an empty heap");
+	}
+	return (*heap)[maxIndex()];
+}
+
+template <class T, class Compare, class Key>
+bool MinMaxHeap<T, Compare, Key>::validHeap() const {
+	for (int i = 1; i < length(); i++) {
+		// Each node must respect its parent, and its grandparent which shares its kind of level
+		int parent = (i - 1) / 2;
+		if (minLevel(parent) ? less((*heap)[i], (*heap)[parent]) : less((*heap)[parent], (*heap)[i])) {
+			return false;
+		}
+		if (i > 2) {
+			int grandparent = (parent - 1) / 2;
+			if (minLevel(grandparent) ? less((*heap)[i], (*heap)[grandparent]) : less((*heap)[grandparent], (*heap)[i])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
@@ -0,0 +1,217 @@
+/**
+ * @file mpmcqueue.h
+ * @brief Bounded lock-free multi-producer/multi-consumer queue.
+ *
+ * This class implements Dmitry Vyukov's bounded MPMC queue. Every slot carries a sequence
+ * number that tells producers when the slot is free and consumers when it is full, so
+ * threads only contend on a single compare-and-swap of the shared position and never on
+ * each other's slots.
+ *
+ * @tparam T The data type stored in the queue.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class MPMCQueue
+ * @brief A bounded lock-free ring queue for any number of producer and consumer threads.
+ *
+ * @tparam T The data type stored in the queue.
+ */
+template <class T>
+class MPMCQueue {
+private:
+	// Assumed size of a cache line, used to keep the two positions from false sharing
+	static const std::size_t CACHE_LINE = 64;
+
+	/**
+	 * @struct Cell
+	 * @brief A slot in the ring.
+	 *
+	 * The sequence equals the slot's next enqueue position when the slot is free, and
+	 * that position plus one once it holds data.
+	 */
+	struct Cell {
+		std::atomic<std::size_t> sequence;
+		T data;
+	};
+
+	Cell* cells;
+	std::size_t cap;
+	std::size_t mask;
+
+	alignas(CACHE_LINE) std::atomic<std::size_t> enqueue_pos;
+	alignas(CACHE_LINE) std::atomic<std::size_t> dequeue_pos;
+
+	// Keeps the dequeue position's cache line clear of whatever follows the queue in memory
+	char padding[CACHE_LINE - sizeof(std::atomic<std::size_t>)];
+
+	/**
+	 * @brief Claims up to a given number of consecutive positions whose cells are in a given state.
+	 * @param pos The shared position to advance.
+	 * @param max The maximum number of positions to claim.
+	 * @param offset The difference between a ready cell's sequence and its position (0 to push, 1 to pop).
+	 * @param start Receives the first claimed position.
+	 * @return The number of positions claimed, which is 0 if the first cell is not ready.
+	 */
+	std::size_t claim(std::atomic<std::size_t>& pos, std::size_t max, std::size_t offset, std::size_t& start);
+
+	/**
+	 * @brief Rounds a capacity up to the next power of two.
+	 * @param size The requested capacity.
+	 * @return The smallest power of two no less than size.
+	 */
+	static std::size_t roundUp(int size);
+
+public:
+	/**
+	 * @brief Constructs an empty queue with a fixed capacity (O(n)).
+	 * @param size The capacity of the queue, rounded up to a power of two no less than 2.
+	 * @throws std::invalid_argument If the capacity is not positive.
+	 */
+	MPMCQueue(int size);
+
+	MPMCQueue(const MPMCQueue&) = delete;
+	MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+	/**
+	 * @brief Destroys the queue and frees all allocated memory (O(1)).
+	 */
+	~MPMCQueue() { delete[] cells; }
+
+	/**
+	 * @brief Adds an element to the back of the queue if there is room (O(1)).
+	 * @param data The data to push into the queue.
+	 * @return True if the element was added, false if the queue was full.
+	 */
+	bool tryPush(const T& data) { return pushMany(&data, 1) == 1; }
+
+	/**
+	 * @brief Adds consecutive elements from an array while there is room, claiming their slots with a single CAS (O(k)).
+	 * @param data The array of data to push into the queue.
+	 * @param size The size of the array.
+	 * @return The number of elements added.
+	 */
+	int pushMany(const T data[], int size);
+
+	/**
+	 * @brief Removes an element from the front of the queue if there is one (O(1)).
+	 * @param out Receives the removed element.
+	 * @return True if an element was removed, false if the queue was empty.
+	 */
+	bool tryPop(T& out) { return popMany(&out, 1) == 1; }
+
+	/**
+	 * @brief Removes up to a given number of elements into an array, claiming their slots with a single CAS (O(k)).
+	 * @param out The array to copy the elements into.
+	 * @param max The maximum number of elements to remove.
+	 * @return The number of elements removed.
+	 */
+	int popMany(T out[], int max);
+
+	/**
+	 * @brief Returns a snapshot of the length of the queue (O(1)).
+	 * @return The number of claimed elements, which may briefly include ones still being written.
+	 */
+	int length() const;
+
+	/**
+	 * @brief Returns the maximum number of elements the queue can hold (O(1)).
+	 * @return The capacity of the queue.
+	 */
+	int capacity() const { return static_cast<int>(cap); }
+
+	/**
+	 * @brief Checks if the queue is empty at the time of the call (O(1)).
+	 * @return True if the queue is empty, false otherwise.
+	 */
+	bool isEmpty() const { return length() == 0; }
+};
+
+
+template <class T>
+std::size_t MPMCQueue<T>::roundUp(int size) {
+	std::size_t result = 2;
+	while (result < static_cast<std::size_t>(size)) {
+		result *= 2;
+	}
+	return result;
+}
+
+template <class T>
+MPMCQueue<T>::MPMCQueue(int size) : cells(nullptr), cap(0), mask(0), enqueue_pos(0), dequeue_pos(0) {
+	if (size <= 0) {
+		throw std::invalid_argument("Capacity must be positive");
+	}
+	cap = roundUp(size);
+	mask = cap - 1;
+	cells = new Cell[cap];
+	for (std::size_t i = 0; i < cap; i++) {
+		cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+template <class T>
+std::size_t MPMCQueue<T>::claim(std::atomic<std::size_t>& pos, std::size_t max, std::size_t offset, std::size_t& start) {
+	start = pos.load(std::memory_order_relaxed);
+	while (true) {
+		std::size_t count = 0;
+		bool stale = false;
+		while (count < max) {
+			std::size_t seq = cells[(start + count) & mask].sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (start + count + offset));
+			if (diff != 0) {
+				// A cell ahead of the expected sequence means another thread has moved past start
+				stale = count == 0 && diff > 0;
+				break;
+			}
+			count++;
+		}
+		if (count == 0 && !stale) {
+			return 0;
+		}
+		if (count > 0 && pos.compare_exchange_weak(start, start + count, std::memory_order_relaxed)) {
+			return count;
+		}
+		if (stale) {
+			start = pos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+template <class T>
+int MPMCQueue<T>::pushMany(const T data[], int size) {
+	std::size_t start;
+	std::size_t count = claim(enqueue_pos, static_cast<std::size_t>(std::max(size, 0)), 0, start);
+	for (std::size_t i = 0; i < count; i++) {
+		Cell& cell = cells[(start + i) & mask];
+		cell.data = data[i];
+		cell.sequence.store(start + i + 1, std::memory_order_release);
+	}
+	return static_cast<int>(count);
+}
+
+template <class T>
+int MPMCQueue<T>::popMany(T out[], int max) {
+	std::size_t start;
+	std::size_t count = claim(dequeue_pos, static_cast<std::size_t>(std::max(max, 0)), 1, start);
+	for (std::size_t i = 0; i < count; i++) {
+		Cell& cell = cells[(start + i) & mask];
+		out[i] = cell.data;
+		cell.sequence.store(start + i + cap, std::memory_order_release);
+	}
+	return static_cast<int>(count);
+}
+
+template <class T>
+int MPMCQueue<T>::length() const {
+	std::size_t head = dequeue_pos.load(std::memory_order_acquire);
+	std::size_t tail = enqueue_pos.load(std::memory_order_acquire);
+	return tail > head ? static_cast<int>(std::min(tail - head, cap)) : 0;
+}
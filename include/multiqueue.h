@@ -0,0 +1,237 @@
+/**
+ * @file multiqueue.h
+ * @brief Concurrent relaxed priority queue implementation using sharded heaps.
+ *
+ * This class implements the MultiQueue of Rihani, Sanders and Dementiev. Elements are
+ * spread over c * P priority queues, each guarded by its own mutex that threads only ever
+ * try-lock, so a busy shard is skipped rather than waited on. A push goes to a random
+ * shard, and a pop samples two random shards and takes the better of their tops. Pops are
+ * therefore relaxed: they return an element close to, but not always, the best one, with
+ * an expected rank error that grows linearly with the number of shards.
+ *
+ * @tparam T The data type stored in the queue.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "pqueue.h"
+
+/**
+ * @class MultiQueue
+ * @brief A relaxed priority queue for any number of concurrent pushing and popping threads.
+ *
+ * @tparam T The data type stored in the queue.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+template <class T, class Compare = std::less<>, class Key = std::identity>
+class MultiQueue {
+private:
+	// Assumed size of a cache line, used to keep shards from false sharing
+	static const std::size_t CACHE_LINE = 64;
+
+	/**
+	 * @struct Shard
+	 * @brief A priority queue and the mutex guarding it.
+	 */
+	struct alignas(CACHE_LINE) Shard {
+		std::mutex lock;
+		PQueue<T, Compare, Key>* heap;
+	};
+
+	Shard* shards;
+	int n_shards;
+	bool max_heap;
+	Compare comp;
+	Key key;
+	std::atomic<int> len;
+
+	inline static thread_local std::uint32_t seed = 0;
+
+	/**
+	 * @brief Returns a random shard using the calling thread's xorshift generator.
+	 * @return A shard chosen uniformly at random.
+	 */
+	Shard& pick();
+
+	/**
+	 * @brief Checks if one shard's top outranks another's. Requires both locks.
+	 * @param shard_1 The first shard.
+	 * @param shard_2 The second shard.
+	 * @return True if shard_1 is non-empty and its top has strictly higher priority than shard_2's top.
+	 */
+	bool better(const Shard& shard_1, const Shard& shard_2) const;
+
+public:
+	/**
+	 * @brief Constructs an empty queue (O(c * P)).
+	 * @param threads The number of threads expected to use the queue, or 0 for the hardware concurrency.
+	 * @param factor The relaxation factor c, the number of shards per thread.
+	 * @param max_heap Indicates whether the queue pops its maximum (true) or minimum (false).
+	 * @param comp The comparator to order keys with.
+	 * @param key The projection from elements to keys.
+	 * @throws std::invalid_argument If threads is negative or factor is not positive.
+	 */
+	MultiQueue(int threads = 0, int factor = 2, bool max_heap = false, Compare comp = Compare(), Key key = Key());
+
+	MultiQueue(const MultiQueue&) = delete;
+	MultiQueue& operator=(const MultiQueue&) = delete;
+
+	/**
+	 * @brief Destroys the queue and every shard (O(n)). No thread may still be using it.
+	 */
+	~MultiQueue();
+
+	/**
+	 * @brief Inserts an element into a random shard (O(log(n))).
+	 * @param data The element to be added.
+	 */
+	void push(T data);
+
+	/**
+	 * @brief Removes the better of the tops of two random shards (O(log(n))).
+	 * @param out Receives the removed element.
+	 * @return True if an element was removed, false if the queue was empty.
+	 */
+	bool tryPop(T& out);
+
+	/**
+	 * @brief Returns a snapshot of the length of the queue (O(1)).
+	 * @return The number of elements in the queue.
+	 */
+	int length() const { return len.load(std::memory_order_acquire); }
+
+	/**
+	 * @brief Checks if the queue is empty at the time of the call (O(1)).
+	 * @return True if the queue is empty, false otherwise.
+	 */
+	bool isEmpty() const { return length() == 0; }
+
+	/**
+	 * @brief Returns the number of shards (O(1)).
+	 * @return The number of internal priority queues.
+	 */
+	int shardCount() const { return n_shards; }
+
+	/**
+	 * @brief Checks if the queue pops its maximum (O(1)).
+	 * @return True if the queue is a maximum queue, false otherwise.
+	 */
+	bool isMax() const { return max_heap; }
+
+	/**
+	 * @brief Checks if the queue pops its minimum (O(1)).
+	 * @return True if the queue is a minimum queue, false otherwise.
+	 */
+	bool isMin() const { return !max_heap; }
+};
+
+
+template <class T, class Compare, class Key>
+MultiQueue<T, Compare, Key>::MultiQueue(int threads, int factor, bool max_heap, Compare comp, Key key) : shards(nullptr), n_shards(0), max_heap(max_heap), comp(comp), key(key), len(0) {
+	if (threads < 0) {
+		throw std::invalid_argument("Thread count must not be negative");
+	}
+	if (factor <= 0) {
+		throw std::invalid_argument("Relaxation factor must be positive");
+	}
+	if (threads == 0) {
+		threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+	n_shards = threads * factor;
+	shards = new Shard[n_shards];
+	for (int i = 0; i < n_shards; i++) {
+		shards[i].heap = new PQueue<T, Compare, Key>(max_heap, comp, key);
+	}
+}
+
+template <class T, class Compare, class Key>
+MultiQueue<T, Compare, Key>::~MultiQueue() {
+	for (int i = 0; i < n_shards; i++) {
+		delete shards[i].heap;
+	}
+	delete[] shards;
+}
+
+template <class T, class Compare, class Key>
+typename MultiQueue<T, Compare, Key>::Shard& MultiQueue<T, Compare, Key>::pick() {
+	if (seed == 0) {
+		seed = static_cast<std::uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+	}
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return shards[(static_cast<std::uint64_t>(seed) * static_cast<std::uint64_t>(n_shards)) >> 32];
+}
+
+template <class T, class Compare, class Key>
+bool MultiQueue<T, Compare, Key>::better(const Shard& shard_1, const Shard& shard_2) const {
+	if (shard_1.heap->isEmpty()) {
+		return false;
+	}
+	if (shard_2.heap->isEmpty()) {
+		return true;
+	}
+	T top_1 = shard_1.heap->peek();
+	T top_2 = shard_2.heap->peek();
+	if (max_heap) {
+		return comp(std::invoke(key, top_2), std::invoke(key, top_1));
+	}
+	return comp(std::invoke(key, top_1), std::invoke(key, top_2));
+}
+
+template <class T, class Compare, class Key>
+void MultiQueue<T, Compare, Key>::push(T data) {
+	while (true) {
+		Shard& shard = pick();
+		if (shard.lock.try_lock()) {
+			shard.heap->push(data);
+			len.fetch_add(1, std::memory_order_release);
+			shard.lock.unlock();
+			return;
+		}
+	}
+}
+
+template <class T, class Compare, class Key>
+bool MultiQueue<T, Compare, Key>::tryPop(T& out) {
+	while (length() > 0) {
+		Shard& first = pick();
+		if (!first.lock.try_lock()) {
+			continue;
+		}
+
+		// A busy or identical second sample leaves the first shard to pop from alone
+		Shard* chosen = &first;
+		Shard& second = pick();
+		if (&second != &first && second.lock.try_lock()) {
+			if (better(second, first)) {
+				first.lock.unlock();
+				chosen = &second;
+			} else {
+				second.lock.unlock();
+			}
+		}
+
+		if (chosen->heap->isEmpty()) {
+			chosen->lock.unlock();
+			continue;
+		}
+		out = chosen->heap->pop();
+		len.fetch_sub(1, std::memory_order_release);
+		chosen->lock.unlock();
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,480 @@
+/**
+ * @file pairingheap.h
+ * @brief Mergeable priority queue implementation using a pairing heap.
+ *
+ * This class implements a pairing heap: a heap-ordered multiway tree stored as first-child
+ * and sibling links. Pushing and melding only link two roots, so both take O(1), while
+ * popping pairs up the root's children in two passes for amortized O(log n). Handles
+ * returned from push allow cheap decrease-key by cutting a subtree and relinking it.
+ *
+ * Nodes are carved from blocks owned by the heap and recycled through a free list. Melding
+ * splices the other heap's blocks and free list onto this one, so it stays O(1).
+ *
+ * @tparam T The data type stored in the heap.
+ * @tparam Compare The strict weak ordering on keys, where Compare(a, b) means a has higher priority in a min-heap.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <functional>
+#include <utility>
+#include "vector.h"
+
+/**
+ * @class PairingHeap
+ * @brief A priority queue with O(1) push and meld and handle-based decrease-key.
+ *
+ * A handle stays valid until its element is popped or the heap is cleared. Handles into
+ * a heap that is melded into another remain valid in the heap that absorbed it. As in
+ * PQueue, the heap direction is chosen once per operation and the linking and combining
+ * passes are instantiated separately for each.
+ *
+ * @tparam T The data type stored in the heap.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+template <class T, class Compare = std::less<>, class Key = std::identity>
+class PairingHeap {
+private:
+	// Number of nodes allocated together in a block
+	static const int BLOCK_SIZE = 64;
+
+	/**
+	 * @struct Node
+	 * @brief A node in the heap.
+	 *
+	 * prev points to the parent for a first child and to the left sibling otherwise.
+	 * Free nodes are chained through sibling.
+	 */
+	struct Node {
+		T data;
+		Node* child;
+		Node* sibling;
+		Node* prev;
+	};
+
+	/**
+	 * @struct Block
+	 * @brief A block of nodes, chained to the block allocated before it.
+	 */
+	struct Block {
+		Node nodes[BLOCK_SIZE];
+		Block* next;
+	};
+
+	Node* root;
+	int len;
+	bool max_heap;
+	Compare comp;
+	Key key;
+
+	Block* blocks;
+	Block* last_block;
+	int used;
+	Node* free_head;
+	Node* free_tail;
+
+	/**
+	 * @brief Checks if one element must sit above another.
+	 * @param data_1 The first element.
+	 * @param data_2 The second element.
+	 * @return True if data_1 has strictly higher priority than data_2, false otherwise.
+	 */
+	template <bool Max>
+	bool compare(const T& data_1, const T& data_2) const;
+
+	/**
+	 * @brief Takes a node from the free list, or from the newest block if the free list is empty.
+	 * @return An unlinked node.
+	 */
+	Node* allocate();
+
+	/**
+	 * @brief Returns a node to the free list.
+	 * @param node The node to release.
+	 */
+	void release(Node* node);
+
+	/**
+	 * @brief Links two roots, making the one with lower priority the first child of the other.
+	 * @param node_1 The first root, or nullptr.
+	 * @param node_2 The second root, or nullptr.
+	 * @return The root of the linked tree.
+	 */
+	template <bool Max>
+	Node* link(Node* node_1, Node* node_2);
+
+	/**
+	 * @brief Detaches a node and its subtree from its parent and siblings.
+	 * @param node The node to detach, which must not be the root.
+	 */
+	static void cut(Node* node);
+
+	/**
+	 * @brief Links a list of sibling trees into one, pairing left to right and then folding right to left.
+	 * @param first The first tree in the list, or nullptr.
+	 * @return The root of the combined tree, or nullptr if the list was empty.
+	 */
+	template <bool Max>
+	Node* combine(Node* first);
+
+	/**
+	 * @brief Frees every block and resets the heap to empty.
+	 */
+	void destroy();
+
+	/**
+	 * @brief Links a tree into the root list, in the direction of the heap.
+	 * @param node The root of the tree to link, or nullptr.
+	 */
+	void linkRoot(Node* node) { root = max_heap ? link<true>(root, node) : link<false>(root, node); }
+
+	/**
+	 * @brief Checks that every child of every node is ordered after it and linked back to its predecessor.
+	 * @return True if both hold, false otherwise.
+	 */
+	template <bool Max>
+	bool validFrom() const;
+
+public:
+	typedef Node* Handle;
+
+	/**
+	 * @brief Constructs an empty heap (O(1)).
+	 * @param max_heap Indicates whether the heap is a max-heap (true) or min-heap (false).
+	 * @param comp The comparator to order keys with.
+	 * @param key The projection from elements to keys.
+	 */
+	PairingHeap(bool max_heap = false, Compare comp = Compare(), Key key = Key()) : root(nullptr), len(0), max_heap(max_heap), comp(comp), key(key), blocks(nullptr), last_block(nullptr), used(BLOCK_SIZE), free_head(nullptr), free_tail(nullptr) {}
+
+	PairingHeap(const PairingHeap&) = delete;
+	PairingHeap& operator=(const PairingHeap&) = delete;
+
+	/**
+	 * @brief Destroys the heap and frees all of its blocks (O(n)).
+	 */
+	~PairingHeap() { destroy(); }
+
+	/**
+	 * @brief Inserts an element into the heap (O(1)).
+	 * @param data The element to be added.
+	 * @return The handle of the new element.
+	 */
+	Handle push(T data);
+
+	/**
+	 * @brief Moves every element of another heap into this one, leaving the other empty (O(1)).
+	 * @param other The heap to absorb.
+	 * @throws std::invalid_argument If the heaps are ordered in opposite directions.
+	 */
+	void meld(PairingHeap& other);
+
+	/**
+	 * @brief Replaces an element with one of equal or higher priority (O(1), amortized O(log(n)) on the next pop).
+	 * @param handle The handle of the element.
+	 * @param data The new value of the element.
+	 * @throws std::invalid_argument If the new value has lower priority than the old one.
+	 */
+	void decreaseKey(Handle handle, T data);
+
+	/**
+	 * @brief Clears the heap, invalidating every handle (O(n)).
+	 */
+	void clear() { destroy(); }
+
+	/**
+	 * @brief Returns the length of the heap (O(1)).
+	 * @return The number of elements in the heap.
+	 */
+	int length() const { return len; }
+
+	/**
+	 * @brief Checks if the heap is empty (O(1)).
+	 * @return True if the heap is empty, false otherwise.
+	 */
+	bool isEmpty() const { return len == 0; }
+
+	/**
+	 * @brief Checks if the heap is a maximum heap (O(1)).
+	 * @return True if the heap is a maximum heap, false otherwise.
+	 */
+	bool isMax() const { return max_heap; }
+
+	/**
+	 * @brief Checks if the heap is a minimum heap (O(1)).
+	 * @return True if the heap is a minimum heap, false otherwise.
+	 */
+	bool isMin() const { return !max_heap; }
+
+	/**
+	 * @brief Returns the element with a given handle (O(1)).
+	 * @param handle The handle of the element.
+	 * @return The value of the element.
+	 */
+	T get(Handle handle) const { return handle->data; }
+
+	/**
+	 * @brief Checks if the heap order and the tree links are still consistent (O(n)).
+	 * @return True if both hold, false otherwise.
+	 */
+	bool validHeap() const;
+
+	/**
+	 * @brief Removes and returns the element with the highest priority (amortized O(log(n))).
+	 * @return The element with the highest priority.
+	 * @throws std::runtime_error If the heap is empty.
+	 */
+	T pop();
+
+	/**
+	 * @brief Returns the element with the highest priority (O(1)).
+	 * @return The element with the highest priority.
+	 * @throws std::runtime_error If the heap is empty.
+	 */
+	T peek() const;
+};
+
+
+template <class T, class Compare, class Key>
+template <bool Max>
+bool PairingHeap<T, Compare, Key>::compare(const T& data_1, const T& data_2) const {
+	if constexpr (Max) {
+		return comp(std::invoke(key, data_2), std::invoke(key, data_1));
+	} else {
+		return comp(std::invoke(key, data_1), std::invoke(key, data_2));
+	}
+}
+
+template <class T, class Compare, class Key>
+typename PairingHeap<T, Compare, Key>::Node* PairingHeap<T, Compare, Key>::allocate() {
+	Node* node;
+	if (free_head != nullptr) {
+		node = free_head;
+		free_head = node->sibling;
+		if (free_head == nullptr) {
+			free_tail = nullptr;
+		}
+	} else {
+		if (used == BLOCK_SIZE) {
+			Block* block = new Block;
+			block->next = blocks;
+			blocks = block;
+			if (last_block == nullptr) {
+				last_block = block;
+			}
+			used = 0;
+		}
+		node = &blocks->nodes[used++];
+	}
+	node->child = nullptr;
+	node->sibling = nullptr;
+	node->prev = nullptr;
+	return node;
+}
+
+template <class T, class Compare, class Key>
+void PairingHeap<T, Compare, Key>::release(Node* node) {
+	node->data = T();
+	node->sibling = free_head;
+	free_head = node;
+	if (free_tail == nullptr) {
+		free_tail = node;
+	}
+}
+
+template <class T, class Compare, class Key>
+template <bool Max>
+typename PairingHeap<T, Compare, Key>::Node* PairingHeap<T, Compare, Key>::link(Node* node_1, Node* node_2) {
+	if (node_1 == nullptr) {
+		return node_2;
+	}
+	if (node_2 == nullptr) {
+		return node_1;
+	}
+	if (compare<Max>(node_2->data, node_1->data)) {
+		std::swap(node_1, node_2);
+	}
+	node_2->prev = node_1;
+	node_2->sibling = node_1->child;
+	if (node_1->child != nullptr) {
+		node_1->child->prev = node_2;
+	}
+	node_1->child = node_2;
+	return node_1;
+}
+
+template <class T, class Compare, class Key>
+void PairingHeap<T, Compare, Key>::cut(Node* node) {
+	if (node->prev->child == node) {
+		node->prev->child = node->sibling;
+	} else {
+		node->prev->sibling = node->sibling;
+	}
+	if (node->sibling != nullptr) {
+		node->sibling->prev = node->prev;
+	}
+	node->prev = nullptr;
+	node->sibling = nullptr;
+}
+
+template <class T, class Compare, class Key>
+template <bool Max>
+typename PairingHeap<T, Compare, Key>::Node* PairingHeap<T, Compare, Key>::combine(Node* first) {
+	// First pass: link adjacent pairs, stacking the results through sibling
+	Node* paired = nullptr;
+	while (first != nullptr) {
+		Node* node_1 = first;
+		Node* node_2 = first->sibling;
+		first = node_2 != nullptr ? node_2->sibling : nullptr;
+
+		node_1->prev = nullptr;
+		node_1->sibling = nullptr;
+		if (node_2 != nullptr) {
+			node_2->prev = nullptr;
+			node_2->sibling = nullptr;
+		}
+		Node* tree = link<Max>(node_1, node_2);
+		tree->sibling = paired;
+		paired = tree;
+	}
+
+	// Second pass: fold the stack, which visits the pairs from right to left
+	Node* result = nullptr;
+	while (paired != nullptr) {
+		Node* next = paired->sibling;
+		paired->sibling = nullptr;
+		result = link<Max>(result, paired);
+		paired = next;
+	}
+	return result;
+}
+
+template <class T, class Compare, class Key>
+void PairingHeap<T, Compare, Key>::destroy() {
+	while (blocks != nullptr) {
+		Block* temp = blocks->next;
+		delete blocks;
+		blocks = temp;
+	}
+	root = nullptr;
+	len = 0;
+	last_block = nullptr;
+	used = BLOCK_SIZE;
+	free_head = nullptr;
+	free_tail = nullptr;
+}
+
+template <class T, class Compare, class Key>
+typename PairingHeap<T, Compare, Key>::Handle PairingHeap<T, Compare, Key>::push(T data) {
+	Node* node = allocate();
+	node->data = data;
+	linkRoot(node);
+	len++;
+	return node;
+}
+
+template <class T, class Compare, class Key>
+void PairingHeap<T, Compare, Key>::meld(PairingHeap& other) {
+	if (&other == this) {
+		return;
+	}
+	if (other.max_heap != max_heap) {
+		throw std::invalid_argument("Cannot meld heaps ordered in opposite directions");
+	}
+
+	linkRoot(other.root);
+	len += other.len;
+
+	// Nodes left unused in the other heap's newest block join the free list, bounding the cost by the block size
+	for (int i = other.used; i < BLOCK_SIZE; i++) {
+		other.release(&other.blocks->nodes[i]);
+	}
+	if (other.free_head != nullptr) {
+		other.free_tail->sibling = free_head;
+		free_head = other.free_head;
+		if (free_tail == nullptr) {
+			free_tail = other.free_tail;
+		}
+	}
+	// The other heap's blocks go after this heap's, so the newest block stays the one being carved
+	if (other.blocks != nullptr) {
+		if (blocks == nullptr) {
+			blocks = other.blocks;
+			used = BLOCK_SIZE;
+		} else {
+			last_block->next = other.blocks;
+		}
+		last_block = other.last_block;
+	}
+
+	other.blocks = nullptr;
+	other.destroy();
+}
+
+template <class T, class Compare, class Key>
+void PairingHeap<T, Compare, Key>::decreaseKey(Handle handle, T data) {
+	if (max_heap ? compare<true>(handle->data, data) : compare<false>(handle->data, data)) {
+		throw std::invalid_argument("New key has lower priority than the current key");
+	}
+	handle->data = data;
+	if (handle != root) {
+		cut(handle);
+		linkRoot(handle);
+	}
+}
+
+template <class T, class Compare, class Key>
+bool PairingHeap<T, Compare, Key>::validHeap() const {
+	if (root == nullptr) {
+		return len == 0;
+	}
+	if (root->prev != nullptr || root->sibling != nullptr) {
+		return false;
+	}
+	return max_heap ? validFrom<true>() : validFrom<false>();
+}
+
+template <class T, class Compare, class Key>
+template <bool Max>
+bool PairingHeap<T, Compare, Key>::validFrom() const {
+	Vector<Node*> stack;
+	stack.push(root);
+	int count = 0;
+	while (!stack.isEmpty()) {
+		Node* node = stack.pop();
+		count++;
+		Node* prev = node;
+		for (Node* child = node->child; child != nullptr; child = child->sibling) {
+			if (child->prev != prev || compare<Max>(child->data, node->data)) {
+				return false;
+			}
+			stack.push(child);
+			prev = child;
+		}
+	}
+	return count == len;
+}
+
+template <class T, class Compare, class Key>
+T PairingHeap<T, Compare, Key>::pop() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty heap");
+	}
+	Node* old_root = root;
+	T r_data = std::move(old_root->data);
+	root = max_heap ? combine<true>(old_root->child) : combine<false>(old_root->child);
+	release(old_root);
+	len--;
+	return r_data;
+}
+
+template <class T, class Compare, class Key>
+T PairingHeap<T, Compare, Key>::peek() const {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot peek an empty heap");
+	}
+	return root->data;
+}
@@ -1,114 +1,214 @@
 /**
  * @file pqueue.h
- * @brief Priority queue implementation using binary heaps.
- * 
- * This class implements a priority queue using a binary heap stored in a dynamic array.
- * It supports both min-heap (default) and max-heap configurations and provides
- * efficient push/pop operations with O(log n) complexity.
+ * @brief Priority queue implementation using d-ary heaps.
+ *
+ * This class implements a priority queue using a d-ary heap stored in a dynamic array.
+ * Elements are ordered by a comparator type applied to a key projected from each element,
+ * so both inline into the heap operations. It supports both min-heap (default) and
+ * max-heap configurations and provides efficient push/pop operations with O(log n) complexity.
+ *
+ * The heap is binary by default. Wider heaps are shallower, trading more comparisons per
+ * level for fewer levels and therefore fewer cache misses on large queues.
  *
  * @tparam T The data type stored in the priority queue.
+ * @tparam Compare The strict weak ordering on keys, where Compare(a, b) means a has higher priority in a min-heap.
+ * @tparam Key The projection applied to each element to obtain its key.
+ * @tparam Arity The number of children of each node.
  */
 
 #pragma once
 
 #include <iostream>
 #include <stdexcept>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
 #include "vector.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 /**
  * @class PQueue
- * @brief A priority queue implemented as a binary heap.
+ * @brief A priority queue implemented as a d-ary heap.
+ *
+ * A max-heap reverses the comparator. The choice is made once per operation rather than
+ * once per comparison, so the sift loops are instantiated separately for each direction.
+ *
+ * The heap array is allocated on a cache line boundary and the root is stored at index
+ * Arity - 1, so the children of every node start at a multiple of Arity. With
+ * Arity * sizeof(T) equal to a cache line, each group of siblings then fills exactly
+ * one line. Sifts move a hole rather than swapping, writing each displaced element once.
  *
  * @tparam T The data type stored in the priority queue.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ * @tparam Arity The number of children of each node.
  */
-template <class T>
+template <class T, class Compare = std::less<>, class Key = std::identity, int Arity = 2>
 class PQueue {
+	static_assert(Arity >= 2, "PQueue arity must be at least 2");
+
 private:
-	Vector<T>* heap;
+	// Assumed size of a cache line, the alignment of the heap array
+	static const std::size_t CACHE_LINE = 64;
+	// Number of unused slots before the root, which align sibling groups to multiples of Arity
+	static const int ROOT = Arity - 1;
+	// Batches of at least 1 / BULK_RATIO of the resulting heap are heapified in bulk rather than sifted one by one
+	static const int BULK_RATIO = 8;
+
+	// Compares children with SIMD min/max when elements are their own int or float keys under std::less or std::greater
+	static constexpr bool LESS = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>;
+	static constexpr bool GREATER = std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>;
+	static constexpr bool SIMD = (Arity % 4 == 0) && std::is_same_v<Key, std::identity> && (LESS || GREATER) && (std::is_same_v<T, int> || std::is_same_v<T, float>);
+
+	Vector<T, CACHE_LINE>* heap;
 	bool max_heap;
+	Compare comp;
+	Key key;
+
+	/**
+	 * @brief Restablishes the heap property, moving a hole upwards.
+	 * @param idx The position of the node to move up.
+	 * @return The position the node settled at.
+	 */
+	template <bool Max>
+	int heapifyUp(int idx);
+
+	/**
+	 * @brief Restablishes the heap property, moving a hole downwards.
+	 * @param idx The position of the node to move down.
+	 * @return The position the node settled at.
+	 */
+	template <bool Max>
+	int heapifyDown(int idx);
+
+	/**
+	 * @brief Returns the position of the parent of a node.
+	 * @param idx The position of the child node.
+	 * @return The position of the parent node.
+	 */
+	int parent(int idx) const { return idx / Arity + Arity - 2; }
 
 	/**
-	 * @brief Restablishes the heap property, moving upwards.
-	 * @param idx The index of the node to move up.
+	 * @brief Returns the position of the first child of a node, which is always a multiple of Arity.
+	 * @param idx The position of the parent node.
+	 * @return The position of the first child node.
 	 */
-	void heapifyUp(int idx);
+	int firstChild(int idx) const { return Arity * (idx - Arity + 2); }
 
 	/**
-	 * @brief Restablishes the heap property, moving downwards.
-	 * @param idx The index of the node to move down.
+	 * @brief Returns the position one past the last element.
+	 * @return The end position of the heap.
 	 */
-	void heapifyDown(int idx);
+	int end() const { return heap->length(); }
 
 	/**
-	 * @brief Swaps two nodes using their indices.
-	 * @param idx_1 The index of the first node.
-	 * @param idx_2 The index of the second node.
+	 * @brief Checks if one element must sit above another.
+	 * @param node_1 The first element.
+	 * @param node_2 The second element.
+	 * @return True if node_1 has strictly higher priority than node_2, false otherwise.
 	 */
-	void swap(int idx_1, int idx_2);
+	template <bool Max>
+	bool compare(const T& node_1, const T& node_2) const;
 
 	/**
-	 * @brief Returns the index of a parent at a specific index.
-	 * @param idx The index of the child node.
-	 * @return The index of the parent node.
+	 * @brief Returns the highest priority child in a group of siblings.
+	 * @param first The position of the first sibling.
+	 * @param last The position one past the last sibling.
+	 * @return The position of the highest priority sibling.
 	 */
-	int parent(int idx) const { return (idx - 1) / 2; }
+	template <bool Max>
+	int bestChild(int first, int last) const;
 
 	/**
-	 * @brief Returns the index of the left child at a specific index.
-	 * @param idx The index of the parent node.
-	 * @return The index of the left child node.
+	 * @brief Returns the offset of the highest priority element in a full group of Arity siblings using SIMD min/max.
+	 * @param group The first sibling.
+	 * @return The offset of the highest priority sibling.
 	 */
-	int leftChild(int idx) const { return 2 * idx + 1; }
+	template <bool Max>
+	static int bestChildSimd(const T* group);
 
 	/**
-	 * @brief Returns the index of the right child at a specific index.
-	 * @param idx The index of the parent node.
-	 * @return The index of the right child node.
+	 * @brief Restores the heap property after the node at a position has changed in either direction.
+	 * @param idx The position of the changed node.
 	 */
-	int rightChild(int idx) const { return 2 * idx + 2; }
+	void restore(int idx);
 
 	/**
-	 * @brief Checks how the node held at the first index compares with the node held at the second index.
-	 * @param idx_1 The index of the first node.
-	 * @param idx_2 The index of the second node.
-	 * @return True if the node at idx_1 is greater than or equal to the node at idx_2, false otherwise.
+	 * @brief Rebuilds the heap property over the whole array using Floyd's method (O(n)).
 	 */
-	bool compare(int idx_1, int idx_2) const;
+	template <bool Max>
+	void build();
 
 	/**
-	 * @brief Removes a node at a specific index in the heap.
-	 * @param idx The index of the node to remove.
+	 * @brief Removes a node at a specific position in the heap.
+	 * @param idx The position of the node to remove.
 	 * @return The data of the removed node.
 	 * @throws std::runtime_error If the priority queue is empty.
 	 */
 	T remove(int idx);
 
+	/**
+	 * @struct Outranks
+	 * @brief Orders heap positions by the priority of the elements stored at them.
+	 */
+	template <bool Max>
+	struct Outranks {
+		const PQueue* pqueue;
+
+		bool operator()(int idx_1, int idx_2) const { return pqueue->template compare<Max>((*pqueue->heap)[idx_1], (*pqueue->heap)[idx_2]); }
+	};
+
+	/**
+	 * @brief Copies the highest priority elements by expanding a frontier of heap positions, best first.
+	 * @param k The maximum number of elements to copy.
+	 * @param out The array to copy the elements into.
+	 * @return The number of elements copied.
+	 */
+	template <bool Max>
+	int topKFrom(int k, T out[]) const;
+
 public:
 	/**
 	 * @brief Constructs a new priority queue (O(1)).
-	 * @param is_max Indicates whether the heap is a max-heap (true) or min-heap (false).
+	 * @param max_heap Indicates whether the heap is a max-heap (true) or min-heap (false).
+	 * @param comp The comparator to order keys with.
+	 * @param key The projection from elements to keys.
 	 */
-	PQueue(bool max_heap = false) : heap(new Vector<T>()), max_heap(max_heap) {}
+	PQueue(bool max_heap = false, Compare comp = Compare(), Key key = Key()) : PQueue(0, max_heap, comp, key) {}
 
 	/**
 	 * @brief Constructs a new priority queue with a specified size (O(1)).
 	 * @param size The initial size of the priority queue.
-	 * @param is_max Indicates whether the heap is a max-heap (true) or min-heap (false).
+	 * @param max_heap Indicates whether the heap is a max-heap (true) or min-heap (false).
+	 * @param comp The comparator to order keys with.
+	 * @param key The projection from elements to keys.
 	 */
-	PQueue(int size, bool max_heap = false) : heap(new Vector<T>(size)), max_heap(max_heap) {}
+	PQueue(int size, bool max_heap = false, Compare comp = Compare(), Key key = Key()) : heap(new Vector<T, CACHE_LINE>(size + ROOT)), max_heap(max_heap), comp(comp), key(key) {
+		for (int i = 0; i < ROOT; i++) {
+			heap->push(T());
+		}
+	}
 
 	/**
 	 * @brief Constructs a new priority queue with data from an array (O(n)).
 	 * @param data The array of elements to be added to the priority queue.
 	 * @param size The number of elements in the array.
-	 * @param is_max Indicates whether the heap is a max-heap (true) or min-heap (false).
+	 * @param max_heap Indicates whether the heap is a max-heap (true) or min-heap (false).
+	 * @param comp The comparator to order keys with.
+	 * @param key The projection from elements to keys.
 	 */
-	PQueue(T data[], int size, bool max_heap = false) : heap(new Vector<T>(size)), max_heap(max_heap) {
-		for (int i = 0; i < size; i++) {
-			heap->push(data[i]);
-		}
-		for (int i = (size / 2) - 1; i >= 0; i--) {
-			heapifyDown(i);
+	PQueue(T data[], int size, bool max_heap = false, Compare comp = Compare(), Key key = Key()) : PQueue(size, max_heap, comp, key) {
+		heap->push(data, size);
+		if (max_heap) {
+			build<true>();
+		} else {
+			build<false>();
 		}
 	}
 
@@ -121,15 +221,66 @@ public:
 	 * @brief Inserts an element into the priority queue (O(log(n))).
 	 * @param data The element to be added.
 	 */
-	void push(T data) { heap->push(data); heapifyUp(length() - 1); }
+	void push(T data);
+
+	/**
+	 * @brief Inserts an array of elements into the priority queue (O(k log(n)), or O(n) for large batches).
+	 *
+	 * Batches that are large relative to the heap are appended and heapified in bulk instead of sifted one by one.
+	 *
+	 * @param data The array of elements to be added.
+	 * @param size The size of the array.
+	 */
+	void pushMany(T data[], int size);
+
+	/**
+	 * @brief Inserts an element and then removes the highest priority element, in a single sift (O(log(n))).
+	 * @param data The element to be added.
+	 * @return The highest priority element, which is data itself if nothing in the heap outranks it.
+	 */
+	T pushPop(T data);
+
+	/**
+	 * @brief Removes up to a given number of the highest priority elements (O(k log(n))).
+	 * @param max The maximum number of elements to remove.
+	 * @param out The array to move the elements into, in priority order.
+	 * @return The number of elements removed.
+	 */
+	int popMany(int max, T out[]);
+
+	/**
+	 * @brief Copies up to a given number of the highest priority elements without removing them (O(k log(k))).
+	 * @param k The maximum number of elements to copy.
+	 * @param out The array to copy the elements into, in priority order.
+	 * @return The number of elements copied.
+	 */
+	int topK(int k, T out[]) const;
+
+	/**
+	 * @brief Sorts the elements into priority order, which is itself a valid heap (O(n log(n))).
+	 * @return The elements, from highest to lowest priority, valid until the priority queue is next modified.
+	 */
+	const T* sort();
+
+	/**
+	 * @brief Grows the capacity to hold at least a given number of elements, and keeps it there through pops and clears (O(n)).
+	 * @param size The number of elements to reserve space for.
+	 */
+	void reserve(int size) { heap->reserve(size + ROOT); }
 
 	/**
-	 * @brief Clears the priority queue (O(1)).
+	 * @brief Returns the number of elements the priority queue can hold without reallocating (O(1)).
+	 * @return The capacity of the priority queue.
 	 */
-	void clear() { delete heap; heap = new Vector<T>(); }
+	int capacity() const { return heap->capacity() - ROOT; }
 
 	/**
-	 * @brief Displays the dynamic array used to represent the heap (O(n)).
+	 * @brief Clears the priority queue, keeping any reserved capacity (O(1)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Displays the dynamic array used to represent the heap, including the unused slots before the root (O(n)).
 	 */
 	void debug() const { heap->debug(); }
 
@@ -137,14 +288,20 @@ public:
 	 * @brief Returns the length of the priority queue (O(1)).
 	 * @return The number of elements in the priority queue.
 	 */
-	int length() const { return heap->length(); }
+	int length() const { return heap->length() - ROOT; }
+
+	/**
+	 * @brief Returns the number of children of each node (O(1)).
+	 * @return The arity of the heap.
+	 */
+	int arity() const { return Arity; }
 
 	/**
 	 * @brief Finds the index of the first instance of a specific value in the priority queue (O(n)).
 	 * @param data The value to search for.
-	 * @return The index of the first instance of the value, or -1 if not found.
+	 * @return The index of the first instance of the value in level order, or -1 if not found.
 	 */
-	int find(T data) const { return heap->find(data); }
+	int find(T data) const;
 
 	/**
 	 * @brief Checks if the priority queue is empty (O(1)).
@@ -164,7 +321,7 @@ public:
 	 * @param data The value to check for.
 	 * @return True if the value is in the priority queue, false otherwise.
 	 */
-	bool contains(T data) const;
+	bool contains(T data) const { return find(data) != -1; }
 
 	/**
 	 * @brief Checks if the priority queue is a maximum heap (O(1)).
@@ -177,10 +334,10 @@ public:
 	 * @return True if the priority queue is a minimum heap, false otherwise.
 	 */
 	bool isMin() const { return !max_heap; }
-	
+
 	/**
 	 * @brief Checks if the heap property is still held (O(n)).
-	 * @param idx The index to start checking from.
+	 * @param idx The level-order index to start checking from.
 	 * @return True if the heap property is still held, false otherwise.
 	 */
 	bool validHeap(int idx = 0) const;
@@ -201,124 +358,323 @@ public:
 };
 
 
-template <class T>
-bool PQueue<T>::removeValue(T data) {
-	for (int i = 0; i < length(); i++) {
-		if (heap->get(i) == data) {
-			remove(i);
-			return true;
-		}
+template <class T, class Compare, class Key, int Arity>
+void PQueue<T, Compare, Key, Arity>::push(T data) {
+	heap->push(data);
+	if (max_heap) {
+		heapifyUp<true>(end() - 1);
+	} else {
+		heapifyUp<false>(end() - 1);
 	}
-	return false;
 }
 
-template <class T>
-bool PQueue<T>::contains(T data) const {
-	for (int i = 0; i < length(); i++) {
-		if (heap->get(i) == data) {
-			return true;
+template <class T, class Compare, class Key, int Arity>
+void PQueue<T, Compare, Key, Arity>::pushMany(T data[], int size) {
+	if (size <= 0) {
+		return;
+	}
+	int start = end();
+	heap->push(data, size);
+	if (size * BULK_RATIO >= length()) {
+		if (max_heap) {
+			build<true>();
+		} else {
+			build<false>();
+		}
+		return;
+	}
+	for (int i = start; i < end(); i++) {
+		if (max_heap) {
+			heapifyUp<true>(i);
+		} else {
+			heapifyUp<false>(i);
 		}
 	}
-	return false;
 }
 
-template <class T>
-bool PQueue<T>::validHeap(int idx) const {
-	if (length() > 1) {
-		if (idx >= length()) {
-			return true;
+template <class T, class Compare, class Key, int Arity>
+T PQueue<T, Compare, Key, Arity>::pushPop(T data) {
+	if (isEmpty()) {
+		return data;
+	}
+	Vector<T, CACHE_LINE>& array = *heap;
+	if (max_heap ? !compare<true>(array[ROOT], data) : !compare<false>(array[ROOT], data)) {
+		return data;
+	}
+	T top = std::move(array[ROOT]);
+	array[ROOT] = std::move(data);
+	if (max_heap) {
+		heapifyDown<true>(ROOT);
+	} else {
+		heapifyDown<false>(ROOT);
+	}
+	return top;
+}
+
+template <class T, class Compare, class Key, int Arity>
+int PQueue<T, Compare, Key, Arity>::popMany(int max, T out[]) {
+	int count = 0;
+	while (count < max && !isEmpty()) {
+		out[count++] = remove(ROOT);
+	}
+	return count;
+}
+
+template <class T, class Compare, class Key, int Arity>
+int PQueue<T, Compare, Key, Arity>::topK(int k, T out[]) const {
+	if (max_heap) {
+		return topKFrom<true>(k, out);
+	}
+	return topKFrom<false>(k, out);
+}
+
+template <class T, class Compare, class Key, int Arity>
+template <bool Max>
+int PQueue<T, Compare, Key, Arity>::topKFrom(int k, T out[]) const {
+	// Every element is outranked only by its ancestors, so the next best is always a child of one already taken
+	PQueue<int, Outranks<Max>> frontier(false, Outranks<Max>{this});
+	int count = 0;
+	if (!isEmpty()) {
+		frontier.push(ROOT);
+	}
+	while (count < k && !frontier.isEmpty()) {
+		int idx = frontier.pop();
+		out[count++] = (*heap)[idx];
+		int first = firstChild(idx);
+		for (int child = first; child < first + Arity && child < end(); child++) {
+			frontier.push(child);
 		}
-		int l_idx = leftChild(idx);
-		int r_idx = rightChild(idx);
-		if ((l_idx < length() && !compare(idx, l_idx)) || (r_idx < length() && !compare(idx, r_idx))) {
-			return false;
+	}
+	return count;
+}
+
+template <class T, class Compare, class Key, int Arity>
+const T* PQueue<T, Compare, Key, Arity>::sort() {
+	// Every parent precedes its children in the array, so a sorted array keeps the heap property
+	T* first = &(*heap)[ROOT];
+	if (max_heap) {
+		std::sort(first, first + length(), [this](const T& node_1, const T& node_2) { return compare<true>(node_1, node_2); });
+	} else {
+		std::sort(first, first + length(), [this](const T& node_1, const T& node_2) { return compare<false>(node_1, node_2); });
+	}
+	return first;
+}
+
+template <class T, class Compare, class Key, int Arity>
+void PQueue<T, Compare, Key, Arity>::clear() {
+	heap->clear();
+	for (int i = 0; i < ROOT; i++) {
+		heap->push(T());
+	}
+}
+
+template <class T, class Compare, class Key, int Arity>
+int PQueue<T, Compare, Key, Arity>::find(T data) const {
+	for (int i = ROOT; i < end(); i++) {
+		if ((*heap)[i] == data) {
+			return i - ROOT;
 		}
-		return validHeap(l_idx) && validHeap(r_idx);
 	}
-	else {
+	return -1;
+}
+
+template <class T, class Compare, class Key, int Arity>
+bool PQueue<T, Compare, Key, Arity>::removeValue(T data) {
+	int idx = find(data);
+	if (idx == -1) {
+		return false;
+	}
+	remove(idx + ROOT);
+	return true;
+}
+
+template <class T, class Compare, class Key, int Arity>
+bool PQueue<T, Compare, Key, Arity>::validHeap(int idx) const {
+	int pos = idx + ROOT;
+	if (pos >= end()) {
 		return true;
 	}
+	int first = firstChild(pos);
+	for (int child = first; child < first + Arity && child < end(); child++) {
+		if (max_heap ? compare<true>((*heap)[child], (*heap)[pos]) : compare<false>((*heap)[child], (*heap)[pos])) {
+			return false;
+		}
+		if (!validHeap(child - ROOT)) {
+			return false;
+		}
+	}
+	return true;
 }
 
-template <class T>
-T PQueue<T>::pop() {
+template <class T, class Compare, class Key, int Arity>
+T PQueue<T, Compare, Key, Arity>::pop() {
 	if (isEmpty()) {
 		throw std::runtime_error("Cannot pop from an empty priority queue");
 	}
-	return remove(0);
+	return remove(ROOT);
 }
 
-template <class T>
-T PQueue<T>::peek() const {
+template <class T, class Compare, class Key, int Arity>
+T PQueue<T, Compare, Key, Arity>::peek() const {
 	if (isEmpty()) {
 		throw std::runtime_error("Cannot peek an empty priority queue");
 	}
-	return heap->get(0);
+	return (*heap)[ROOT];
 }
 
-template <class T>
-void PQueue<T>::heapifyUp(int idx) {
-	int parent_idx = parent(idx);
-	while (idx > 0 && compare(idx, parent_idx)) {
-		swap(parent_idx, idx);
+template <class T, class Compare, class Key, int Arity>
+template <bool Max>
+int PQueue<T, Compare, Key, Arity>::heapifyUp(int idx) {
+	Vector<T, CACHE_LINE>& array = *heap;
+	T data = std::move(array[idx]);
+	while (idx > ROOT) {
+		int parent_idx = parent(idx);
+		if (!compare<Max>(data, array[parent_idx])) {
+			break;
+		}
+		array[idx] = std::move(array[parent_idx]);
 		idx = parent_idx;
-		parent_idx = parent(idx);
 	}
+	array[idx] = std::move(data);
+	return idx;
+}
+
+template <class T, class Compare, class Key, int Arity>
+template <bool Max>
+int PQueue<T, Compare, Key, Arity>::heapifyDown(int idx) {
+	Vector<T, CACHE_LINE>& array = *heap;
+	int n = end();
+	T data = std::move(array[idx]);
+	while (true) {
+		int first = firstChild(idx);
+		if (first >= n) {
+			break;
+		}
+		int best = bestChild<Max>(first, std::min(first + Arity, n));
+		if (!compare<Max>(array[best], data)) {
+			break;
+		}
+		array[idx] = std::move(array[best]);
+		idx = best;
+	}
+	array[idx] = std::move(data);
+	return idx;
 }
 
-template <class T>
-void PQueue<T>::heapifyDown(int idx) {
-	int l_idx = leftChild(idx);
-	int r_idx = rightChild(idx);
-	int min_idx = idx;
-	if ((l_idx < length()) && compare(l_idx, min_idx)) {
-		min_idx = l_idx;
+template <class T, class Compare, class Key, int Arity>
+template <bool Max>
+bool PQueue<T, Compare, Key, Arity>::compare(const T& node_1, const T& node_2) const {
+	if constexpr (Max) {
+		return comp(std::invoke(key, node_2), std::invoke(key, node_1));
+	} else {
+		return comp(std::invoke(key, node_1), std::invoke(key, node_2));
 	}
-	if ((r_idx < length()) && compare(r_idx, min_idx)) {
-		min_idx = r_idx;
+}
+
+template <class T, class Compare, class Key, int Arity>
+template <bool Max>
+int PQueue<T, Compare, Key, Arity>::bestChild(int first, int last) const {
+	const Vector<T, CACHE_LINE>& array = *heap;
+	if constexpr (SIMD) {
+		if (last - first == Arity) {
+			return first + bestChildSimd<Max>(&array[first]);
+		}
+	}
+	int best = first;
+	for (int i = first + 1; i < last; i++) {
+		if (compare<Max>(array[i], array[best])) {
+			best = i;
+		}
+	}
+	return best;
+}
+
+template <class T, class Compare, class Key, int Arity>
+template <bool Max>
+int PQueue<T, Compare, Key, Arity>::bestChildSimd(const T* group) {
+	constexpr bool want_min = LESS != Max;
+#if defined(__SSE2__)
+	if constexpr (std::is_same_v<T, int>) {
+		__m128i best = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+		for (int i = 4; i < Arity; i += 4) {
+			__m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group + i));
+			__m128i take = want_min ? _mm_cmplt_epi32(next, best) : _mm_cmpgt_epi32(next, best);
+			best = _mm_or_si128(_mm_and_si128(take, next), _mm_andnot_si128(take, best));
+		}
+		for (int shift : {0, 1}) {
+			__m128i other = shift == 0 ? _mm_shuffle_epi32(best, _MM_SHUFFLE(1, 0, 3, 2)) : _mm_shuffle_epi32(best, _MM_SHUFFLE(2, 3, 0, 1));
+			__m128i take = want_min ? _mm_cmplt_epi32(other, best) : _mm_cmpgt_epi32(other, best);
+			best = _mm_or_si128(_mm_and_si128(take, other), _mm_andnot_si128(take, best));
+		}
+		for (int i = 0; i < Arity; i += 4) {
+			__m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group + i));
+			int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(next, best)));
+			if (mask != 0) {
+				return i + std::countr_zero(static_cast<unsigned>(mask));
+			}
+		}
+	} else {
+		__m128 best = _mm_loadu_ps(group);
+		for (int i = 4; i < Arity; i += 4) {
+			best = want_min ? _mm_min_ps(best, _mm_loadu_ps(group + i)) : _mm_max_ps(best, _mm_loadu_ps(group + i));
+		}
+		__m128 other = _mm_shuffle_ps(best, best, _MM_SHUFFLE(1, 0, 3, 2));
+		best = want_min ? _mm_min_ps(best, other) : _mm_max_ps(best, other);
+		other = _mm_shuffle_ps(best, best, _MM_SHUFFLE(2, 3, 0, 1));
+		best = want_min ? _mm_min_ps(best, other) : _mm_max_ps(best, other);
+		for (int i = 0; i < Arity; i += 4) {
+			int mask = _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(group + i), best));
+			if (mask != 0) {
+				return i + std::countr_zero(static_cast<unsigned>(mask));
+			}
+		}
 	}
-	if (min_idx != idx) {
-		swap(min_idx, idx);
-		heapifyDown(min_idx);
+#endif
+	// Scalar fallback, also reached if no lane matched (a NaN key)
+	int best = 0;
+	for (int i = 1; i < Arity; i++) {
+		if (want_min ? group[i] < group[best] : group[best] < group[i]) {
+			best = i;
+		}
 	}
+	return best;
 }
 
-template <class T>
-void PQueue<T>::swap(int idx_1, int idx_2) {
-	T node_1 = heap->get(idx_1);
-	T node_2 = heap->get(idx_2);
-	heap->set(idx_1, node_2);
-	heap->set(idx_2, node_1);
+template <class T, class Compare, class Key, int Arity>
+void PQueue<T, Compare, Key, Arity>::restore(int idx) {
+	if (max_heap) {
+		if (heapifyDown<true>(idx) == idx) {
+			heapifyUp<true>(idx);
+		}
+	} else {
+		if (heapifyDown<false>(idx) == idx) {
+			heapifyUp<false>(idx);
+		}
+	}
 }
 
-template <class T>
-bool PQueue<T>::compare(int idx_1, int idx_2) const {
-	T node_1 = heap->get(idx_1);
-	T node_2 = heap->get(idx_2);
-	if (!max_heap) {
-		return (node_1 <= node_2);
+template <class T, class Compare, class Key, int Arity>
+template <bool Max>
+void PQueue<T, Compare, Key, Arity>::build() {
+	if (length() < 2) {
+		return;
+	}
+	for (int i = parent(end() - 1); i >= ROOT; i--) {
+		heapifyDown<Max>(i);
 	}
-	return(node_1 >= node_2);
 }
 
-template <class T>
-T PQueue<T>::remove(int idx) {
+template <class T, class Compare, class Key, int Arity>
+T PQueue<T, Compare, Key, Arity>::remove(int idx) {
 	if (isEmpty()) {
 		throw std::runtime_error("Cannot remove from an empty priority queue");
 	}
-	
-	T r_data = heap->get(idx);
-	swap(idx, length() - 1);
-	heap->remove(length() - 1);
-	
-	if (idx == length()) {
-		return r_data;
-	}
-	
-	T data = heap->get(idx);
-	heapifyDown(idx);
-	if (data == heap->get(idx)) {
-		heapifyUp(idx);
+
+	T r_data = std::move((*heap)[idx]);
+	T last = heap->pop();
+	if (idx < end()) {
+		(*heap)[idx] = std::move(last);
+		restore(idx);
 	}
 	return r_data;
-}
\ No newline at end of file
+}
@@ -0,0 +1,217 @@
+/**
+ * @file radixheap.h
+ * @brief Monotone priority queue implementation using a radix heap.
+ *
+ * This class implements a radix heap for unsigned integer keys where every pushed key is
+ * at least the last popped key, as in Dijkstra's algorithm with non-negative weights.
+ * Entries are bucketed by the highest bit in which their key differs from the last popped
+ * key. Popping from an empty bucket 0 redistributes the lowest non-empty bucket around its
+ * minimum, and since an entry only ever moves to a lower bucket, each costs O(log C)
+ * amortized over its lifetime, where C is the key range. Buckets are flat arrays, so
+ * redistribution scans memory sequentially and never compares two keys.
+ *
+ * @tparam Key The unsigned integer key type.
+ * @tparam Value The data type stored alongside each key.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <bit>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "vector.h"
+
+/**
+ * @class RadixHeap
+ * @brief A min-priority queue for monotone unsigned integer keys.
+ *
+ * @tparam Key The unsigned integer key type.
+ * @tparam Value The data type stored alongside each key.
+ */
+template <class Key, class Value>
+class RadixHeap {
+	static_assert(std::is_unsigned_v<Key>, "RadixHeap keys must be unsigned integers");
+
+private:
+	// One bucket for keys equal to the last popped key, and one for each bit a key can differ in
+	static const int BUCKETS = std::numeric_limits<Key>::digits + 1;
+
+	/**
+	 * @struct Entry
+	 * @brief A key and its value.
+	 */
+	struct Entry {
+		Key key;
+		Value value;
+	};
+
+	Vector<Entry> buckets[BUCKETS];
+	Key last;
+	int len;
+
+	/**
+	 * @brief Returns the bucket for a key relative to the last popped key.
+	 * @param key The key to place.
+	 * @return The index of the bucket.
+	 */
+	int bucket(Key key) const { return std::bit_width(static_cast<Key>(key ^ last)); }
+
+	/**
+	 * @brief Returns the lowest non-empty bucket, which holds the smallest key. Requires a non-empty heap.
+	 * @return The index of the bucket.
+	 */
+	int lowest() const;
+
+	/**
+	 * @brief Returns the smallest key in a bucket. Requires a non-empty bucket.
+	 * @param idx The index of the bucket.
+	 * @return The smallest key in the bucket.
+	 */
+	Key minKey(int idx) const;
+
+	/**
+	 * @brief Refills bucket 0 by redistributing the lowest non-empty bucket around its minimum key. Requires a non-empty heap.
+	 */
+	void refill();
+
+public:
+	/**
+	 * @brief Constructs an empty radix heap (O(1)).
+	 */
+	RadixHeap() : last(0), len(0) {}
+
+	RadixHeap(const RadixHeap&) = delete;
+	RadixHeap& operator=(const RadixHeap&) = delete;
+
+	/**
+	 * @brief Inserts a key and value into the heap (O(1)).
+	 * @param key The key, which must be no smaller than the last popped key.
+	 * @param value The value to store with the key.
+	 * @throws std::invalid_argument If the key is smaller than the last popped key.
+	 */
+	void push(Key key, Value value);
+
+	/**
+	 * @brief Removes and returns an entry with the smallest key (amortized O(log C)).
+	 * @return The smallest key and its value.
+	 * @throws std::runtime_error If the heap is empty.
+	 */
+	std::pair<Key, Value> pop();
+
+	/**
+	 * @brief Returns the smallest key in the heap without redistributing, so keys down to the last popped key can still be pushed (O(log C + b)).
+	 *
+	 * b is the number of entries in the lowest non-empty bucket, which is scanned for its minimum.
+	 *
+	 * @return The smallest key.
+	 * @throws std::runtime_error If the heap is empty.
+	 */
+	Key peekKey() const;
+
+	/**
+	 * @brief Returns the last popped key, below which no key may be pushed (O(1)).
+	 * @return The last popped key, or 0 if nothing has been popped.
+	 */
+	Key lastKey() const { return last; }
+
+	/**
+	 * @brief Clears the heap and resets the last popped key to 0 (O(log C)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Returns the length of the heap (O(1)).
+	 * @return The number of entries in the heap.
+	 */
+	int length() const { return len; }
+
+	/**
+	 * @brief Checks if the heap is empty (O(1)).
+	 * @return True if the heap is empty, false otherwise.
+	 */
+	bool isEmpty() const { return len == 0; }
+};
+
+
+template <class Key, class Value>
+int RadixHeap<Key, Value>::lowest() const {
+	int idx = 0;
+	while (buckets[idx].isEmpty()) {
+		idx++;
+	}
+	return idx;
+}
+
+template <class Key, class Value>
+Key RadixHeap<Key, Value>::minKey(int idx) const {
+	const Vector<Entry>& source = buckets[idx];
+	Key min_key = source[0].key;
+	for (int i = 1; i < source.length(); i++) {
+		if (source[i].key < min_key) {
+			min_key = source[i].key;
+		}
+	}
+	return min_key;
+}
+
+template <class Key, class Value>
+void RadixHeap<Key, Value>::refill() {
+	int idx = lowest();
+	Vector<Entry>& source = buckets[idx];
+	Key min_key = minKey(idx);
+
+	// Every entry shares the bits above idx with the new minimum, so each lands in a lower bucket
+	last = min_key;
+	for (int i = 0; i < source.length(); i++) {
+		buckets[bucket(source[i].key)].push(source[i]);
+	}
+	// The bucket keeps its capacity, so steady pops do not reallocate it on every refill
+	source.truncate(0);
+}
+
+template <class Key, class Value>
+void RadixHeap<Key, Value>::push(Key key, Value value) {
+	if (key < last) {
+		throw std::invalid_argument("Key " + std::to_string(key) + " is smaller than the last popped key");
+	}
+	buckets[bucket(key)].push({key, value});
+	len++;
+}
+
+template <class Key, class Value>
+std::pair<Key, Value> RadixHeap<Key, Value>::pop() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty radix heap");
+	}
+	if (buckets[0].isEmpty()) {
+		refill();
+	}
+	Entry entry = buckets[0].pop();
+	len--;
+	return {entry.key, entry.value};
+}
+
+template <class Key, class Value>
+Key RadixHeap<Key, Value>::peekKey() const {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot peek an empty radix heap");
+	}
+	// Keys in a bucket are all smaller than those in any higher bucket, and bucket 0 holds only the last popped key
+	int idx = lowest();
+	return idx == 0 ? last : minKey(idx);
+}
+
+template <class Key, class Value>
+void RadixHeap<Key, Value>::clear() {
+	for (int i = 0; i < BUCKETS; i++) {
+		if (!buckets[i].isEmpty()) {
+			buckets[i].clear();
+		}
+	}
+	last = 0;
+	len = 0;
+}
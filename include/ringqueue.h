@@ -0,0 +1,326 @@
+/**
+ * @file ringqueue.h
+ * @brief Queue implementation using a power-of-two circular buffer.
+ *
+ * This class implements a queue over contiguous storage, so push and pop never allocate
+ * once the buffer is large enough and consecutive elements share cache lines. The
+ * capacity is always a power of two, which lets indices wrap with a mask instead of a
+ * division.
+ *
+ * @tparam T The data type stored in the queue.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+/**
+ * @class RingQueue
+ * @brief A queue implemented using a growable circular buffer.
+ *
+ * @tparam T The data type stored in the queue.
+ */
+template <class T>
+class RingQueue {
+private:
+	T* s_array;
+	int head;
+	int len;
+	int cap;
+
+	// Rate of dynamic resizing for growth operations
+	static const int GROWTH_FACTOR = 2;
+	// The minimum capacity of the circular buffer
+	static const int MIN_CAPACITY = 1;
+	// The maximum capacity of the circular buffer, the largest power of two an int holds
+	static const int MAX_CAPACITY = 1 << 30;
+
+	/**
+	 * @brief Rounds a capacity up to the next power of two.
+	 * @param size The requested capacity.
+	 * @return The smallest power of two no less than size.
+	 * @throws std::length_error If size is greater than MAX_CAPACITY.
+	 */
+	static int roundUp(int size);
+
+	/**
+	 * @brief Copies a run of elements that may be split across two separate ranges.
+	 * @param dst The destination array.
+	 * @param src The source array.
+	 * @param size The number of elements to copy.
+	 */
+	static void copy(T* dst, const T* src, int size);
+
+	/**
+	 * @brief Moves the elements into a new buffer of a given capacity, unwrapping them to start at index 0.
+	 * @param size The new capacity, which must be a power of two no less than the length.
+	 */
+	void resize(int size);
+
+	/**
+	 * @brief Returns the physical index of a logical position in the queue.
+	 * @param idx The logical position, counted from the front.
+	 * @return The index into the circular buffer.
+	 */
+	int wrap(int idx) const { return (head + idx) & (cap - 1); }
+
+public:
+	/**
+	 * @brief Constructs an empty queue with a capacity of 1 by default (O(1)).
+	 * @param size The initial capacity, rounded up to a power of two.
+	 * @throws std::length_error If size is greater than MAX_CAPACITY.
+	 */
+	RingQueue(int size = MIN_CAPACITY) : s_array(nullptr), head(0), len(0), cap(roundUp(size)) { s_array = new T[cap]; }
+
+	/**
+	 * @brief Constructs a queue with elements from an array (O(n)).
+	 * @param data The array of data to push into the queue.
+	 * @param size The size of the array.
+	 */
+	RingQueue(T data[], int size) : RingQueue(size) { pushMany(data, size); }
+
+	RingQueue(const RingQueue&) = delete;
+	RingQueue& operator=(const RingQueue&) = delete;
+
+	/**
+	 * @brief Destroys the queue and frees all allocated memory (O(1)).
+	 */
+	~RingQueue() { delete[] s_array; }
+
+	/**
+	 * @brief Adds an element to the back of the queue (amortized O(1)).
+	 * @param data The data to push into the queue.
+	 * @throws std::length_error If the queue already holds MAX_CAPACITY elements.
+	 */
+	void push(T data);
+
+	/**
+	 * @brief Adds an array of elements to the back of the queue using at most two block copies (O(k)).
+	 * @param data The array of data to push into the queue.
+	 * @param size The size of the array, of which nothing is pushed if it is not positive.
+	 * @throws std::length_error If the queue would hold more than MAX_CAPACITY elements.
+	 */
+	void pushMany(const T data[], int size);
+
+	/**
+	 * @brief Grows the buffer so that it can hold at least a given number of elements without reallocating (O(n)).
+	 * @param size The number of elements to reserve space for.
+	 * @throws std::length_error If size is greater than MAX_CAPACITY.
+	 */
+	void reserve(int size);
+
+	/**
+	 * @brief Clears the queue and resets its capacity (O(1)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Displays the queue (O(n)).
+	 */
+	void show() const;
+
+	/**
+	 * @brief Displays the circular buffer, marking the head and the slots currently in use (O(n)).
+	 */
+	void debug() const;
+
+	/**
+	 * @brief Returns the length of the queue (O(1)).
+	 * @return The length of the queue.
+	 */
+	int length() const { return len; }
+
+	/**
+	 * @brief Returns the number of elements the queue can hold before it must grow (O(1)).
+	 * @return The capacity of the circular buffer.
+	 */
+	int capacity() const { return cap; }
+
+	/**
+	 * @brief Removes up to a given number of elements from the front of the queue into an array using at most two block copies (O(k)).
+	 * @param out The array to copy the elements into.
+	 * @param max The maximum number of elements to remove.
+	 * @return The number of elements removed.
+	 */
+	int popMany(T out[], int max);
+
+	/**
+	 * @brief Checks if the queue is empty (O(1)).
+	 * @return True if the queue is empty, false otherwise.
+	 */
+	bool isEmpty() const { return len == 0; }
+
+	/**
+	 * @brief Checks if the queue contains a specific value (O(n)).
+	 * @param data The value to check for.
+	 * @return True if the value is present, false otherwise.
+	 */
+	bool contains(T data) const;
+
+	/**
+	 * @brief Returns the element at a specific position from the front of the queue (O(1)).
+	 * @param idx The position to get the element from.
+	 * @return The element at the position.
+	 * @throws std::out_of_range If the index is out of bounds.
+	 */
+	T get(int idx) const;
+
+	/**
+	 * @brief Removes an element from the front of the queue (O(1)).
+	 * @return The data removed from the queue.
+	 * @throws std::runtime_error If the queue is empty.
+	 */
+	T pop();
+
+	/**
+	 * @brief Returns the element at the front of the queue without removing it (O(1)).
+	 * @return The data at the front of the queue.
+	 * @throws std::runtime_error If the queue is empty.
+	 */
+	T peek() const { if (isEmpty()) throw std::runtime_error("Cannot peek an empty queue"); return s_array[head]; }
+};
+
+
+template <class T>
+int RingQueue<T>::roundUp(int size) {
+	if (size > MAX_CAPACITY) {
+		throw std::length_error("Capacity " + std::to_string(size) + " exceeds the maximum of " + std::to_string(MAX_CAPACITY));
+	}
+	int result = MIN_CAPACITY;
+	while (result < size) {
+		result *= GROWTH_FACTOR;
+	}
+	return result;
+}
+
+template <class T>
+void RingQueue<T>::copy(T* dst, const T* src, int size) {
+	if constexpr (std::is_trivially_copyable_v<T>) {
+		if (size > 0) {
+			std::memcpy(dst, src, size * sizeof(T));
+		}
+	} else {
+		std::copy(src, src + size, dst);
+	}
+}
+
+template <class T>
+void RingQueue<T>::resize(int size) {
+	T* new_array = new T[size];
+	int first = std::min(len, cap - head);
+	copy(new_array, s_array + head, first);
+	copy(new_array + first, s_array, len - first);
+	delete[] s_array;
+	s_array = new_array;
+	head = 0;
+	cap = size;
+}
+
+template <class T>
+void RingQueue<T>::push(T data) {
+	if (len == cap) {
+		resize(roundUp(cap + 1));
+	}
+	s_array[wrap(len)] = data;
+	len++;
+}
+
+template <class T>
+void RingQueue<T>::pushMany(const T data[], int size) {
+	if (size <= 0) {
+		return;
+	}
+	if (size > MAX_CAPACITY - len) {
+		throw std::length_error("Cannot grow a queue past " + std::to_string(MAX_CAPACITY) + " elements");
+	}
+	reserve(len + size);
+	int tail = wrap(len);
+	int first = std::min(size, cap - tail);
+	copy(s_array + tail, data, first);
+	copy(s_array, data + first, size - first);
+	len += size;
+}
+
+template <class T>
+void RingQueue<T>::reserve(int size) {
+	if (size > cap) {
+		resize(roundUp(size));
+	}
+}
+
+template <class T>
+void RingQueue<T>::clear() {
+	delete[] s_array;
+	head = len = 0;
+	cap = MIN_CAPACITY;
+	s_array = new T[cap];
+}
+
+template <class T>
+void RingQueue<T>::show() const {
+	for (int i = 0; i < len; i++) {
+		if (i != 0) {
+			std::cout << ", ";
+		}
+		std::cout << s_array[wrap(i)];
+	}
+	std::cout << std::endl;
+}
+
+template <class T>
+void RingQueue<T>::debug() const {
+	for (int i = 0; i < cap; i++) {
+		int pos = (i - head) & (cap - 1);
+		std::cout << (i == head ? ">" : "") << "|";
+		if (pos < len) {
+			std::cout << s_array[i] << ": " << &s_array[i];
+		}
+		std::cout << "|" << " ";
+	}
+	std::cout << std::endl;
+}
+
+template <class T>
+int RingQueue<T>::popMany(T out[], int max) {
+	int count = std::min(std::max(max, 0), len);
+	int first = std::min(count, cap - head);
+	copy(out, s_array + head, first);
+	copy(out + first, s_array, count - first);
+	head = wrap(count);
+	len -= count;
+	return count;
+}
+
+template <class T>
+bool RingQueue<T>::contains(T data) const {
+	for (int i = 0; i < len; i++) {
+		if (s_array[wrap(i)] == data) {
+			return true;
+		}
+	}
+	return false;
+}
+
+template <class T>
+T RingQueue<T>::get(int idx) const {
+	if (idx >= len || idx < 0) {
+		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
+	}
+	return s_array[wrap(idx)];
+}
+
+template <class T>
+T RingQueue<T>::pop() {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot pop from an empty queue");
+	}
+	T data = s_array[head];
+	head = wrap(1);
+	len--;
+	return data;
+}
@@ -0,0 +1,349 @@
+/**
+ * @file runningquantile.h
+ * @brief Streaming quantile tracker implementation using a max-heap and a min-heap.
+ *
+ * This class keeps the samples at or below the tracked quantile in a max-PQueue and the
+ * rest in a min-PQueue, rebalancing after each sample so that the lower heap holds exactly
+ * the nearest-rank count. The quantile is then the top of the lower heap, read in O(1).
+ *
+ * Samples can also be retired: in sliding-window mode the oldest sample expires as each new
+ * one arrives, and in approximate mode a reservoir of fixed size holds a uniform random
+ * sample of the whole stream, so memory stays bounded however long the stream runs. Retired
+ * samples are not searched for; each heap entry carries the sequence number and slot of its
+ * sample, so a retired entry is recognized and discarded lazily once it reaches the top of its
+ * heap. Since every entry in the lower heap orders before every entry in the upper heap, the
+ * side a retired sample was on is known from a single comparison with the lower top.
+ *
+ * @tparam T The data type of the samples.
+ * @tparam Compare The strict weak ordering on samples.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <cstdint>
+#include <functional>
+#include "pqueue.h"
+#include "vector.h"
+
+/**
+ * @class RunningQuantile
+ * @brief Tracks a quantile of a stream, or of its most recent samples, in O(log n) per sample.
+ *
+ * @tparam T The data type of the samples.
+ * @tparam Compare The strict weak ordering on samples.
+ */
+template <class T, class Compare = std::less<>>
+class RunningQuantile {
+private:
+	// Number of heap entries per live sample tolerated before the heaps are rebuilt without retired ones
+	static const int COMPACT_RATIO = 2;
+
+	/**
+	 * @struct Entry
+	 * @brief A sample, its sequence number and the slot it occupies when samples can be retired.
+	 */
+	struct Entry {
+		T value;
+		std::uint64_t seq;
+		int slot;
+	};
+
+	/**
+	 * @struct Ordering
+	 * @brief Orders entries by value, then by sequence number, so that no two entries tie.
+	 */
+	struct Ordering {
+		Compare comp;
+
+		bool operator()(const Entry& entry_1, const Entry& entry_2) const;
+	};
+
+	double q;
+	int window;
+	int reservoir;
+	Ordering order;
+	PQueue<Entry, Ordering> lower;
+	PQueue<Entry, Ordering> upper;
+	Vector<Entry> slots;
+	int lower_live;
+	int upper_live;
+	std::uint64_t seen;
+	std::uint64_t seed;
+
+	/**
+	 * @brief Checks if an entry's sample has not been retired.
+	 * @param entry The entry.
+	 * @return True if the sample still counts towards the quantile, false otherwise.
+	 */
+	bool live(const Entry& entry) const { return window == 0 && reservoir == 0 ? true : slots[entry.slot].seq == entry.seq; }
+
+	/**
+	 * @brief Returns the number of live samples the lower heap must hold.
+	 * @param n The number of live samples.
+	 * @return The nearest-rank position of the quantile among n samples.
+	 */
+	int target(int n) const { return n == 0 ? 0 : static_cast<int>(q * (n - 1)) + 1; }
+
+	/**
+	 * @brief Pops retired entries off the top of both heaps.
+	 */
+	void prune();
+
+	/**
+	 * @brief Inserts an entry on its side of the quantile and rebalances the heaps.
+	 * @param entry The entry to insert.
+	 */
+	void insert(const Entry& entry);
+
+	/**
+	 * @brief Uncounts the sample in a slot, which must be live, before it is overwritten.
+	 * @param slot The slot of the sample.
+	 */
+	void retire(int slot);
+
+	/**
+	 * @brief Moves live tops between the heaps until the lower heap holds the target count.
+	 */
+	void rebalance();
+
+	/**
+	 * @brief Rebuilds both heaps from the live samples once retired entries dominate them (O(n log(n))).
+	 */
+	void compact();
+
+	/**
+	 * @brief Returns the next value of the reservoir's xorshift generator.
+	 * @return A pseudo-random 64-bit value.
+	 */
+	std::uint64_t random();
+
+public:
+	/**
+	 * @brief Constructs an empty tracker (O(1)).
+	 * @param q The quantile to track, from 0 (minimum) to 1 (maximum).
+	 * @param window The number of most recent samples to track, or 0 for every sample.
+	 * @param reservoir The number of samples kept to approximate the quantile of the whole stream, or 0 to keep every sample.
+	 * @param comp The comparator to order samples with.
+	 * @throws std::invalid_argument If q is outside [0, 1], window or reservoir is negative, or both are set.
+	 */
+	RunningQuantile(double q = 0.5, int window = 0, int reservoir = 0, Compare comp = Compare());
+
+	RunningQuantile(const RunningQuantile&) = delete;
+	RunningQuantile& operator=(const RunningQuantile&) = delete;
+
+	/**
+	 * @brief Adds a sample, expiring the oldest in window mode (amortized O(log(n))).
+	 * @param value The sample.
+	 */
+	void push(T value);
+
+	/**
+	 * @brief Returns the tracked quantile of the live samples, by nearest rank (O(1)).
+	 * @return The live sample at position floor(q * (n - 1)) in sorted order.
+	 * @throws std::runtime_error If there are no live samples.
+	 */
+	T quantile() const;
+
+	/**
+	 * @brief Removes every sample (O(n)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Returns the number of samples the quantile is computed over (O(1)).
+	 * @return The number of live samples.
+	 */
+	int length() const { return lower_live + upper_live; }
+
+	/**
+	 * @brief Returns the number of samples pushed since construction or the last clear (O(1)).
+	 * @return The number of samples seen.
+	 */
+	std::uint64_t count() const { return seen; }
+
+	/**
+	 * @brief Checks if there are no live samples (O(1)).
+	 * @return True if the tracker is empty, false otherwise.
+	 */
+	bool isEmpty() const { return length() == 0; }
+
+	/**
+	 * @brief Returns the tracked quantile fraction (O(1)).
+	 * @return The value of q.
+	 */
+	double fraction() const { return q; }
+
+	/**
+	 * @brief Returns the size of the sliding window (O(1)).
+	 * @return The window size, or 0 if every sample is tracked.
+	 */
+	int windowSize() const { return window; }
+
+	/**
+	 * @brief Returns the size of the reservoir (O(1)).
+	 * @return The reservoir size, or 0 if the quantile is exact.
+	 */
+	int reservoirSize() const { return reservoir; }
+
+	/**
+	 * @brief Checks if the quantile is estimated from a reservoir sample (O(1)).
+	 * @return True if the tracker is in approximate mode, false otherwise.
+	 */
+	bool isApproximate() const { return reservoir > 0; }
+};
+
+
+template <class T, class Compare>
+bool RunningQuantile<T, Compare>::Ordering::operator()(const Entry& entry_1, const Entry& entry_2) const {
+	if (comp(entry_1.value, entry_2.value)) {
+		return true;
+	}
+	if (comp(entry_2.value, entry_1.value)) {
+		return false;
+	}
+	return entry_1.seq < entry_2.seq;
+}
+
+template <class T, class Compare>
+RunningQuantile<T, Compare>::RunningQuantile(double q, int window, int reservoir, Compare comp) : q(q), window(window), reservoir(reservoir), order{comp}, lower(true, order), upper(false, order), lower_live(0), upper_live(0), seen(0), seed(0x9E3779B97F4A7C15ull) {
+	if (!(q >= 0 && q <= 1)) {
+		throw std::invalid_argument("Quantile must be between 0 and 1");
+	}
+	if (window < 0 || reservoir < 0) {
+		throw std::invalid_argument("Window and reservoir sizes must not be negative");
+	}
+	if (window > 0 && reservoir > 0) {
+		throw std::invalid_argument("A tracker cannot have both a window and a reservoir");
+	}
+	if (window + reservoir > 0) {
+		slots.reserve(window + reservoir);
+	}
+}
+
+template <class T, class Compare>
+std::uint64_t RunningQuantile<T, Compare>::random() {
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+template <class T, class Compare>
+void RunningQuantile<T, Compare>::prune() {
+	while (!lower.isEmpty() && !live(lower.peek())) {
+		lower.pop();
+	}
+	while (!upper.isEmpty() && !live(upper.peek())) {
+		upper.pop();
+	}
+}
+
+template <class T, class Compare>
+void RunningQuantile<T, Compare>::rebalance() {
+	int goal = target(length());
+	while (lower_live > goal) {
+		upper.push(lower.pop());
+		lower_live--;
+		upper_live++;
+		prune();
+	}
+	while (lower_live < goal) {
+		lower.push(upper.pop());
+		upper_live--;
+		lower_live++;
+		prune();
+	}
+}
+
+template <class T, class Compare>
+void RunningQuantile<T, Compare>::insert(const Entry& entry) {
+	// Both tops are live here, so the lower top bounds every live entry below the quantile
+	if (!lower.isEmpty() && !order(lower.peek(), entry)) {
+		lower.push(entry);
+		lower_live++;
+	} else {
+		upper.push(entry);
+		upper_live++;
+	}
+	rebalance();
+}
+
+template <class T, class Compare>
+void RunningQuantile<T, Compare>::retire(int slot) {
+	if (!lower.isEmpty() && !order(lower.peek(), slots[slot])) {
+		lower_live--;
+	} else {
+		upper_live--;
+	}
+	// Invalidating the slot's sequence number marks its heap entry as retired
+	slots[slot].seq = ~0ull;
+	prune();
+}
+
+template <class T, class Compare>
+void RunningQuantile<T, Compare>::compact() {
+	lower.clear();
+	upper.clear();
+	// Every slot holds a live sample, since a retired one is overwritten straight away
+	Vector<Entry> entries(slots.length());
+	for (int i = 0; i < slots.length(); i++) {
+		entries.push(slots[i]);
+	}
+	upper.pushMany(&entries[0], entries.length());
+	lower_live = 0;
+	upper_live = entries.length();
+	rebalance();
+}
+
+template <class T, class Compare>
+void RunningQuantile<T, Compare>::push(T value) {
+	std::uint64_t seq = seen++;
+	if (window == 0 && reservoir == 0) {
+		insert({value, seq, 0});
+		return;
+	}
+
+	int slot;
+	if (slots.length() < window + reservoir) {
+		slot = slots.length();
+		slots.push({value, seq, slot});
+	} else {
+		if (window > 0) {
+			slot = static_cast<int>(seq % static_cast<std::uint64_t>(window));
+		} else {
+			// Keep the new sample with probability reservoir / seen, in place of a random one
+			std::uint64_t pick = random() % seen;
+			if (pick >= static_cast<std::uint64_t>(reservoir)) {
+				return;
+			}
+			slot = static_cast<int>(pick);
+		}
+		retire(slot);
+		slots[slot] = {value, seq, slot};
+	}
+	insert(slots[slot]);
+
+	if (lower.length() + upper.length() > COMPACT_RATIO * length()) {
+		compact();
+	}
+}
+
+template <class T, class Compare>
+T RunningQuantile<T, Compare>::quantile() const {
+	if (isEmpty()) {
+		throw std::runtime_error("Cannot take the quantile of an empty tracker");
+	}
+	return lower.peek().value;
+}
+
+template <class T, class Compare>
+void RunningQuantile<T, Compare>::clear() {
+	lower.clear();
+	upper.clear();
+	slots.clear();
+	lower_live = 0;
+	upper_live = 0;
+	seen = 0;
+}
@@ -0,0 +1,366 @@
+/**
+ * @file scheduledexecutor.h
+ * @brief Delayed and periodic task executor using a priority queue and a thread pool.
+ *
+ * This class keeps scheduled tasks in a stable priority queue ordered by deadline, so
+ * tasks due at the same instant run in the order they were scheduled. A single timer
+ * thread sleeps until the earliest deadline plus a configurable tolerance, then takes
+ * every task whose deadline has passed, so timers that are close together share one
+ * wakeup. A task may run up to the tolerance late, but never before its deadline. The
+ * due tasks are handed to a thread pool in batches, amortizing the cost of each
+ * submission. Cancelled tasks are skipped lazily and purged once they make up half the
+ * queue.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "stablepqueue.h"
+#include "threadpool.h"
+#include "vector.h"
+
+/**
+ * @class ScheduledExecutor
+ * @brief Runs tasks on a thread pool after a delay or at a fixed rate.
+ *
+ * Exceptions thrown by tasks are discarded. Runs of a fixed-rate task may overlap if a
+ * run takes longer than the period.
+ */
+class ScheduledExecutor {
+public:
+	typedef std::chrono::steady_clock Clock;
+
+private:
+	// Number of due tasks handed to the pool as a single submission
+	static const int BATCH_SIZE = 16;
+
+	/**
+	 * @struct Task
+	 * @brief A scheduled function, shared between the queue and any handles to it.
+	 */
+	struct Task {
+		std::function<void()> fn;
+		Clock::duration period;
+		std::atomic<int> state;
+	};
+
+	// Task states: still to run (or periodic), handed to the pool for its only run, or cancelled
+	static const int PENDING = 0;
+	static const int DISPATCHED = 1;
+	static const int CANCELLED = 2;
+
+	/**
+	 * @struct Entry
+	 * @brief A task and the deadline of its next run.
+	 */
+	struct Entry {
+		Clock::time_point deadline;
+		std::shared_ptr<Task> task;
+	};
+
+	ThreadPool& pool;
+	Clock::duration slack;
+
+	StablePQueue<Entry, std::less<>, Clock::time_point Entry::*> queue;
+	int n_cancelled;
+	bool stopping;
+	std::uint64_t n_wakeups;
+
+	mutable std::mutex mutex;
+	std::condition_variable wake;
+	std::thread timer;
+
+	/**
+	 * @brief Runs the timer thread until the executor stops.
+	 */
+	void timerLoop();
+
+	/**
+	 * @brief Adds a task to the queue, waking the timer thread if it is now the earliest.
+	 * @param fn The function to run.
+	 * @param deadline The time of the first run.
+	 * @param period The time between runs, or zero for a one-shot task.
+	 * @return A handle to the task.
+	 */
+	std::shared_ptr<Task> enqueue(std::function<void()> fn, Clock::time_point deadline, Clock::duration period);
+
+	/**
+	 * @brief Takes every task due by a limit off the queue, rescheduling periodic ones. Requires the lock.
+	 * @param limit The latest deadline to take.
+	 * @param batch The vector to append the due tasks to.
+	 */
+	void collect(Clock::time_point limit, Vector<std::shared_ptr<Task>>& batch);
+
+	/**
+	 * @brief Submits due tasks to the pool in batches of BATCH_SIZE.
+	 * @param due The due tasks.
+	 */
+	void dispatch(Vector<std::shared_ptr<Task>>& due);
+
+	/**
+	 * @brief Rebuilds the queue without its cancelled entries. Requires the lock.
+	 */
+	void purge();
+
+public:
+	/**
+	 * @class Handle
+	 * @brief Identifies a scheduled task for cancellation.
+	 */
+	class Handle {
+		friend class ScheduledExecutor;
+
+		std::shared_ptr<Task> task;
+
+	public:
+		Handle() {}
+	};
+
+	/**
+	 * @brief Constructs an executor and starts its timer thread.
+	 * @param pool The pool to run tasks on, which must outlive the executor.
+	 * @param tolerance How far past its deadline a task may be held back to share a wakeup with later ones.
+	 * @throws std::invalid_argument If the tolerance is negative.
+	 */
+	ScheduledExecutor(ThreadPool& pool, Clock::duration tolerance = std::chrono::microseconds(100));
+
+	ScheduledExecutor(const ScheduledExecutor&) = delete;
+	ScheduledExecutor& operator=(const ScheduledExecutor&) = delete;
+
+	/**
+	 * @brief Stops the timer thread, dropping every task that has not been dispatched.
+	 */
+	~ScheduledExecutor();
+
+	/**
+	 * @brief Schedules a task to run once after a delay (O(log(n))).
+	 * @param fn The function to run.
+	 * @param delay The time to wait before running it.
+	 * @return A handle for cancelling the task.
+	 */
+	template <class Rep, class Period>
+	Handle schedule(std::function<void()> fn, const std::chrono::duration<Rep, Period>& delay);
+
+	/**
+	 * @brief Schedules a task to run once at a given time (O(log(n))).
+	 * @param fn The function to run.
+	 * @param deadline The time to run it at.
+	 * @return A handle for cancelling the task.
+	 */
+	Handle scheduleAt(std::function<void()> fn, Clock::time_point deadline);
+
+	/**
+	 * @brief Schedules a task to run repeatedly, with each run due one period after the previous one was due (O(log(n))).
+	 * @param fn The function to run.
+	 * @param initial_delay The time to wait before the first run.
+	 * @param period The time between the deadlines of consecutive runs.
+	 * @return A handle for cancelling the task.
+	 * @throws std::invalid_argument If the period is not positive.
+	 */
+	template <class Rep1, class Period1, class Rep2, class Period2>
+	Handle scheduleAtFixedRate(std::function<void()> fn, const std::chrono::duration<Rep1, Period1>& initial_delay, const std::chrono::duration<Rep2, Period2>& period);
+
+	/**
+	 * @brief Cancels a task, stopping any runs that have not yet been dispatched (amortized O(1)).
+	 * @param handle The handle of the task.
+	 * @return True if the task was cancelled, false if it had already been dispatched or cancelled.
+	 */
+	bool cancel(const Handle& handle);
+
+	/**
+	 * @brief Returns the number of scheduled tasks that have not been dispatched or cancelled (O(1)).
+	 * @return The number of pending tasks.
+	 */
+	int pending() const;
+
+	/**
+	 * @brief Returns the number of times the timer thread has woken to dispatch tasks (O(1)).
+	 * @return The number of dispatching wakeups.
+	 */
+	std::uint64_t wakeups() const;
+
+	/**
+	 * @brief Returns how far past its deadline a task may be held back (O(1)).
+	 * @return The coalescing tolerance.
+	 */
+	Clock::duration tolerance() const { return slack; }
+};
+
+
+inline ScheduledExecutor::ScheduledExecutor(ThreadPool& pool, Clock::duration tolerance) : pool(pool), slack(tolerance), queue(false, std::less<>(), &Entry::deadline), n_cancelled(0), stopping(false), n_wakeups(0) {
+	if (tolerance < Clock::duration::zero()) {
+		throw std::invalid_argument("Tolerance must not be negative");
+	}
+	timer = std::thread(&ScheduledExecutor::timerLoop, this);
+}
+
+inline ScheduledExecutor::~ScheduledExecutor() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_one();
+	timer.join();
+}
+
+inline std::shared_ptr<ScheduledExecutor::Task> ScheduledExecutor::enqueue(std::function<void()> fn, Clock::time_point deadline, Clock::duration period) {
+	std::shared_ptr<Task> task = std::make_shared<Task>();
+	task->fn = std::move(fn);
+	task->period = period;
+	task->state.store(PENDING, std::memory_order_relaxed);
+
+	bool earliest;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		earliest = queue.isEmpty() || deadline < queue.peek().deadline;
+		queue.push({deadline, task});
+	}
+	// The timer thread only needs waking if it is sleeping towards a later deadline
+	if (earliest) {
+		wake.notify_one();
+	}
+	return task;
+}
+
+inline ScheduledExecutor::Handle ScheduledExecutor::scheduleAt(std::function<void()> fn, Clock::time_point deadline) {
+	Handle handle;
+	handle.task = enqueue(std::move(fn), deadline, Clock::duration::zero());
+	return handle;
+}
+
+template <class Rep, class Period>
+ScheduledExecutor::Handle ScheduledExecutor::schedule(std::function<void()> fn, const std::chrono::duration<Rep, Period>& delay) {
+	return scheduleAt(std::move(fn), Clock::now() + std::chrono::duration_cast<Clock::duration>(delay));
+}
+
+template <class Rep1, class Period1, class Rep2, class Period2>
+ScheduledExecutor::Handle ScheduledExecutor::scheduleAtFixedRate(std::function<void()> fn, const std::chrono::duration<Rep1, Period1>& initial_delay, const std::chrono::duration<Rep2, Period2>& period) {
+	Clock::duration step = std::chrono::duration_cast<Clock::duration>(period);
+	if (step <= Clock::duration::zero()) {
+		throw std::invalid_argument("Period must be positive");
+	}
+	Handle handle;
+	handle.task = enqueue(std::move(fn), Clock::now() + std::chrono::duration_cast<Clock::duration>(initial_delay), step);
+	return handle;
+}
+
+inline bool ScheduledExecutor::cancel(const Handle& handle) {
+	if (!handle.task) {
+		return false;
+	}
+	int expected = PENDING;
+	if (!handle.task->state.compare_exchange_strong(expected, CANCELLED, std::memory_order_acq_rel)) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	n_cancelled++;
+	if (n_cancelled * 2 > queue.length()) {
+		purge();
+	}
+	return true;
+}
+
+inline int ScheduledExecutor::pending() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return queue.length() - n_cancelled;
+}
+
+inline std::uint64_t ScheduledExecutor::wakeups() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return n_wakeups;
+}
+
+inline void ScheduledExecutor::purge() {
+	Vector<Entry> live;
+	while (!queue.isEmpty()) {
+		Entry entry = queue.pop();
+		if (entry.task->state.load(std::memory_order_acquire) != CANCELLED) {
+			live.push(entry);
+		}
+	}
+	// Entries come out in deadline order, so pushing them back keeps ties in their original order
+	for (int i = 0; i < live.length(); i++) {
+		queue.push(live[i]);
+	}
+	n_cancelled = 0;
+}
+
+inline void ScheduledExecutor::collect(Clock::time_point limit, Vector<std::shared_ptr<Task>>& batch) {
+	while (!queue.isEmpty() && queue.peek().deadline <= limit) {
+		Entry entry = queue.pop();
+		Task& task = *entry.task;
+		if (task.state.load(std::memory_order_acquire) == CANCELLED) {
+			n_cancelled--;
+			continue;
+		}
+		if (task.period == Clock::duration::zero()) {
+			int expected = PENDING;
+			if (!task.state.compare_exchange_strong(expected, DISPATCHED, std::memory_order_acq_rel)) {
+				// Cancelled since the check above, and counted by cancel
+				n_cancelled--;
+				continue;
+			}
+		} else {
+			queue.push({entry.deadline + task.period, entry.task});
+		}
+		batch.push(entry.task);
+	}
+}
+
+inline void ScheduledExecutor::dispatch(Vector<std::shared_ptr<Task>>& due) {
+	for (int start = 0; start < due.length(); start += BATCH_SIZE) {
+		Vector<std::shared_ptr<Task>>* chunk = new Vector<std::shared_ptr<Task>>(BATCH_SIZE);
+		for (int i = start; i < start + BATCH_SIZE && i < due.length(); i++) {
+			chunk->push(due[i]);
+		}
+		pool.submit([chunk]() {
+			for (int i = 0; i < chunk->length(); i++) {
+				Task& task = *(*chunk)[i];
+				// A periodic task cancelled after it was collected skips its remaining runs
+				if (task.state.load(std::memory_order_acquire) == CANCELLED) {
+					continue;
+				}
+				try {
+					task.fn();
+				} catch (...) {
+				}
+			}
+			delete chunk;
+		});
+	}
+}
+
+inline void ScheduledExecutor::timerLoop() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (!stopping) {
+		if (queue.isEmpty()) {
+			wake.wait(lock);
+			continue;
+		}
+		// Waking at the end of the earliest task's tolerance lets every task due by then share the wakeup
+		Clock::time_point deadline = queue.peek().deadline;
+		Clock::time_point wakeup = deadline > Clock::time_point::max() - slack ? Clock::time_point::max() : deadline + slack;
+		Clock::time_point now = Clock::now();
+		if (now < wakeup) {
+			wake.wait_until(lock, wakeup);
+			continue;
+		}
+
+		Vector<std::shared_ptr<Task>> due;
+		collect(now, due);
+		n_wakeups++;
+		lock.unlock();
+		dispatch(due);
+		lock.lock();
+	}
+}
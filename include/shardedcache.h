@@ -0,0 +1,272 @@
+/**
+ * @file shardedcache.h
+ * @brief Thread-safe cache implementation splitting keys over independently locked caches.
+ *
+ * This class wraps a number of single-threaded caches, such as LRUCache or ClockCache, each
+ * behind its own mutex on its own cache line, and routes every key to one of them by the top
+ * bits of its hash. Threads working on different shards never contend, so throughput grows
+ * with the number of shards instead of serializing on one lock. Each shard holds an equal
+ * share of the capacity and evicts on its own, so recency is tracked per shard rather than
+ * across the whole cache.
+ *
+ * @tparam Cache The cache type of each shard, such as LRUCache<K, V> or ClockCache<K, V>.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class ShardedCache
+ * @brief A bounded map for concurrent use, made of independently locked caches.
+ *
+ * Values are copied out under the shard's lock, so no reference into a shard escapes it.
+ * The eviction callback runs while its shard is locked.
+ *
+ * @tparam Cache The cache type of each shard, such as LRUCache<K, V> or ClockCache<K, V>.
+ */
+template <class Cache>
+class ShardedCache {
+public:
+	typedef typename Cache::KeyType K;
+	typedef typename Cache::ValueType V;
+	typedef typename Cache::Hasher Hash;
+	typedef typename Cache::KeyEquality KeyEqual;
+	typedef typename Cache::Weigher Weigher;
+	typedef typename Cache::Evictor Evictor;
+
+private:
+	// Assumed size of a cache line, used to keep shards from false sharing
+	static const std::size_t CACHE_LINE = 64;
+
+	/**
+	 * @struct Shard
+	 * @brief A cache and the mutex guarding it.
+	 */
+	struct alignas(CACHE_LINE) Shard {
+		std::mutex lock;
+		Cache* cache;
+	};
+
+	Shard* shards;
+	int n_shards;
+	Hash hash;
+
+	/**
+	 * @brief Returns the shard a key belongs to.
+	 * @param key The key.
+	 * @return The shard.
+	 */
+	template <class Q>
+	Shard& shardOf(const Q& key) const;
+
+public:
+	/**
+	 * @brief Constructs an empty cache (O(shards)).
+	 * @param capacity The maximum total weight of the entries, split evenly over the shards.
+	 * @param shards The number of shards, or 0 for four per hardware thread, reduced so every shard has a capacity of at least 1.
+	 * @param weigh The function giving the weight of an entry, or empty to give every entry a weight of 1.
+	 * @param evict The function to call with each entry evicted to make room, or empty for none.
+	 * @param hash The hash function on keys.
+	 * @param equal The equality predicate on keys.
+	 * @throws std::invalid_argument If the capacity is not positive or the number of shards is negative.
+	 */
+	ShardedCache(std::int64_t capacity, int shards = 0, Weigher weigh = Weigher(), Evictor evict = Evictor(), Hash hash = Hash(), KeyEqual equal = KeyEqual());
+
+	ShardedCache(const ShardedCache&) = delete;
+	ShardedCache& operator=(const ShardedCache&) = delete;
+
+	/**
+	 * @brief Destroys the cache and frees the associated memory (O(n)).
+	 */
+	~ShardedCache();
+
+	/**
+	 * @brief Copies out the value of a key, marking the entry as used (O(1) expected).
+	 * @param key The key to find.
+	 * @param out Receives the value if the key is present.
+	 * @return True if the key is present, false otherwise.
+	 */
+	template <class Q>
+	bool get(const Q& key, V& out);
+
+	/**
+	 * @brief Sets the value of a key, evicting entries of its shard to make room (amortized O(1)).
+	 * @param key The key.
+	 * @param value The value.
+	 * @return True if the key was inserted, false if its value was replaced.
+	 * @throws std::invalid_argument If the entry's weight is negative or exceeds the capacity of a shard.
+	 */
+	bool put(K key, V value);
+
+	/**
+	 * @brief Checks if a key is present, without marking the entry as used (O(1) expected).
+	 * @param key The key to find.
+	 * @return True if the key is present, false otherwise.
+	 */
+	template <class Q>
+	bool contains(const Q& key) const;
+
+	/**
+	 * @brief Removes a key and its value without calling the eviction callback (O(1) expected).
+	 * @param key The key to remove.
+	 * @return True if the key was removed, false if it was not present.
+	 */
+	template <class Q>
+	bool remove(const Q& key);
+
+	/**
+	 * @brief Removes every entry without calling the eviction callback, one shard at a time (O(n)).
+	 */
+	void clear();
+
+	/**
+	 * @brief Returns the number of entries, summed one shard at a time (O(shards)).
+	 * @return The number of entries, exact if no other thread is modifying the cache.
+	 */
+	int length() const;
+
+	/**
+	 * @brief Returns the total weight of the entries, summed one shard at a time (O(shards)).
+	 * @return The weight in use, exact if no other thread is modifying the cache.
+	 */
+	std::int64_t weight() const;
+
+	/**
+	 * @brief Returns the maximum total weight of the entries (O(shards)).
+	 * @return The sum of the shards' capacities.
+	 */
+	std::int64_t capacity() const;
+
+	/**
+	 * @brief Checks if the cache is empty (O(shards)).
+	 * @return True if no shard holds an entry, false otherwise.
+	 */
+	bool isEmpty() const { return length() == 0; }
+
+	/**
+	 * @brief Returns the number of shards (O(1)).
+	 * @return The number of shards.
+	 */
+	int shardCount() const { return n_shards; }
+};
+
+
+template <class Cache>
+ShardedCache<Cache>::ShardedCache(std::int64_t capacity, int shards, Weigher weigh, Evictor evict, Hash hash, KeyEqual equal) : shards(nullptr), n_shards(0), hash(hash) {
+	if (capacity <= 0) {
+		throw std::invalid_argument("Capacity must be positive");
+	}
+	if (shards < 0) {
+		throw std::invalid_argument("Number of shards must not be negative");
+	}
+	if (shards == 0) {
+		shards = 4 * std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+	if (shards > capacity) {
+		shards = static_cast<int>(capacity);
+	}
+
+	this->shards = new Shard[shards];
+	n_shards = shards;
+	// Spread the remainder so the shards' capacities add up to the requested one
+	for (int i = 0; i < shards; i++) {
+		std::int64_t share = capacity / shards + (i < capacity % shards ? 1 : 0);
+		this->shards[i].cache = new Cache(share, weigh, evict, hash, equal);
+	}
+}
+
+template <class Cache>
+ShardedCache<Cache>::~ShardedCache() {
+	for (int i = 0; i < n_shards; i++) {
+		delete shards[i].cache;
+	}
+	delete[] shards;
+}
+
+template <class Cache>
+template <class Q>
+typename ShardedCache<Cache>::Shard& ShardedCache<Cache>::shardOf(const Q& key) const {
+	// Mix the hash so the shard depends on bits the shard's own table does not start from
+	std::uint64_t h = static_cast<std::uint64_t>(hash(key)) * 0x9E3779B97F4A7C15ull;
+	return shards[static_cast<int>(((h >> 32) * static_cast<std::uint64_t>(n_shards)) >> 32)];
+}
+
+template <class Cache>
+template <class Q>
+bool ShardedCache<Cache>::get(const Q& key, V& out) {
+	Shard& shard = shardOf(key);
+	std::lock_guard<std::mutex> lock(shard.lock);
+	V* value = shard.cache->get(key);
+	if (value == nullptr) {
+		return false;
+	}
+	out = *value;
+	return true;
+}
+
+template <class Cache>
+bool ShardedCache<Cache>::put(K key, V value) {
+	Shard& shard = shardOf(key);
+	std::lock_guard<std::mutex> lock(shard.lock);
+	return shard.cache->put(std::move(key), std::move(value));
+}
+
+template <class Cache>
+template <class Q>
+bool ShardedCache<Cache>::contains(const Q& key) const {
+	Shard& shard = shardOf(key);
+	std::lock_guard<std::mutex> lock(shard.lock);
+	return shard.cache->contains(key);
+}
+
+template <class Cache>
+template <class Q>
+bool ShardedCache<Cache>::remove(const Q& key) {
+	Shard& shard = shardOf(key);
+	std::lock_guard<std::mutex> lock(shard.lock);
+	return shard.cache->remove(key);
+}
+
+template <class Cache>
+void ShardedCache<Cache>::clear() {
+	for (int i = 0; i < n_shards; i++) {
+		std::lock_guard<std::mutex> lock(shards[i].lock);
+		shards[i].cache->clear();
+	}
+}
+
+template <class Cache>
+int ShardedCache<Cache>::length() const {
+	int len = 0;
+	for (int i = 0; i < n_shards; i++) {
+		std::lock_guard<std::mutex> lock(shards[i].lock);
+		len += shards[i].cache->length();
+	}
+	return len;
+}
+
+template <class Cache>
+std::int64_t ShardedCache<Cache>::weight() const {
+	std::int64_t total = 0;
+	for (int i = 0; i < n_shards; i++) {
+		std::lock_guard<std::mutex> lock(shards[i].lock);
+		total += shards[i].cache->weight();
+	}
+	return total;
+}
+
+template <class Cache>
+std::int64_t ShardedCache<Cache>::capacity() const {
+	std::int64_t total = 0;
+	for (int i = 0; i < n_shards; i++) {
+		total += shards[i].cache->capacity();
+	}
+	return total;
+}
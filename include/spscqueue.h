@@ -0,0 +1,230 @@
+/**
+ * @file spscqueue.h
+ * @brief Bounded wait-free single-producer/single-consumer queue.
+ *
+ * This class implements a queue that one producer thread and one consumer thread can use
+ * concurrently without locks. The head and tail indices sit on separate cache lines, and
+ * each side keeps a local copy of the opposite index so that it only touches the other
+ * side's cache line when the queue looks full or empty.
+ *
+ * @tparam T The data type stored in the queue.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class SPSCQueue
+ * @brief A bounded lock-free ring queue for exactly one producer and one consumer thread.
+ *
+ * Only the producer may call tryPush and pushMany, and only the consumer may call
+ * tryPop, popMany and peek. length and isEmpty may be called from either thread and
+ * return a snapshot.
+ *
+ * @tparam T The data type stored in the queue.
+ */
+template <class T>
+class SPSCQueue {
+private:
+	// Assumed size of a cache line, used to keep the two indices from false sharing
+	static const std::size_t CACHE_LINE = 64;
+
+	T* s_array;
+	std::size_t cap;
+	std::size_t mask;
+
+	// Consumer side: next slot to read and the consumer's copy of the tail
+	alignas(CACHE_LINE) std::atomic<std::size_t> head;
+	std::size_t cached_tail;
+
+	// Producer side: next slot to write and the producer's copy of the head
+	alignas(CACHE_LINE) std::atomic<std::size_t> tail;
+	std::size_t cached_head;
+
+	// Keeps the producer's cache line clear of whatever follows the queue in memory
+	char padding[CACHE_LINE - sizeof(std::atomic<std::size_t>) - sizeof(std::size_t)];
+
+	/**
+	 * @brief Rounds a capacity up to the next power of two.
+	 * @param size The requested capacity.
+	 * @return The smallest power of two no less than size.
+	 */
+	static std::size_t roundUp(int size);
+
+public:
+	/**
+	 * @brief Constructs an empty queue with a fixed capacity (O(n)).
+	 * @param size The capacity of the queue, rounded up to a power of two.
+	 * @throws std::invalid_argument If the capacity is not positive.
+	 */
+	SPSCQueue(int size);
+
+	SPSCQueue(const SPSCQueue&) = delete;
+	SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+	/**
+	 * @brief Destroys the queue and frees all allocated memory (O(1)).
+	 */
+	~SPSCQueue() { delete[] s_array; }
+
+	/**
+	 * @brief Adds an element to the back of the queue if there is room (O(1)). Producer only.
+	 * @param data The data to push into the queue.
+	 * @return True if the element was added, false if the queue was full.
+	 */
+	bool tryPush(const T& data);
+
+	/**
+	 * @brief Adds as many elements from an array as fit, publishing them together (O(k)). Producer only.
+	 * @param data The array of data to push into the queue.
+	 * @param size The size of the array.
+	 * @return The number of elements added.
+	 */
+	int pushMany(const T data[], int size);
+
+	/**
+	 * @brief Removes an element from the front of the queue if there is one (O(1)). Consumer only.
+	 * @param out Receives the removed element.
+	 * @return True if an element was removed, false if the queue was empty.
+	 */
+	bool tryPop(T& out);
+
+	/**
+	 * @brief Removes up to a given number of elements into an array, releasing their slots together (O(k)). Consumer only.
+	 * @param out The array to copy the elements into.
+	 * @param max The maximum number of elements to remove.
+	 * @return The number of elements removed.
+	 */
+	int popMany(T out[], int max);
+
+	/**
+	 * @brief Returns the element at the front of the queue without removing it (O(1)). Consumer only.
+	 * @return The data at the front of the queue.
+	 * @throws std::runtime_error If the queue is empty.
+	 */
+	T peek();
+
+	/**
+	 * @brief Returns a snapshot of the length of the queue (O(1)).
+	 * @return The number of elements in the queue.
+	 */
+	int length() const;
+
+	/**
+	 * @brief Returns the maximum number of elements the queue can hold (O(1)).
+	 * @return The capacity of the queue.
+	 */
+	int capacity() const { return static_cast<int>(cap); }
+
+	/**
+	 * @brief Checks if the queue is empty at the time of the call (O(1)).
+	 * @return True if the queue is empty, false otherwise.
+	 */
+	bool isEmpty() const { return length() == 0; }
+};
+
+
+template <class T>
+int SPSCQueue<T>::length() const {
+	// The head is loaded first: the tail only grows, so it cannot then fall behind the loaded head, though
+	// both ends may move on in between, so the difference is capped at the capacity
+	std::size_t h = head.load(std::memory_order_acquire);
+	std::size_t t = tail.load(std::memory_order_acquire);
+	return static_cast<int>(std::min(t - h, cap));
+}
+
+template <class T>
+std::size_t SPSCQueue<T>::roundUp(int size) {
+	std::size_t result = 1;
+	while (result < static_cast<std::size_t>(size)) {
+		result *= 2;
+	}
+	return result;
+}
+
+template <class T>
+SPSCQueue<T>::SPSCQueue(int size) : s_array(nullptr), cap(0), mask(0), head(0), cached_tail(0), tail(0), cached_head(0) {
+	if (size <= 0) {
+		throw std::invalid_argument("Capacity must be positive");
+	}
+	cap = roundUp(size);
+	mask = cap - 1;
+	s_array = new T[cap];
+}
+
+template <class T>
+bool SPSCQueue<T>::tryPush(const T& data) {
+	std::size_t t = tail.load(std::memory_order_relaxed);
+	if (t - cached_head == cap) {
+		cached_head = head.load(std::memory_order_acquire);
+		if (t - cached_head == cap) {
+			return false;
+		}
+	}
+	s_array[t & mask] = data;
+	tail.store(t + 1, std::memory_order_release);
+	return true;
+}
+
+template <class T>
+int SPSCQueue<T>::pushMany(const T data[], int size) {
+	std::size_t t = tail.load(std::memory_order_relaxed);
+	std::size_t limit = static_cast<std::size_t>(std::max(size, 0));
+	std::size_t count = std::min(limit, cap - (t - cached_head));
+	if (count < limit) {
+		cached_head = head.load(std::memory_order_acquire);
+		count = std::min(limit, cap - (t - cached_head));
+	}
+	std::size_t first = std::min(count, cap - (t & mask));
+	std::copy(data, data + first, s_array + (t & mask));
+	std::copy(data + first, data + count, s_array);
+	tail.store(t + count, std::memory_order_release);
+	return static_cast<int>(count);
+}
+
+template <class T>
+bool SPSCQueue<T>::tryPop(T& out) {
+	std::size_t h = head.load(std::memory_order_relaxed);
+	if (h == cached_tail) {
+		cached_tail = tail.load(std::memory_order_acquire);
+		if (h == cached_tail) {
+			return false;
+		}
+	}
+	out = s_array[h & mask];
+	head.store(h + 1, std::memory_order_release);
+	return true;
+}
+
+template <class T>
+int SPSCQueue<T>::popMany(T out[], int max) {
+	std::size_t h = head.load(std::memory_order_relaxed);
+	std::size_t limit = static_cast<std::size_t>(std::max(max, 0));
+	std::size_t count = std::min(limit, cached_tail - h);
+	if (count < limit) {
+		cached_tail = tail.load(std::memory_order_acquire);
+		count = std::min(limit, cached_tail - h);
+	}
+	std::size_t first = std::min(count, cap - (h & mask));
+	std::copy(s_array + (h & mask), s_array + (h & mask) + first, out);
+	std::copy(s_array, s_array + (count - first), out + first);
+	head.store(h + count, std::memory_order_release);
+	return static_cast<int>(count);
+}
+
+template <class T>
+T SPSCQueue<T>::peek() {
+	std::size_t h = head.load(std::memory_order_relaxed);
+	if (h == cached_tail) {
+		cached_tail = tail.load(std::memory_order_acquire);
+		if (h == cached_tail) {
+			throw std::runtime_error("Cannot peek an empty queue");
+		}
+	}
+	return s_array[h & mask];
+}
@@ -0,0 +1,241 @@
+/**
+ * @file stablepqueue.h
+ * @brief Stable priority queue implementation using a d-ary heap of sequenced entries.
+ *
+ * This class wraps PQueue so that elements of equal priority are popped in the order they
+ * were pushed. Each element is stored alongside a 64-bit order word. For keys that are
+ * integers of up to 32 bits or floats under std::less or std::greater, the order word packs
+ * the priority, mapped to an order-preserving unsigned value, above a 32-bit sequence
+ * number, so every heap comparison is a single integer compare. Other keys compare by
+ * priority first and fall back to a 64-bit sequence number on ties.
+ *
+ * @tparam T The data type stored in the priority queue.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ * @tparam Arity The number of children of each node.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "pqueue.h"
+#include "vector.h"
+
+/**
+ * @class StablePQueue
+ * @brief A priority queue that pops elements of equal priority first in, first out.
+ *
+ * @tparam T The data type stored in the priority queue.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ * @tparam Arity The number of children of each node.
+ */
+template <class T, class Compare = std::less<>, class Key = std::identity, int Arity = 2>
+class StablePQueue {
+private:
+	typedef std::remove_cvref_t<std::invoke_result_t<Key&, const T&>> KeyType;
+
+	static constexpr bool LESS = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<KeyType>>;
+	static constexpr bool GREATER = std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<KeyType>>;
+	// Packs the priority and sequence number into one word when the key maps to 32 order-preserving bits
+	static constexpr bool PACKED = (LESS || GREATER) && ((std::is_integral_v<KeyType> && sizeof(KeyType) <= 4) || std::is_same_v<KeyType, float>);
+	// Largest sequence number before packed entries are renumbered
+	static const std::uint64_t MAX_SEQUENCE = PACKED ? 0xFFFFFFFFull : ~0ull;
+
+	/**
+	 * @struct Entry
+	 * @brief An element and its order word.
+	 */
+	struct Entry {
+		std::uint64_t order;
+		T data;
+	};
+
+	/**
+	 * @struct Ordering
+	 * @brief Orders entries by priority, then by sequence number.
+	 */
+	struct Ordering {
+		Compare comp;
+		Key key;
+		bool max_heap;
+
+		bool operator()(const Entry& entry_1, const Entry& entry_2) const;
+	};
+
+	PQueue<Entry, Ordering, std::identity, Arity> heap;
+	bool max_heap;
+	Compare comp;
+	Key key;
+	std::uint64_t sequence;
+
+	/**
+	 * @brief Maps a key to an unsigned value with the same order under std::less.
+	 * @param key_value The key to map.
+	 * @return The mapped key.
+	 */
+	static std::uint32_t rank(KeyType key_value);
+
+	/**
+	 * @brief Builds the order word for an element.
+	 * @param data The element.
+	 * @param seq The sequence number of the element.
+	 * @return The order word.
+	 */
+	std::uint64_t order(const T& data, std::uint64_t seq) const;
+
+	/**
+	 * @brief Reassigns sequence numbers from 0 in pop order, once the sequence has been exhausted (O(n log(n))).
+	 */
+	void renumber();
+
+public:
+	/**
+	 * @brief Constructs a new stable priority queue (O(1)).
+	 * @param max_heap Indicates whether the heap is a max-heap (true) or min-heap (false).
+	 * @param comp The comparator to order keys with.
+	 * @param key The projection from elements to keys.
+	 */
+	StablePQueue(bool max_heap = false, Compare comp = Compare(), Key key = Key()) : heap(false, Ordering{comp, key, max_heap}), max_heap(max_heap), comp(comp), key(key), sequence(0) {}
+
+	StablePQueue(const StablePQueue&) = delete;
+	StablePQueue& operator=(const StablePQueue&) = delete;
+
+	/**
+	 * @brief Inserts an element behind every element of equal priority (O(log(n))).
+	 * @param data The element to be added.
+	 */
+	void push(T data);
+
+	/**
+	 * @brief Removes and returns the highest priority element that was pushed first (O(log(n))).
+	 * @return The highest priority element.
+	 * @throws std::runtime_error If the priority queue is empty.
+	 */
+	T pop() { return heap.pop().data; }
+
+	/**
+	 * @brief Returns the element that pop would return (O(1)).
+	 * @return The highest priority element.
+	 * @throws std::runtime_error If the priority queue is empty.
+	 */
+	T peek() const { return heap.peek().data; }
+
+	/**
+	 * @brief Clears the priority queue and restarts the sequence (O(1)).
+	 */
+	void clear() { heap.clear(); sequence = 0; }
+
+	/**
+	 * @brief Returns the length of the priority queue (O(1)).
+	 * @return The number of elements in the priority queue.
+	 */
+	int length() const { return heap.length(); }
+
+	/**
+	 * @brief Checks if the priority queue is empty (O(1)).
+	 * @return True if the priority queue is empty, false otherwise.
+	 */
+	bool isEmpty() const { return heap.isEmpty(); }
+
+	/**
+	 * @brief Checks if the priority queue is a maximum heap (O(1)).
+	 * @return True if the priority queue is a maximum heap, false otherwise.
+	 */
+	bool isMax() const { return max_heap; }
+
+	/**
+	 * @brief Checks if the priority queue is a minimum heap (O(1)).
+	 * @return True if the priority queue is a minimum heap, false otherwise.
+	 */
+	bool isMin() const { return !max_heap; }
+
+	/**
+	 * @brief Checks if entries are compared by a single packed integer (O(1)).
+	 * @return True if the priority and sequence number share one word, false otherwise.
+	 */
+	static constexpr bool isPacked() { return PACKED; }
+
+	/**
+	 * @brief Checks if the heap property is still held (O(n)).
+	 * @return True if the heap property is still held, false otherwise.
+	 */
+	bool validHeap() const { return heap.validHeap(); }
+};
+
+
+template <class T, class Compare, class Key, int Arity>
+bool StablePQueue<T, Compare, Key, Arity>::Ordering::operator()(const Entry& entry_1, const Entry& entry_2) const {
+	if constexpr (PACKED) {
+		return entry_1.order < entry_2.order;
+	} else {
+		const KeyType& key_1 = std::invoke(key, entry_1.data);
+		const KeyType& key_2 = std::invoke(key, entry_2.data);
+		if (max_heap ? comp(key_2, key_1) : comp(key_1, key_2)) {
+			return true;
+		}
+		if (max_heap ? comp(key_1, key_2) : comp(key_2, key_1)) {
+			return false;
+		}
+		return entry_1.order < entry_2.order;
+	}
+}
+
+template <class T, class Compare, class Key, int Arity>
+std::uint32_t StablePQueue<T, Compare, Key, Arity>::rank(KeyType key_value) {
+	if constexpr (std::is_same_v<KeyType, float>) {
+		// -0.0f and +0.0f compare equal, so they must share a rank for ties between them to stay FIFO
+		if (key_value == 0.0f) {
+			key_value = 0.0f;
+		}
+		// Negative floats order in reverse by their bits, so flip all of them; flip only the sign of the rest
+		std::uint32_t bits = std::bit_cast<std::uint32_t>(key_value);
+		return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+	} else if constexpr (std::is_signed_v<KeyType>) {
+		return static_cast<std::uint32_t>(static_cast<std::int32_t>(key_value)) ^ 0x80000000u;
+	} else {
+		return static_cast<std::uint32_t>(key_value);
+	}
+}
+
+template <class T, class Compare, class Key, int Arity>
+std::uint64_t StablePQueue<T, Compare, Key, Arity>::order(const T& data, std::uint64_t seq) const {
+	if constexpr (PACKED) {
+		std::uint32_t priority = rank(std::invoke(key, data));
+		if (GREATER != max_heap) {
+			priority = ~priority;
+		}
+		return (static_cast<std::uint64_t>(priority) << 32) | seq;
+	} else {
+		return seq;
+	}
+}
+
+template <class T, class Compare, class Key, int Arity>
+void StablePQueue<T, Compare, Key, Arity>::renumber() {
+	int n = heap.length();
+	Vector<Entry> entries(n > 0 ? n : 1);
+	while (!heap.isEmpty()) {
+		entries.push(heap.pop());
+	}
+	for (int i = 0; i < n; i++) {
+		entries[i].order = order(entries[i].data, static_cast<std::uint64_t>(i));
+		heap.push(entries[i]);
+	}
+	sequence = static_cast<std::uint64_t>(n);
+}
+
+template <class T, class Compare, class Key, int Arity>
+void StablePQueue<T, Compare, Key, Arity>::push(T data) {
+	if (sequence > MAX_SEQUENCE) {
+		renumber();
+	}
+	heap.push({order(data, sequence), data});
+	sequence++;
+}
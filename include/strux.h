@@ -10,3 +10,35 @@
 #include "queue.h"
 #include "list.h"
 #include "stack.h"
+#include "ilist.h"
+#include "istack.h"
+#include "iqueue.h"
+#include "ringqueue.h"
+#include "spscqueue.h"
+#include "mpmcqueue.h"
+#include "blockingqueue.h"
+#include "wsdeque.h"
+#include "threadpool.h"
+#include "arraystack.h"
+#include "treiberstack.h"
+#include "inplacevector.h"
+#include "inplacestack.h"
+#include "inplacequeue.h"
+#include "indexedpqueue.h"
+#include "pairingheap.h"
+#include "radixheap.h"
+#include "topk.h"
+#include "minmaxheap.h"
+#include "stablepqueue.h"
+#include "multiqueue.h"
+#include "timingwheel.h"
+#include "scheduledexecutor.h"
+#include "runningquantile.h"
+#include "externalpqueue.h"
+#include "hashtable.h"
+#include "hashmap.h"
+#include "hashset.h"
+#include "concurrenthashmap.h"
+#include "lrucache.h"
+#include "clockcache.h"
+#include "shardedcache.h"
@@ -0,0 +1,341 @@
+/**
+ * @file threadpool.h
+ * @brief Work-stealing thread pool for fork-join task parallelism.
+ *
+ * This class runs tasks on a fixed set of worker threads, each owning a work-stealing
+ * deque. Tasks spawned by a worker go onto its own deque and are popped in LIFO order for
+ * locality, idle workers steal the oldest tasks from random victims, and tasks submitted
+ * from outside the pool go through a shared injection queue. Threads waiting on a task
+ * group execute other tasks instead of blocking, so nested fork-join never deadlocks.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "queue.h"
+#include "wsdeque.h"
+
+/**
+ * @class ThreadPool
+ * @brief A fixed-size pool of worker threads that balance load by work stealing.
+ */
+class ThreadPool {
+public:
+	class TaskGroup;
+
+private:
+	// Number of times an idle worker rescans for work before parking
+	static const int SPIN_LIMIT = 64;
+
+	/**
+	 * @struct Task
+	 * @brief A unit of work and the group, if any, waiting on it.
+	 */
+	struct Task {
+		std::function<void()> fn;
+		TaskGroup* group;
+	};
+
+	/**
+	 * @struct Worker
+	 * @brief A worker thread and the deque of tasks it owns.
+	 */
+	struct Worker {
+		WorkStealingDeque<Task*> deque;
+		std::thread thread;
+	};
+
+	Worker* workers;
+	int n_workers;
+
+	Queue<Task*> injection;
+	std::mutex injection_mutex;
+	std::atomic<int> injected;
+
+	std::atomic<bool> stopping;
+	std::atomic<std::uint64_t> epoch;
+	std::atomic<int> sleepers;
+	std::mutex sleep_mutex;
+	std::condition_variable wake;
+
+	inline static thread_local ThreadPool* current_pool = nullptr;
+	inline static thread_local int current_index = -1;
+	inline static thread_local std::uint32_t seed = 0;
+
+	/**
+	 * @brief Runs a worker thread until the pool stops and no work remains.
+	 * @param idx The index of the worker.
+	 */
+	void workerLoop(int idx);
+
+	/**
+	 * @brief Finds a task to run: the worker's own deque first, then the injection queue, then other workers' deques.
+	 * @param idx The index of the calling worker, or -1 for a thread outside the pool.
+	 * @return A task, or nullptr if none was found.
+	 */
+	Task* findTask(int idx);
+
+	/**
+	 * @brief Queues a task on the calling worker's deque, or on the injection queue from outside the pool.
+	 * @param task The task to queue.
+	 */
+	void enqueue(Task* task);
+
+	/**
+	 * @brief Runs a task, records any exception in its group and frees it.
+	 * @param task The task to run.
+	 */
+	static void execute(Task* task);
+
+	/**
+	 * @brief Returns the index of the calling thread if it is one of this pool's workers.
+	 * @return The worker index, or -1 for a thread outside the pool.
+	 */
+	int workerIndex() const { return current_pool == this ? current_index : -1; }
+
+	/**
+	 * @brief Returns a pseudo-random number from a per-thread xorshift generator.
+	 * @return The next pseudo-random number.
+	 */
+	static std::uint32_t random();
+
+public:
+	/**
+	 * @class TaskGroup
+	 * @brief A set of tasks that can be waited on together.
+	 *
+	 * Waiting runs queued tasks on the calling thread until every task in the group has
+	 * finished, then rethrows the first exception any of them threw.
+	 */
+	class TaskGroup {
+	private:
+		friend class ThreadPool;
+
+		ThreadPool& pool;
+		std::atomic<int> pending;
+		std::exception_ptr error;
+		std::mutex error_mutex;
+
+		/**
+		 * @brief Runs queued tasks until every task in the group has finished.
+		 */
+		void help();
+
+	public:
+		/**
+		 * @brief Constructs an empty task group on a pool (O(1)).
+		 * @param pool The pool to run the group's tasks on.
+		 */
+		TaskGroup(ThreadPool& pool) : pool(pool), pending(0) {}
+
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		/**
+		 * @brief Destroys the task group, first waiting for its tasks and discarding any exception.
+		 */
+		~TaskGroup() { help(); }
+
+		/**
+		 * @brief Spawns a task in the group (O(1)).
+		 * @param fn The function to run.
+		 */
+		void run(std::function<void()> fn);
+
+		/**
+		 * @brief Waits for every task in the group, running queued tasks meanwhile.
+		 * @throws The first exception thrown by a task in the group.
+		 */
+		void wait();
+	};
+
+	/**
+	 * @brief Constructs a pool and starts its worker threads.
+	 * @param threads The number of workers, or 0 to use one per hardware thread.
+	 * @throws std::invalid_argument If the number of workers is negative.
+	 */
+	ThreadPool(int threads = 0);
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * @brief Runs every queued task, then stops and joins the worker threads.
+	 */
+	~ThreadPool();
+
+	/**
+	 * @brief Queues a detached task that nothing waits on (O(1)).
+	 * @param fn The function to run. Exceptions it throws are discarded.
+	 */
+	void submit(std::function<void()> fn) { enqueue(new Task{fn, nullptr}); }
+
+	/**
+	 * @brief Returns the number of worker threads (O(1)).
+	 * @return The number of workers.
+	 */
+	int size() const { return n_workers; }
+};
+
+
+inline ThreadPool::ThreadPool(int threads) : workers(nullptr), n_workers(threads), injected(0), stopping(false), epoch(0), sleepers(0) {
+	if (threads < 0) {
+		throw std::invalid_argument("Number of threads must not be negative");
+	}
+	if (n_workers == 0) {
+		n_workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+	}
+	workers = new Worker[n_workers];
+	for (int i = 0; i < n_workers; i++) {
+		workers[i].thread = std::thread(&ThreadPool::workerLoop, this, i);
+	}
+}
+
+inline ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		stopping.store(true);
+	}
+	wake.notify_all();
+	for (int i = 0; i < n_workers; i++) {
+		workers[i].thread.join();
+	}
+	delete[] workers;
+}
+
+inline std::uint32_t ThreadPool::random() {
+	if (seed == 0) {
+		seed = static_cast<std::uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+	}
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+inline void ThreadPool::workerLoop(int idx) {
+	current_pool = this;
+	current_index = idx;
+
+	int spins = 0;
+	while (true) {
+		std::uint64_t seen = epoch.load();
+		Task* task = findTask(idx);
+		if (task != nullptr) {
+			execute(task);
+			spins = 0;
+			continue;
+		}
+		if (stopping.load()) {
+			return;
+		}
+		if (++spins < SPIN_LIMIT) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		// Parks until a task is queued after the scan above, or the pool stops
+		std::unique_lock<std::mutex> lock(sleep_mutex);
+		sleepers.fetch_add(1);
+		wake.wait(lock, [this, seen]() { return epoch.load() != seen || stopping.load(); });
+		sleepers.fetch_sub(1);
+		spins = 0;
+	}
+}
+
+inline ThreadPool::Task* ThreadPool::findTask(int idx) {
+	Task* task = nullptr;
+	if (idx >= 0 && workers[idx].deque.pop(task)) {
+		return task;
+	}
+
+	if (injected.load(std::memory_order_acquire) > 0) {
+		std::lock_guard<std::mutex> lock(injection_mutex);
+		if (!injection.isEmpty()) {
+			injected.fetch_sub(1, std::memory_order_relaxed);
+			return injection.pop();
+		}
+	}
+
+	int start = static_cast<int>(random() % n_workers);
+	for (int i = 0; i < n_workers; i++) {
+		int victim = (start + i) % n_workers;
+		if (victim != idx && workers[victim].deque.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+inline void ThreadPool::enqueue(Task* task) {
+	int idx = workerIndex();
+	if (idx >= 0) {
+		workers[idx].deque.push(task);
+	} else {
+		std::lock_guard<std::mutex> lock(injection_mutex);
+		injection.push(task);
+		injected.fetch_add(1, std::memory_order_release);
+	}
+
+	epoch.fetch_add(1);
+	if (sleepers.load() > 0) {
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		wake.notify_one();
+	}
+}
+
+inline void ThreadPool::execute(Task* task) {
+	TaskGroup* group = task->group;
+	try {
+		task->fn();
+	} catch (...) {
+		if (group != nullptr) {
+			std::lock_guard<std::mutex> lock(group->error_mutex);
+			if (!group->error) {
+				group->error = std::current_exception();
+			}
+		}
+	}
+	delete task;
+	if (group != nullptr) {
+		group->pending.fetch_sub(1, std::memory_order_release);
+	}
+}
+
+inline void ThreadPool::TaskGroup::run(std::function<void()> fn) {
+	pending.fetch_add(1, std::memory_order_relaxed);
+	pool.enqueue(new Task{fn, this});
+}
+
+inline void ThreadPool::TaskGroup::help() {
+	int idx = pool.workerIndex();
+	while (pending.load(std::memory_order_acquire) > 0) {
+		Task* task = pool.findTask(idx);
+		if (task != nullptr) {
+			execute(task);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+inline void ThreadPool::TaskGroup::wait() {
+	help();
+	std::exception_ptr thrown;
+	{
+		std::lock_guard<std::mutex> lock(error_mutex);
+		std::swap(thrown, error);
+	}
+	if (thrown) {
+		std::rethrow_exception(thrown);
+	}
+}
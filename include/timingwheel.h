@@ -0,0 +1,360 @@
+/**
+ * @file timingwheel.h
+ * @brief Timer scheduler implementation using a hierarchical timing wheel.
+ *
+ * This class implements Varghese and Lauck's hierarchical timing wheel over 64-bit ticks.
+ * Each level has 64 slots covering 6 bits of the deadline, so the 11 levels span every
+ * tick. A timer is placed on the level of the highest bit in which its deadline differs
+ * from the current tick, and is moved down a level each time the wheel reaches its slot
+ * there, until it fires from level 0. Scheduling and cancelling are O(1), and since a
+ * bitmask records which slots are occupied, advancing skips over idle stretches in
+ * O(levels) per occupied slot rather than visiting every tick.
+ *
+ * Buckets are intrusive lists of pooled timer nodes, and expired items are handed back in
+ * a vector, so a burst of expiries costs no allocation once the pool has warmed up.
+ *
+ * @tparam T The data type carried by each timer.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <bit>
+#include <cstdint>
+#include <utility>
+#include "ilist.h"
+#include "vector.h"
+
+/**
+ * @class TimingWheel
+ * @brief A hierarchical timing wheel with O(1) schedule and cancel.
+ *
+ * The wheel has no clock of its own: ticks are whatever unit the caller advances it in.
+ *
+ * @tparam T The data type carried by each timer.
+ */
+template <class T>
+class TimingWheel {
+private:
+	// Number of deadline bits covered by each level
+	static const int SLOT_BITS = 6;
+	// Number of slots on each level, one per bit of the occupancy mask
+	static const int SLOTS = 1 << SLOT_BITS;
+	// Number of levels needed to cover a 64-bit tick
+	static const int LEVELS = (64 + SLOT_BITS - 1) / SLOT_BITS;
+	// Level recorded for timers that were already due when placed
+	static const int DUE = -1;
+
+	/**
+	 * @struct Timer
+	 * @brief A pooled timer node, linked into a bucket while pending and into the free list otherwise.
+	 */
+	struct Timer : ListHook<> {
+		T data;
+		std::uint64_t deadline;
+		std::uint64_t generation;
+		int level;
+		int slot;
+	};
+
+	IntrusiveList<Timer> buckets[LEVELS][SLOTS];
+	std::uint64_t occupied[LEVELS];
+	IntrusiveList<Timer> due;
+	IntrusiveList<Timer> free_timers;
+	Vector<Timer*> timers;
+	std::uint64_t current;
+	int len;
+
+	/**
+	 * @brief Returns the slot a tick falls in on a given level.
+	 * @param tick The tick.
+	 * @param level The level.
+	 * @return The slot index.
+	 */
+	static int digit(std::uint64_t tick, int level) { return static_cast<int>((tick >> (level * SLOT_BITS)) & (SLOTS - 1)); }
+
+	/**
+	 * @brief Takes a timer node from the pool, allocating one if the pool is empty.
+	 * @return An unlinked timer node.
+	 */
+	Timer* acquire();
+
+	/**
+	 * @brief Returns a timer node to the pool, invalidating its handles.
+	 * @param timer The unlinked timer node.
+	 */
+	void release(Timer* timer);
+
+	/**
+	 * @brief Links a timer into the bucket for its deadline relative to the current tick.
+	 * @param timer The unlinked timer node.
+	 */
+	void place(Timer* timer);
+
+	/**
+	 * @brief Returns the earliest tick after the current one at which a slot fires or cascades.
+	 * @return The tick of the next event, or UINT64_MAX if no timer is pending in the wheel.
+	 */
+	std::uint64_t nextEvent() const;
+
+	/**
+	 * @brief Moves every timer out of a slot and places it again relative to the current tick.
+	 * @param level The level of the slot.
+	 * @param slot The slot to cascade.
+	 */
+	void cascade(int level, int slot);
+
+	/**
+	 * @brief Moves the items of every timer in a list into a vector and returns the timers to the pool.
+	 * @param list The list of expired timers.
+	 * @param expired The vector to append the items to.
+	 * @return The number of items appended.
+	 */
+	int fire(IntrusiveList<Timer>& list, Vector<T>& expired);
+
+public:
+	/**
+	 * @class Handle
+	 * @brief Identifies a scheduled timer. It goes stale once the timer fires or is cancelled.
+	 */
+	class Handle {
+		friend class TimingWheel;
+
+		Timer* timer;
+		std::uint64_t generation;
+
+	public:
+		Handle() : timer(nullptr), generation(0) {}
+	};
+
+	/**
+	 * @brief Constructs an empty timing wheel (O(1)).
+	 * @param start The tick the wheel starts at.
+	 */
+	TimingWheel(std::uint64_t start = 0);
+
+	TimingWheel(const TimingWheel&) = delete;
+	TimingWheel& operator=(const TimingWheel&) = delete;
+
+	/**
+	 * @brief Destroys the timing wheel and every timer node (O(n)).
+	 */
+	~TimingWheel();
+
+	/**
+	 * @brief Schedules an item to expire at a given tick (O(1)).
+	 * @param data The item to return once the timer expires.
+	 * @param deadline The tick at which the timer expires. A deadline that has passed expires on the next advance.
+	 * @return A handle for cancelling the timer.
+	 */
+	Handle schedule(T data, std::uint64_t deadline);
+
+	/**
+	 * @brief Cancels a pending timer (O(1)).
+	 * @param handle The handle of the timer.
+	 * @return True if the timer was cancelled, false if it had already fired or been cancelled.
+	 */
+	bool cancel(const Handle& handle);
+
+	/**
+	 * @brief Checks if a timer is still pending (O(1)).
+	 * @param handle The handle of the timer.
+	 * @return True if the timer has neither fired nor been cancelled, false otherwise.
+	 */
+	bool isPending(const Handle& handle) const { return handle.timer != nullptr && handle.timer->generation == handle.generation; }
+
+	/**
+	 * @brief Advances the wheel to a given tick, collecting every item whose deadline has been reached (O(k + levels * e)).
+	 *
+	 * Items are appended in deadline order, where e is the number of occupied slots passed on the way.
+	 *
+	 * @param now The tick to advance to.
+	 * @param expired The vector to append the expired items to.
+	 * @return The number of items that expired.
+	 * @throws std::invalid_argument If now is before the current tick.
+	 */
+	int advance(std::uint64_t now, Vector<T>& expired);
+
+	/**
+	 * @brief Returns the tick the wheel has advanced to (O(1)).
+	 * @return The current tick.
+	 */
+	std::uint64_t now() const { return current; }
+
+	/**
+	 * @brief Returns the number of pending timers (O(1)).
+	 * @return The number of pending timers.
+	 */
+	int length() const { return len; }
+
+	/**
+	 * @brief Checks if no timers are pending (O(1)).
+	 * @return True if the wheel is empty, false otherwise.
+	 */
+	bool isEmpty() const { return len == 0; }
+};
+
+
+template <class T>
+TimingWheel<T>::TimingWheel(std::uint64_t start) : current(start), len(0) {
+	for (int i = 0; i < LEVELS; i++) {
+		occupied[i] = 0;
+	}
+}
+
+template <class T>
+TimingWheel<T>::~TimingWheel() {
+	// Unlink every node before freeing them, so the lists never touch freed memory
+	for (int level = 0; level < LEVELS; level++) {
+		for (int slot = 0; slot < SLOTS; slot++) {
+			buckets[level][slot].clear();
+		}
+	}
+	due.clear();
+	free_timers.clear();
+	for (int i = 0; i < timers.length(); i++) {
+		delete timers[i];
+	}
+}
+
+template <class T>
+typename TimingWheel<T>::Timer* TimingWheel<T>::acquire() {
+	if (!free_timers.isEmpty()) {
+		return &free_timers.popFront();
+	}
+	Timer* timer = new Timer();
+	timer->generation = 0;
+	timers.push(timer);
+	return timer;
+}
+
+template <class T>
+void TimingWheel<T>::release(Timer* timer) {
+	timer->generation++;
+	timer->data = T();
+	free_timers.push(*timer);
+}
+
+template <class T>
+void TimingWheel<T>::place(Timer* timer) {
+	if (timer->deadline <= current) {
+		timer->level = DUE;
+		due.push(*timer);
+		return;
+	}
+	int level = (std::bit_width(timer->deadline ^ current) - 1) / SLOT_BITS;
+	int slot = digit(timer->deadline, level);
+	timer->level = level;
+	timer->slot = slot;
+	buckets[level][slot].push(*timer);
+	occupied[level] |= 1ull << slot;
+}
+
+template <class T>
+std::uint64_t TimingWheel<T>::nextEvent() const {
+	std::uint64_t best = ~0ull;
+	for (int level = 0; level < LEVELS; level++) {
+		if (occupied[level] == 0) {
+			continue;
+		}
+		// Occupied slots always lie ahead of the current tick's slot, within its block of the level above
+		int shift = level * SLOT_BITS;
+		int above = shift + SLOT_BITS;
+		std::uint64_t block = above >= 64 ? 0 : (current >> above) << above;
+		std::uint64_t tick = block | (static_cast<std::uint64_t>(std::countr_zero(occupied[level])) << shift);
+		if (tick < best) {
+			best = tick;
+		}
+	}
+	return best;
+}
+
+template <class T>
+void TimingWheel<T>::cascade(int level, int slot) {
+	IntrusiveList<Timer>& bucket = buckets[level][slot];
+	while (!bucket.isEmpty()) {
+		place(&bucket.popFront());
+	}
+	occupied[level] &= ~(1ull << slot);
+}
+
+template <class T>
+int TimingWheel<T>::fire(IntrusiveList<Timer>& list, Vector<T>& expired) {
+	int count = 0;
+	while (!list.isEmpty()) {
+		Timer& timer = list.popFront();
+		expired.push(std::move(timer.data));
+		release(&timer);
+		count++;
+	}
+	len -= count;
+	return count;
+}
+
+template <class T>
+typename TimingWheel<T>::Handle TimingWheel<T>::schedule(T data, std::uint64_t deadline) {
+	Timer* timer = acquire();
+	timer->data = data;
+	timer->deadline = deadline;
+	place(timer);
+	len++;
+
+	Handle handle;
+	handle.timer = timer;
+	handle.generation = timer->generation;
+	return handle;
+}
+
+template <class T>
+bool TimingWheel<T>::cancel(const Handle& handle) {
+	if (!isPending(handle)) {
+		return false;
+	}
+	Timer* timer = handle.timer;
+	if (timer->level == DUE) {
+		due.remove(*timer);
+	} else {
+		IntrusiveList<Timer>& bucket = buckets[timer->level][timer->slot];
+		bucket.remove(*timer);
+		if (bucket.isEmpty()) {
+			occupied[timer->level] &= ~(1ull << timer->slot);
+		}
+	}
+	release(timer);
+	len--;
+	return true;
+}
+
+template <class T>
+int TimingWheel<T>::advance(std::uint64_t now, Vector<T>& expired) {
+	if (now < current) {
+		throw std::invalid_argument("Cannot advance a timing wheel backwards");
+	}
+
+	int count = fire(due, expired);
+	while (current < now) {
+		std::uint64_t next = nextEvent();
+		if (next > now) {
+			current = now;
+			break;
+		}
+		current = next;
+
+		// Cascade from the top so that timers falling through several levels land before level 0 fires
+		for (int level = LEVELS - 1; level > 0; level--) {
+			std::uint64_t below = (1ull << (level * SLOT_BITS)) - 1;
+			int slot = digit(current, level);
+			if ((current & below) == 0 && (occupied[level] & (1ull << slot)) != 0) {
+				cascade(level, slot);
+			}
+		}
+		int slot = digit(current, 0);
+		if ((occupied[0] & (1ull << slot)) != 0) {
+			occupied[0] &= ~(1ull << slot);
+			count += fire(buckets[0][slot], expired);
+		}
+		count += fire(due, expired);
+	}
+	return count;
+}
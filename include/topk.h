@@ -0,0 +1,167 @@
+/**
+ * @file topk.h
+ * @brief Streaming bounded top-k selector using a priority queue.
+ *
+ * This class keeps the k greatest elements seen so far in a min-heap of at most k elements,
+ * whose root is the weakest element kept. An offered element that does not beat the root
+ * is rejected after a single comparison, so selecting from a stream of n elements costs
+ * O(n + m log k) time for m accepted elements and O(k) memory, however long the stream.
+ *
+ * @tparam T The data type stored in the selector.
+ * @tparam Compare The strict weak ordering on keys, where the greatest elements under it are kept.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include "pqueue.h"
+
+/**
+ * @class TopK
+ * @brief A selector that keeps the k greatest elements of a stream.
+ *
+ * Passing std::greater as the comparator keeps the k smallest elements instead.
+ *
+ * @tparam T The data type stored in the selector.
+ * @tparam Compare The strict weak ordering on keys.
+ * @tparam Key The projection applied to each element to obtain its key.
+ */
+template <class T, class Compare = std::less<>, class Key = std::identity>
+class TopK {
+private:
+	PQueue<T, Compare, Key> heap;
+	int k;
+	Compare comp;
+	Key key;
+
+public:
+	/**
+	 * @brief Constructs an empty selector (O(1)).
+	 * @param k The number of elements to keep.
+	 * @param comp The comparator to order keys with.
+	 * @param key The projection from elements to keys.
+	 * @throws std::invalid_argument If k is not positive.
+	 */
+	TopK(int k, Compare comp = Compare(), Key key = Key());
+
+	TopK(const TopK&) = delete;
+	TopK& operator=(const TopK&) = delete;
+
+	/**
+	 * @brief Offers an element, keeping it if it is among the k greatest seen so far (O(log(k))).
+	 * @param data The element to offer.
+	 * @return True if the element was kept, false if it was rejected.
+	 */
+	bool push(T data);
+
+	/**
+	 * @brief Offers an array of elements (O(n log(k))).
+	 * @param data The array of elements to offer.
+	 * @param size The size of the array.
+	 * @return The number of elements kept, some of which may since have been evicted by later ones.
+	 */
+	int pushMany(const T data[], int size);
+
+	/**
+	 * @brief Returns the weakest element kept, which any new element must beat once the selector is full (O(1)).
+	 * @return The weakest element kept.
+	 * @throws std::runtime_error If the selector is empty.
+	 */
+	T threshold() const { return heap.peek(); }
+
+	/**
+	 * @brief Copies the kept elements without removing them (O(k log(k))).
+	 * @param out The array to copy the elements into, greatest first.
+	 * @return The number of elements copied.
+	 */
+	int peekAll(T out[]) const;
+
+	/**
+	 * @brief Removes every kept element, greatest first (O(k log(k))).
+	 * @param out The array to move the elements into, which must hold length() elements.
+	 * @return The number of elements removed.
+	 */
+	int popAll(T out[]);
+
+	/**
+	 * @brief Discards every kept element (O(1)).
+	 */
+	void clear() { heap.clear(); }
+
+	/**
+	 * @brief Returns the number of elements kept (O(1)).
+	 * @return The number of elements kept.
+	 */
+	int length() const { return heap.length(); }
+
+	/**
+	 * @brief Returns the number of elements the selector keeps at most (O(1)).
+	 * @return The value of k.
+	 */
+	int capacity() const { return k; }
+
+	/**
+	 * @brief Checks if the selector holds no elements (O(1)).
+	 * @return True if the selector is empty, false otherwise.
+	 */
+	bool isEmpty() const { return heap.isEmpty(); }
+
+	/**
+	 * @brief Checks if the selector holds k elements, so new ones must beat the threshold (O(1)).
+	 * @return True if the selector is full, false otherwise.
+	 */
+	bool isFull() const { return heap.length() == k; }
+};
+
+
+template <class T, class Compare, class Key>
+TopK<T, Compare, Key>::TopK(int k, Compare comp, Key key) : heap(k > 0 ? k : 0, false, comp, key), k(k), comp(comp), key(key) {
+	if (k <= 0) {
+		throw std::invalid_argument("k must be positive");
+	}
+}
+
+template <class T, class Compare, class Key>
+bool TopK<T, Compare, Key>::push(T data) {
+	if (!isFull()) {
+		heap.push(data);
+		return true;
+	}
+	if (!comp(std::invoke(key, heap.peek()), std::invoke(key, data))) {
+		return false;
+	}
+	heap.pushPop(data);
+	return true;
+}
+
+template <class T, class Compare, class Key>
+int TopK<T, Compare, Key>::pushMany(const T data[], int size) {
+	int kept = 0;
+	for (int i = 0; i < size; i++) {
+		if (push(data[i])) {
+			kept++;
+		}
+	}
+	return kept;
+}
+
+template <class T, class Compare, class Key>
+int TopK<T, Compare, Key>::peekAll(T out[]) const {
+	int count = heap.topK(k, out);
+	std::reverse(out, out + count);
+	return count;
+}
+
+template <class T, class Compare, class Key>
+int TopK<T, Compare, Key>::popAll(T out[]) {
+	int count = heap.length();
+	for (int i = count - 1; i >= 0; i--) {
+		out[i] = heap.pop();
+	}
+	return count;
+}
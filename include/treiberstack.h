@@ -0,0 +1,312 @@
+/**
+ * @file treiberstack.h
+ * @brief Lock-free stack implementation using a Treiber stack with hazard pointers.
+ *
+ * This class implements a stack that any number of threads can push to and pop from
+ * concurrently. Threads publish the node they are about to pop in a hazard pointer, and
+ * popped nodes are retired rather than freed until no hazard pointer refers to them. This
+ * both reclaims memory safely and rules out the ABA problem, since a node cannot be
+ * freed and reused while another thread is comparing against it.
+ *
+ * @tparam T The data type stored in the stack.
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <atomic>
+#include <utility>
+#include "vector.h"
+
+/**
+ * @class TreiberStack
+ * @brief A lock-free stack with hazard-pointer memory reclamation.
+ *
+ * @tparam T The data type stored in the stack.
+ */
+template <class T>
+class TreiberStack {
+private:
+	// Number of retired nodes allowed per hazard record before a reclamation scan
+	static const int RECLAIM_FACTOR = 2;
+	// Number of retired nodes always allowed before a reclamation scan
+	static const int RECLAIM_MIN = 64;
+
+	/**
+	 * @struct Node
+	 * @brief A node in the stack, later reused to link it into the retired list.
+	 */
+	struct Node {
+		T data;
+		std::atomic<Node*> next;
+	};
+
+	/**
+	 * @struct HazardRecord
+	 * @brief A hazard pointer that a thread holds while it pops.
+	 *
+	 * Records are claimed through the active flag and are only freed with the stack.
+	 */
+	struct HazardRecord {
+		std::atomic<Node*> hazard;
+		std::atomic<bool> active;
+		HazardRecord* next;
+	};
+
+	std::atomic<Node*> head;
+	std::atomic<int> len;
+
+	std::atomic<HazardRecord*> records;
+	std::atomic<int> n_records;
+
+	std::atomic<Node*> retired;
+	std::atomic<int> n_retired;
+
+	/**
+	 * @brief Links a chain of nodes onto the top of a list with a single successful CAS.
+	 * @param list The list to link onto.
+	 * @param first The first node of the chain, which becomes the new top.
+	 * @param last The last node of the chain.
+	 */
+	static void link(std::atomic<Node*>& list, Node* first, Node* last);
+
+	/**
+	 * @brief Claims an idle hazard record, or adds a new one if all are in use.
+	 * @return The claimed record.
+	 */
+	HazardRecord* acquire();
+
+	/**
+	 * @brief Retires a chain of popped nodes, scanning for reclaimable nodes if enough have built up.
+	 * @param first The first node of the chain.
+	 * @param last The last node of the chain.
+	 * @param count The number of nodes in the chain.
+	 */
+	void retire(Node* first, Node* last, int count);
+
+	/**
+	 * @brief Frees every retired node that no hazard pointer refers to.
+	 */
+	void reclaim();
+
+public:
+	/**
+	 * @brief Constructs an empty stack (O(1)).
+	 */
+	TreiberStack() : head(nullptr), len(0), records(nullptr), n_records(0), retired(nullptr), n_retired(0) {}
+
+	TreiberStack(const TreiberStack&) = delete;
+	TreiberStack& operator=(const TreiberStack&) = delete;
+
+	/**
+	 * @brief Destroys the stack and frees all of its nodes (O(n)). No thread may still be using it.
+	 */
+	~TreiberStack();
+
+	/**
+	 * @brief Pushes an element onto the stack (O(1)).
+	 * @param data The data to push onto the stack.
+	 */
+	void push(T data) { pushChain(&data, 1); }
+
+	/**
+	 * @brief Pushes an array of elements onto the stack with a single CAS, leaving the last one on top (O(k)).
+	 * @param data The array of data to push onto the stack.
+	 * @param size The size of the array.
+	 */
+	void pushChain(const T data[], int size);
+
+	/**
+	 * @brief Pops an element off the stack if there is one (O(1)).
+	 * @param out Receives the popped element.
+	 * @return True if an element was popped, false if the stack was empty.
+	 */
+	bool pop(T& out);
+
+	/**
+	 * @brief Detaches every element from the stack with a single exchange (O(n)).
+	 * @return A new vector of the detached elements, from top to bottom.
+	 */
+	Vector<T>* popAll();
+
+	/**
+	 * @brief Returns a snapshot of the length of the stack (O(1)).
+	 * @return The length of the stack.
+	 */
+	int length() const { return len.load(std::memory_order_relaxed); }
+
+	/**
+	 * @brief Checks if the stack is empty at the time of the call (O(1)).
+	 * @return True if the stack is empty, false otherwise.
+	 */
+	bool isEmpty() const { return head.load(std::memory_order_acquire) == nullptr; }
+};
+
+
+template <class T>
+TreiberStack<T>::~TreiberStack() {
+	Node* lists[] = {head.load(), retired.load()};
+	for (Node* curr : lists) {
+		while (curr != nullptr) {
+			Node* temp = curr->next.load(std::memory_order_relaxed);
+			delete curr;
+			curr = temp;
+		}
+	}
+	HazardRecord* rec = records.load();
+	while (rec != nullptr) {
+		HazardRecord* temp = rec->next;
+		delete rec;
+		rec = temp;
+	}
+}
+
+template <class T>
+void TreiberStack<T>::link(std::atomic<Node*>& list, Node* first, Node* last) {
+	Node* top = list.load(std::memory_order_relaxed);
+	do {
+		last->next.store(top, std::memory_order_relaxed);
+	} while (!list.compare_exchange_weak(top, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <class T>
+typename TreiberStack<T>::HazardRecord* TreiberStack<T>::acquire() {
+	for (HazardRecord* rec = records.load(std::memory_order_acquire); rec != nullptr; rec = rec->next) {
+		bool idle = false;
+		if (!rec->active.load(std::memory_order_relaxed) && rec->active.compare_exchange_strong(idle, true, std::memory_order_acquire)) {
+			return rec;
+		}
+	}
+
+	HazardRecord* rec = new HazardRecord;
+	rec->hazard.store(nullptr, std::memory_order_relaxed);
+	rec->active.store(true, std::memory_order_relaxed);
+	rec->next = records.load(std::memory_order_relaxed);
+	while (!records.compare_exchange_weak(rec->next, rec, std::memory_order_release, std::memory_order_relaxed)) {}
+	n_records.fetch_add(1, std::memory_order_relaxed);
+	return rec;
+}
+
+template <class T>
+void TreiberStack<T>::retire(Node* first, Node* last, int count) {
+	link(retired, first, last);
+	int pending = n_retired.fetch_add(count, std::memory_order_relaxed) + count;
+	if (pending > RECLAIM_MIN + RECLAIM_FACTOR * n_records.load(std::memory_order_relaxed)) {
+		reclaim();
+	}
+}
+
+template <class T>
+void TreiberStack<T>::reclaim() {
+	Node* curr = retired.exchange(nullptr, std::memory_order_acquire);
+	if (curr == nullptr) {
+		return;
+	}
+
+	// Orders the unlinking of every retired node before the scan, against the readers' seq_cst
+	// publish and revalidate: a reader either sees the node unlinked or has its hazard seen here
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	Vector<Node*> hazards;
+	for (HazardRecord* rec = records.load(std::memory_order_acquire); rec != nullptr; rec = rec->next) {
+		Node* hazard = rec->hazard.load(std::memory_order_seq_cst);
+		if (hazard != nullptr) {
+			hazards.push(hazard);
+		}
+	}
+
+	Node* kept_first = nullptr;
+	Node* kept_last = nullptr;
+	int freed = 0;
+	int kept = 0;
+	while (curr != nullptr) {
+		Node* temp = curr->next.load(std::memory_order_relaxed);
+		if (hazards.contains(curr)) {
+			curr->next.store(kept_first, std::memory_order_relaxed);
+			kept_first = curr;
+			if (kept_last == nullptr) {
+				kept_last = curr;
+			}
+			kept++;
+		} else {
+			delete curr;
+			freed++;
+		}
+		curr = temp;
+	}
+
+	n_retired.fetch_sub(freed + kept, std::memory_order_relaxed);
+	if (kept_first != nullptr) {
+		link(retired, kept_first, kept_last);
+		n_retired.fetch_add(kept, std::memory_order_relaxed);
+	}
+}
+
+template <class T>
+void TreiberStack<T>::pushChain(const T data[], int size) {
+	if (size <= 0) {
+		return;
+	}
+	Node* first = nullptr;
+	Node* last = nullptr;
+	for (int i = 0; i < size; i++) {
+		Node* node = new Node;
+		node->data = data[i];
+		node->next.store(first, std::memory_order_relaxed);
+		first = node;
+		if (last == nullptr) {
+			last = node;
+		}
+	}
+	link(head, first, last);
+	len.fetch_add(size, std::memory_order_relaxed);
+}
+
+template <class T>
+bool TreiberStack<T>::pop(T& out) {
+	HazardRecord* rec = acquire();
+	Node* top = head.load(std::memory_order_acquire);
+	while (top != nullptr) {
+		rec->hazard.store(top, std::memory_order_seq_cst);
+		// The node is only safe to dereference once it is known to still be the head after being published
+		Node* check = head.load(std::memory_order_seq_cst);
+		if (check != top) {
+			top = check;
+			continue;
+		}
+		Node* next = top->next.load(std::memory_order_relaxed);
+		if (head.compare_exchange_weak(top, next, std::memory_order_seq_cst, std::memory_order_acquire)) {
+			break;
+		}
+	}
+	rec->hazard.store(nullptr, std::memory_order_release);
+	rec->active.store(false, std::memory_order_release);
+
+	if (top == nullptr) {
+		return false;
+	}
+	len.fetch_sub(1, std::memory_order_relaxed);
+	out = std::move(top->data);
+	retire(top, top, 1);
+	return true;
+}
+
+template <class T>
+Vector<T>* TreiberStack<T>::popAll() {
+	Vector<T>* result = new Vector<T>();
+	Node* first = head.exchange(nullptr, std::memory_order_seq_cst);
+	if (first == nullptr) {
+		return result;
+	}
+
+	Node* last = first;
+	int count = 0;
+	for (Node* curr = first; curr != nullptr; curr = curr->next.load(std::memory_order_relaxed)) {
+		result->push(std::move(curr->data));
+		last = curr;
+		count++;
+	}
+	len.fetch_sub(count, std::memory_order_relaxed);
+	retire(first, last, count);
+	return result;
+}
@@ -5,25 +5,31 @@
  * Features configurable growth/decay factors to balance performance and memory usage.
  * 
  * @tparam T The data type stored in the vector.
+ * @tparam Align The alignment of the element array in bytes, or 0 for the default alignment of new.
  */
 
 #pragma once
 
 #include <iostream>
 #include <stdexcept>
+#include <cstddef>
+#include <memory>
+#include <new>
 
 /**
  * @class Vector
  * @brief A dynamic array implementation using static arrays with automatic resizing.
  * 
  * @tparam T The data type stored in the vector.
+ * @tparam Align The alignment of the element array in bytes, or 0 for the default alignment of new.
  */
-template <class T>
+template <class T, std::size_t Align = 0>
 class Vector {
 private:
 	T* s_array;
 	int len;
 	int cap;
+	int reserved;
 
 	// Rate of dynamic resizing for growth operations
 	static const int GROWTH_FACTOR = 2;
@@ -33,44 +39,76 @@ private:
 	static const int MIN_CAPACITY = 1;
 
 	/**
-	 * @brief Grows the capacity of the vector by the growth factor.
+	 * @brief Allocates an array of default-initialized elements, aligned to Align bytes if it is set.
+	 * @param size The number of elements.
+	 * @return The array.
 	 */
-	void grow() {
-		cap = cap * GROWTH_FACTOR;
-		T* new_array = new T[cap];
-		for (int i = 0; i < len; i++) {
-			new_array[i] = s_array[i];
+	static T* allocate(int size) {
+		if constexpr (Align == 0) {
+			return new T[size];
+		} else {
+			T* array = static_cast<T*>(::operator new[](sizeof(T) * size, std::align_val_t(Align)));
+			try {
+				std::uninitialized_default_construct_n(array, size);
+			} catch (...) {
+				::operator delete[](array, std::align_val_t(Align));
+				throw;
+			}
+			return array;
+		}
+	}
+
+	/**
+	 * @brief Destroys and frees an array returned by allocate.
+	 * @param array The array.
+	 * @param size The number of elements it was allocated with.
+	 */
+	static void release(T* array, int size) {
+		if constexpr (Align == 0) {
+			delete[] array;
+		} else {
+			std::destroy_n(array, size);
+			::operator delete[](array, std::align_val_t(Align));
 		}
-		delete[] s_array;
-		s_array = new_array;
 	}
 
 	/**
-	 * @brief Reduces the capacity of the vector by the decay factor.
+	 * @brief Moves the elements into a new array of a given capacity.
+	 * @param capacity The new capacity, at least the length.
 	 */
-	void decay() {
-		cap = std::max(cap / DECAY_FACTOR, 1);
-		T* new_array = new T[cap];
+	void resize(int capacity) {
+		T* new_array = allocate(capacity);
 		for (int i = 0; i < len; i++) {
 			new_array[i] = s_array[i];
 		}
-		delete[] s_array;
+		release(s_array, cap);
 		s_array = new_array;
+		cap = capacity;
 	}
 
+	/**
+	 * @brief Grows the capacity of the vector by the growth factor.
+	 */
+	void grow() { resize(cap > 0 ? cap * GROWTH_FACTOR : MIN_CAPACITY); }
+
+	/**
+	 * @brief Reduces the capacity of the vector by the decay factor, never below the reserved capacity.
+	 */
+	void decay() { resize(std::max(cap / DECAY_FACTOR, reserved)); }
+
 public:
 	/**
 	 * @brief Constructs an empty vector with a capacity of 1 by default (O(1)).
 	 * @param size The initial capacity of the vector.
 	 */
-	Vector(int size = MIN_CAPACITY) : len(0), cap(size), s_array(new T[size]) {}
+	Vector(int size = MIN_CAPACITY) : s_array(allocate(size)), len(0), cap(size), reserved(MIN_CAPACITY) {}
 
 	/**
 	 * @brief Constructs a vector with elements from an array (O(n)).
 	 * @param data The array of data to initialize the vector.
 	 * @param size The size of the array.
 	 */
-	Vector(T data[], int size = 1) : len(size), cap(size), s_array(new T[size]) {
+	Vector(T data[], int size = 1) : s_array(allocate(size)), len(size), cap(size), reserved(MIN_CAPACITY) {
 		for (int i = 0; i < size; i++) {
 			s_array[i] = data[i];
 		}
@@ -79,7 +117,7 @@ public:
 	/**
 	 * @brief Destroys the vector and frees all allocated memory (O(1)).
 	 */
-	~Vector() { delete[] s_array; }
+	~Vector() { release(s_array, cap); }
 
 	/**
 	 * @brief Sets an index in the vector to a particular value (O(1)).
@@ -120,10 +158,23 @@ public:
 	void insert(int idx, T data[], int size);
 
 	/**
-	 * @brief Clears the vector and resets the length and capacity (O(1)).
+	 * @brief Grows the capacity so that it can hold at least a given number of elements, and stops it decaying below that (O(n)).
+	 * @param size The number of elements to reserve space for.
+	 */
+	void reserve(int size);
+
+	/**
+	 * @brief Clears the vector and resets the length and capacity, keeping any reserved capacity (O(1)).
 	 */
 	void clear();
 
+	/**
+	 * @brief Shortens the vector to a given length without reallocating, resetting the removed elements (O(k)).
+	 * @param size The new length, no greater than the current length.
+	 * @throws std::out_of_range If size is negative or greater than the length.
+	 */
+	void truncate(int size);
+
 	/**
 	 * @brief Reverses the vector (O(n)).
 	 */
@@ -145,6 +196,12 @@ public:
 	 */
 	int length() const { return len; }
 
+	/**
+	 * @brief Returns the number of elements the vector can hold before it must grow (O(1)).
+	 * @return The capacity of the static array.
+	 */
+	int capacity() const { return cap; }
+
 	/**
 	 * @brief Finds the first instance of a specific value in the vector (O(n)).
 	 * @param data The value to find.
@@ -180,6 +237,34 @@ public:
 	 */
 	T get(int idx) const;
 
+	/**
+	 * @brief Returns a reference to the last element in the vector (O(1)).
+	 * @return A reference to the last element, valid until the vector is next resized.
+	 * @throws std::runtime_error If the vector is empty.
+	 */
+	T& back() { if (isEmpty()) throw std::runtime_error("Cannot access the back of an empty vector"); return s_array[len - 1]; }
+
+	/**
+	 * @brief Returns a reference to the last element in the vector (O(1)).
+	 * @return A const reference to the last element.
+	 * @throws std::runtime_error If the vector is empty.
+	 */
+	const T& back() const { if (isEmpty()) throw std::runtime_error("Cannot access the back of an empty vector"); return s_array[len - 1]; }
+
+	/**
+	 * @brief Returns a reference to the value at a specific index without bounds checking (O(1)).
+	 * @param idx The index to access, which must be in bounds.
+	 * @return A reference to the value at the index, valid until the vector is next resized.
+	 */
+	T& operator[](int idx) { return s_array[idx]; }
+
+	/**
+	 * @brief Returns a reference to the value at a specific index without bounds checking (O(1)).
+	 * @param idx The index to access, which must be in bounds.
+	 * @return A const reference to the value at the index.
+	 */
+	const T& operator[](int idx) const { return s_array[idx]; }
+
 	/**
 	 * @brief Removes the last element from the vector and returns its value (O(1)).
 	 * @return The value of the last element.
@@ -203,16 +288,16 @@ public:
 	Vector<int>* findAll(T data) const;
 };
 
-template <class T>
-void Vector<T>::set(int idx, T data) {
+template <class T, std::size_t Align>
+void Vector<T, Align>::set(int idx, T data) {
 	if (idx >= len || idx < 0) {
 		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
 	}
 	s_array[idx] = data;
 }
 
-template <class T>
-void Vector<T>::insert(int idx, T data) {
+template <class T, std::size_t Align>
+void Vector<T, Align>::insert(int idx, T data) {
 	if (idx > len || idx < 0) {
 		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
 	}
@@ -231,8 +316,8 @@ void Vector<T>::insert(int idx, T data) {
 	len++;
 }
 
-template <class T>
-void Vector<T>::insert(int idx, T data[], int size) {
+template <class T, std::size_t Align>
+void Vector<T, Align>::insert(int idx, T data[], int size) {
 	if (idx > len || idx < 0) {
 		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
 	}
@@ -242,26 +327,45 @@ void Vector<T>::insert(int idx, T data[], int size) {
 	}
 }
 
-template <class T>
-void Vector<T>::clear() {
-	delete[] s_array;
+template <class T, std::size_t Align>
+void Vector<T, Align>::reserve(int size) {
+	reserved = size > MIN_CAPACITY ? size : MIN_CAPACITY;
+	if (reserved > cap) {
+		resize(reserved);
+	}
+}
+
+template <class T, std::size_t Align>
+void Vector<T, Align>::clear() {
+	release(s_array, cap);
 	len = 0;
-	cap = MIN_CAPACITY;
-	s_array = new T[cap];
+	cap = reserved;
+	s_array = allocate(cap);
+}
+
+template <class T, std::size_t Align>
+void Vector<T, Align>::truncate(int size) {
+	if (size < 0 || size > len) {
+		throw std::out_of_range("Length " + std::to_string(size) + " out of bounds");
+	}
+	for (int i = size; i < len; i++) {
+		s_array[i] = T();
+	}
+	len = size;
 }
 
-template <class T>
-void Vector<T>::reverse() {
-	T* new_array = new T[cap];
+template <class T, std::size_t Align>
+void Vector<T, Align>::reverse() {
+	T* new_array = allocate(cap);
 	for (int i = 0; i < len; i++) {
 		new_array[i] = s_array[len - i - 1];
 	}
-	delete[] s_array;
+	release(s_array, cap);
 	s_array = new_array;
 }
 
-template <class T>
-void Vector<T>::show() const {
+template <class T, std::size_t Align>
+void Vector<T, Align>::show() const {
 	for (int i = 0; i < len; i++) {
 		if (i != 0) {
 			std::cout << ", ";
@@ -271,8 +375,8 @@ void Vector<T>::show() const {
 	std::cout << std::endl;
 }
 
-template <class T>
-void Vector<T>::debug() const {
+template <class T, std::size_t Align>
+void Vector<T, Align>::debug() const {
 	for (int i = 0; i < cap; i++) {
 		if (i < len) {
 			std::cout << "|" << s_array[i] << ": " << &s_array[i] << "|" << " ";
@@ -283,8 +387,8 @@ void Vector<T>::debug() const {
 	std::cout << std::endl;
 }
 
-template <class T>
-int Vector<T>::find(T data) const {
+template <class T, std::size_t Align>
+int Vector<T, Align>::find(T data) const {
 	for (int i = 0; i < len; i++) {
 		if (s_array[i] == data) {
 			return i;
@@ -293,8 +397,8 @@ int Vector<T>::find(T data) const {
 	return -1;
 }
 
-template <class T>
-bool Vector<T>::removeValue(T data) {
+template <class T, std::size_t Align>
+bool Vector<T, Align>::removeValue(T data) {
 	int idx = find(data);
 	if (idx == -1) {
 		return false;
@@ -303,16 +407,16 @@ bool Vector<T>::removeValue(T data) {
 	return true;
 }
 
-template <class T>
-T Vector<T>::get(int idx) const {
+template <class T, std::size_t Align>
+T Vector<T, Align>::get(int idx) const {
 	if (idx >= len || idx < 0) {
 		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
 	}
 	return s_array[idx];
 }
 
-template <class T>
-T Vector<T>::pop() {
+template <class T, std::size_t Align>
+T Vector<T, Align>::pop() {
 	if (isEmpty()) {
 		throw std::runtime_error("Cannot pop from an empty vector");
 	}
@@ -320,15 +424,15 @@ T Vector<T>::pop() {
 	T data = s_array[len - 1];
 	len--;
 	
-	if (len > 0 && len <= cap / DECAY_FACTOR) {
+	if (len > 0 && len <= cap / DECAY_FACTOR && cap > reserved) {
 		decay();
 	}
 	
 	return data;
 }
 
-template <class T>
-T Vector<T>::remove(int idx) {
+template <class T, std::size_t Align>
+T Vector<T, Align>::remove(int idx) {
 	if (idx >= len || idx < 0) {
 		throw std::out_of_range("Index " + std::to_string(idx) + " out of bounds");
 	}
@@ -339,15 +443,15 @@ T Vector<T>::remove(int idx) {
 	}
 	len--;
 	
-	if (len > 0 && len <= cap / DECAY_FACTOR) {
+	if (len > 0 && len <= cap / DECAY_FACTOR && cap > reserved) {
 		decay();
 	}
 	
 	return data;
 }
 
-template <class T>
-Vector<int>* Vector<T>::findAll(T data) const {
+template <class T, std::size_t Align>
+Vector<int>* Vector<T, Align>::findAll(T data) const {
 	Vector<int>* result = new Vector<int>();
 	for (int i = 0; i < len; i++) {
 		if (s_array[i] == data) {
@@ -0,0 +1,212 @@
+/**
+ * @file wsdeque.h
+ * @brief Lock-free work-stealing deque using a growable circular array.
+ *
+ * This class implements the Chase-Lev deque with the memory orderings of Le et al.
+ * The owning thread pushes and pops at the bottom like a stack, keeping its most recent
+ * work hot in cache, while any other thread may steal the oldest element from the top.
+ * Only a steal racing the owner for the last element needs a compare-and-swap.
+ *
+ * @tparam T The data type stored in the deque, which must be trivially copyable (typically a pointer).
+ */
+
+#pragma once
+
+#include <iostream>
+#include <stdexcept>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @class WorkStealingDeque
+ * @brief A lock-free deque with one owner working at the bottom and any number of thieves at the top.
+ *
+ * Only the owner may call push and pop. Any thread may call steal, length and isEmpty.
+ * Arrays replaced by growth are kept until the deque is destroyed, because a thief may
+ * still be reading from them.
+ *
+ * @tparam T The data type stored in the deque.
+ */
+template <class T>
+class WorkStealingDeque {
+	static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque elements must be trivially copyable");
+
+private:
+	// Assumed size of a cache line, used to keep the two indices from false sharing
+	static const std::size_t CACHE_LINE = 64;
+	// Rate of dynamic resizing for growth operations
+	static const int GROWTH_FACTOR = 2;
+
+	/**
+	 * @struct Array
+	 * @brief A circular array of atomic slots, chained to the array it replaced.
+	 */
+	struct Array {
+		std::int64_t cap;
+		std::int64_t mask;
+		std::atomic<T>* s_array;
+		Array* prev;
+
+		Array(std::int64_t cap, Array* prev) : cap(cap), mask(cap - 1), s_array(new std::atomic<T>[cap]), prev(prev) {}
+		~Array() { delete[] s_array; }
+
+		T get(std::int64_t idx) const { return s_array[idx & mask].load(std::memory_order_relaxed); }
+		void put(std::int64_t idx, T data) { s_array[idx & mask].store(data, std::memory_order_relaxed); }
+	};
+
+	alignas(CACHE_LINE) std::atomic<std::int64_t> top;
+	alignas(CACHE_LINE) std::atomic<std::int64_t> bottom;
+	std::atomic<Array*> array;
+
+	/**
+	 * @brief Replaces the array with one twice as large, copying the live range across.
+	 * @param old The current array.
+	 * @param b The bottom index.
+	 * @param t The top index.
+	 * @return The new array.
+	 */
+	Array* grow(Array* old, std::int64_t b, std::int64_t t);
+
+public:
+	/**
+	 * @brief Constructs an empty deque (O(n)).
+	 * @param size The initial capacity, rounded up to a power of two.
+	 */
+	WorkStealingDeque(int size = 64);
+
+	WorkStealingDeque(const WorkStealingDeque&) = delete;
+	WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+	/**
+	 * @brief Destroys the deque and every array it has used (O(1)).
+	 */
+	~WorkStealingDeque();
+
+	/**
+	 * @brief Pushes an element onto the bottom of the deque (amortized O(1)). Owner only.
+	 * @param data The data to push.
+	 */
+	void push(T data);
+
+	/**
+	 * @brief Pops the most recently pushed element from the bottom of the deque (O(1)). Owner only.
+	 * @param out Receives the popped element.
+	 * @return True if an element was popped, false if the deque was empty.
+	 */
+	bool pop(T& out);
+
+	/**
+	 * @brief Steals the oldest element from the top of the deque (O(1)).
+	 * @param out Receives the stolen element.
+	 * @return True if an element was stolen, false if the deque was empty or another thread won the race.
+	 */
+	bool steal(T& out);
+
+	/**
+	 * @brief Returns a snapshot of the length of the deque (O(1)).
+	 * @return The number of elements in the deque.
+	 */
+	int length() const;
+
+	/**
+	 * @brief Returns the capacity of the current array (O(1)).
+	 * @return The number of elements the deque can hold before growing.
+	 */
+	int capacity() const { return static_cast<int>(array.load(std::memory_order_relaxed)->cap); }
+
+	/**
+	 * @brief Checks if the deque is empty at the time of the call (O(1)).
+	 * @return True if the deque is empty, false otherwise.
+	 */
+	bool isEmpty() const { return length() == 0; }
+};
+
+
+template <class T>
+WorkStealingDeque<T>::WorkStealingDeque(int size) : top(0), bottom(0), array(nullptr) {
+	std::int64_t cap = 1;
+	while (cap < size) {
+		cap *= GROWTH_FACTOR;
+	}
+	array.store(new Array(cap, nullptr), std::memory_order_relaxed);
+}
+
+template <class T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+	Array* curr = array.load(std::memory_order_relaxed);
+	while (curr != nullptr) {
+		Array* temp = curr->prev;
+		delete curr;
+		curr = temp;
+	}
+}
+
+template <class T>
+typename WorkStealingDeque<T>::Array* WorkStealingDeque<T>::grow(Array* old, std::int64_t b, std::int64_t t) {
+	Array* new_array = new Array(old->cap * GROWTH_FACTOR, old);
+	for (std::int64_t i = t; i < b; i++) {
+		new_array->put(i, old->get(i));
+	}
+	array.store(new_array, std::memory_order_release);
+	return new_array;
+}
+
+template <class T>
+void WorkStealingDeque<T>::push(T data) {
+	std::int64_t b = bottom.load(std::memory_order_relaxed);
+	std::int64_t t = top.load(std::memory_order_acquire);
+	Array* a = array.load(std::memory_order_relaxed);
+	if (b - t > a->cap - 1) {
+		a = grow(a, b, t);
+	}
+	a->put(b, data);
+	std::atomic_thread_fence(std::memory_order_release);
+	bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+template <class T>
+bool WorkStealingDeque<T>::pop(T& out) {
+	std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+	Array* a = array.load(std::memory_order_relaxed);
+	bottom.store(b, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t t = top.load(std::memory_order_relaxed);
+
+	if (t > b) {
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return false;
+	}
+	out = a->get(b);
+	if (t == b) {
+		// Last element: race any thief for it by advancing top
+		bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return won;
+	}
+	return true;
+}
+
+template <class T>
+bool WorkStealingDeque<T>::steal(T& out) {
+	std::int64_t t = top.load(std::memory_order_acquire);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	std::int64_t b = bottom.load(std::memory_order_acquire);
+	if (t >= b) {
+		return false;
+	}
+	Array* a = array.load(std::memory_order_acquire);
+	T data = a->get(t);
+	if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+		return false;
+	}
+	out = data;
+	return true;
+}
+
+template <class T>
+int WorkStealingDeque<T>::length() const {
+	std::int64_t b = bottom.load(std::memory_order_acquire);
+	std::int64_t t = top.load(std::memory_order_acquire);
+	return b > t ? static_cast<int>(b - t) : 0;
+}
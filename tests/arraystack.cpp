@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+TEST(ArrayStack, Constructor) {
+    ArrayStack<int> stack;
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_EQ(stack.length(), 0);
+}
+
+TEST(ArrayStack, SingleElementConstructor) {
+    ArrayStack<int> stack(42);
+    EXPECT_FALSE(stack.isEmpty());
+    EXPECT_EQ(stack.length(), 1);
+    EXPECT_EQ(stack.peek(), 42);
+}
+
+TEST(ArrayStack, ArrayConstructor) {
+    int values[] = {1, 2, 3, 4, 5};
+    ArrayStack<int> stack(values, 5);
+
+    EXPECT_EQ(stack.length(), 5);
+
+    for(int i = 0; i < 5; i++) {
+        EXPECT_EQ(stack.pop(), 5 - i);
+    }
+}
+
+TEST(ArrayStack, Push) {
+    ArrayStack<int> stack;
+
+    stack.push(1);
+    stack.push(2);
+    stack.push(3);
+
+    EXPECT_EQ(stack.length(), 3);
+    EXPECT_EQ(stack.peek(), 3);
+}
+
+TEST(ArrayStack, Pop) {
+    ArrayStack<int> stack;
+
+    stack.push(1);
+    stack.push(2);
+    stack.push(3);
+
+    EXPECT_EQ(stack.pop(), 3);
+    EXPECT_EQ(stack.pop(), 2);
+    EXPECT_EQ(stack.pop(), 1);
+    EXPECT_TRUE(stack.isEmpty());
+
+    EXPECT_THROW(stack.pop(), std::runtime_error);
+}
+
+TEST(ArrayStack, Peek) {
+    ArrayStack<int> stack;
+
+    stack.push(1);
+    stack.push(2);
+
+    EXPECT_EQ(stack.peek(), 2);
+    stack.peek() = 5;
+    EXPECT_EQ(stack.pop(), 5);
+    EXPECT_EQ(stack.peek(), 1);
+
+    const ArrayStack<int>& view = stack;
+    EXPECT_EQ(view.peek(), 1);
+
+    ArrayStack<int> empty;
+    EXPECT_THROW(empty.peek(), std::runtime_error);
+    const ArrayStack<int>& empty_view = empty;
+    EXPECT_THROW(empty_view.peek(), std::runtime_error);
+}
+
+TEST(ArrayStack, Reserve) {
+    ArrayStack<int> stack;
+    stack.reserve(100);
+    EXPECT_EQ(stack.capacity(), 100);
+
+    for (int i = 0; i < 100; i++) {
+        stack.push(i);
+    }
+    EXPECT_EQ(stack.capacity(), 100);
+
+    while (!stack.isEmpty()) {
+        stack.pop();
+    }
+    EXPECT_EQ(stack.capacity(), 100);
+
+    stack.push(1);
+    stack.clear();
+    EXPECT_EQ(stack.capacity(), 100);
+}
+
+TEST(ArrayStack, Contains) {
+    int values[] = {1, 2, 3};
+    ArrayStack<int> stack(values, 3);
+
+    EXPECT_TRUE(stack.contains(2));
+    EXPECT_FALSE(stack.contains(4));
+}
+
+TEST(ArrayStack, Clear) {
+    ArrayStack<int> stack;
+
+    stack.push(1);
+    stack.push(2);
+    stack.push(3);
+
+    stack.clear();
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_EQ(stack.length(), 0);
+}
+
+TEST(ArrayStack, LargeOperations) {
+    ArrayStack<int> stack;
+
+    for(int i = 0; i < 1000; i++) {
+        stack.push(i);
+    }
+
+    EXPECT_EQ(stack.length(), 1000);
+
+    for(int i = 999; i >= 0; i--) {
+        EXPECT_EQ(stack.pop(), i);
+    }
+
+    EXPECT_TRUE(stack.isEmpty());
+}
@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+TEST(BlockingQueue, Constructor) {
+    BlockingQueue<int> queue;
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.length(), 0);
+    EXPECT_EQ(queue.capacity(), 0);
+    EXPECT_FALSE(queue.isClosed());
+
+    EXPECT_EQ(BlockingQueue<int>(8).capacity(), 8);
+    EXPECT_THROW(BlockingQueue<int>(-1), std::invalid_argument);
+}
+
+TEST(BlockingQueue, PushPop) {
+    BlockingQueue<int> queue;
+
+    EXPECT_TRUE(queue.push(1));
+    EXPECT_TRUE(queue.push(2));
+    EXPECT_EQ(queue.length(), 2);
+
+    EXPECT_EQ(queue.pop(), 1);
+    int out;
+    EXPECT_TRUE(queue.tryPop(out));
+    EXPECT_EQ(out, 2);
+    EXPECT_FALSE(queue.tryPop(out));
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(BlockingQueue, Bounded) {
+    BlockingQueue<int> queue(2);
+
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_FALSE(queue.tryPush(3));
+    EXPECT_EQ(queue.length(), 2);
+}
+
+TEST(BlockingQueue, PopFor) {
+    BlockingQueue<int> queue;
+    int out = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(queue.popFor(std::chrono::milliseconds(20), out));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    queue.push(7);
+    EXPECT_TRUE(queue.popFor(std::chrono::milliseconds(20), out));
+    EXPECT_EQ(out, 7);
+}
+
+TEST(BlockingQueue, PopMany) {
+    BlockingQueue<int> queue;
+    int out[8];
+
+    for (int i = 0; i < 5; i++) {
+        queue.push(i);
+    }
+
+    EXPECT_EQ(queue.popMany(3, out), 3);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[2], 2);
+    EXPECT_EQ(queue.popMany(8, out), 2);
+    EXPECT_EQ(out[0], 3);
+    EXPECT_EQ(out[1], 4);
+    EXPECT_EQ(queue.popMany(0, out), 0);
+}
+
+TEST(BlockingQueue, Close) {
+    BlockingQueue<int> queue;
+    queue.push(1);
+    queue.push(2);
+    queue.close();
+
+    EXPECT_TRUE(queue.isClosed());
+    EXPECT_FALSE(queue.push(3));
+    EXPECT_FALSE(queue.tryPush(3));
+
+    EXPECT_EQ(queue.pop(), 1);
+    int out[4];
+    EXPECT_EQ(queue.popMany(4, out), 1);
+    EXPECT_EQ(out[0], 2);
+
+    EXPECT_THROW(queue.pop(), std::runtime_error);
+    EXPECT_EQ(queue.popMany(4, out), 0);
+    EXPECT_FALSE(queue.popFor(std::chrono::seconds(10), out[0]));
+}
+
+TEST(BlockingQueue, CloseWakesConsumers) {
+    BlockingQueue<int> queue;
+    std::atomic<int> woken(0);
+    std::vector<std::thread> consumers;
+
+    for (int i = 0; i < 4; i++) {
+        consumers.emplace_back([&]() {
+            int out[4];
+            if (queue.popMany(4, out) == 0) {
+                woken++;
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.close();
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+
+    EXPECT_EQ(woken.load(), 4);
+}
+
+TEST(BlockingQueue, BackPressure) {
+    const int count = 10000;
+    BlockingQueue<int> queue(4);
+    std::atomic<int> max_length(0);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < count; i++) {
+            queue.push(i);
+            int len = queue.length();
+            int seen = max_length.load();
+            while (len > seen && !max_length.compare_exchange_weak(seen, len)) {}
+        }
+        queue.close();
+    });
+
+    int expected = 0;
+    bool ordered = true;
+    int out[3];
+    while (true) {
+        int got = queue.popMany(3, out);
+        if (got == 0) {
+            break;
+        }
+        for (int i = 0; i < got; i++) {
+            ordered = ordered && out[i] == expected++;
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(expected, count);
+    EXPECT_LE(max_length.load(), 4);
+}
+
+TEST(BlockingQueue, ManyThreads) {
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 5000;
+    BlockingQueue<int> queue(16);
+    std::atomic<long long> sum(0);
+    std::atomic<int> received(0);
+    std::vector<std::thread> threads;
+
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&]() {
+            while (true) {
+                int out;
+                try {
+                    out = queue.pop();
+                } catch (const std::runtime_error&) {
+                    return;
+                }
+                sum += out;
+                received++;
+            }
+        });
+    }
+
+    std::vector<std::thread> producer_threads;
+    for (int p = 0; p < producers; p++) {
+        producer_threads.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; i++) {
+                queue.push(p * per_producer + i);
+            }
+        });
+    }
+    for (std::thread& thread : producer_threads) {
+        thread.join();
+    }
+    queue.close();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    long long total = (long long)producers * per_producer;
+    EXPECT_EQ(received.load(), total);
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+}
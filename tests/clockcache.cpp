@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../include/strux.h"
+
+TEST(ClockCache, Constructor) {
+    ClockCache<int, int> cache(3);
+    EXPECT_TRUE(cache.isEmpty());
+    EXPECT_EQ(cache.length(), 0);
+    EXPECT_EQ(cache.capacity(), 3);
+    EXPECT_THROW((ClockCache<int, int>(0)), std::invalid_argument);
+}
+
+TEST(ClockCache, GetAndPut) {
+    ClockCache<std::string, int> cache(4);
+    EXPECT_TRUE(cache.put("one", 1));
+    EXPECT_TRUE(cache.put("two", 2));
+    EXPECT_FALSE(cache.put("one", 11));
+    EXPECT_EQ(cache.length(), 2);
+
+    int* value = cache.get(std::string("one"));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 11);
+    EXPECT_EQ(cache.get(std::string("three")), nullptr);
+    EXPECT_EQ(*cache.peek(std::string("two")), 2);
+    EXPECT_TRUE(cache.contains(std::string("two")));
+}
+
+TEST(ClockCache, SecondChance) {
+    ClockCache<int, int> cache(3);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+    // 1 and 3 are referenced, so the hand passes them and takes 2
+    cache.get(1);
+    cache.get(3);
+    cache.put(4, 40);
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+
+    // The hand cleared 1 on its way and now clears 3, so 1 goes without a second chance
+    cache.put(5, 50);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_TRUE(cache.contains(4));
+    EXPECT_EQ(cache.length(), 3);
+}
+
+TEST(ClockCache, ScanResistance) {
+    // Entries used between scans survive a stream of one-off keys
+    ClockCache<int, int> cache(8);
+    for (int i = 0; i < 4; i++) {
+        cache.put(i, i);
+    }
+    for (int round = 0; round < 50; round++) {
+        for (int i = 0; i < 4; i++) {
+            ASSERT_NE(cache.get(i), nullptr);
+        }
+        cache.put(1000 + round, round);
+    }
+    EXPECT_EQ(cache.length(), 8);
+}
+
+TEST(ClockCache, EvictionCallbackAndWeight) {
+    std::vector<int> evicted;
+    ClockCache<int, std::string> cache(6, [](const int&, const std::string& value) { return static_cast<std::int64_t>(value.size()); }, [&](const int& key, const std::string&) { evicted.push_back(key); });
+    cache.put(1, "aa");
+    cache.put(2, "bb");
+    cache.put(3, "cc");
+    cache.put(4, "dddd");
+    EXPECT_EQ(evicted, (std::vector<int>{1, 2}));
+    EXPECT_EQ(cache.weight(), 6);
+
+    // Growing a value evicts others, never the value itself
+    cache.put(4, "dddddd");
+    EXPECT_EQ(evicted, (std::vector<int>{1, 2, 3}));
+    EXPECT_EQ(cache.length(), 1);
+    EXPECT_THROW(cache.put(5, "eeeeeee"), std::invalid_argument);
+
+    cache.remove(4);
+    cache.clear();
+    EXPECT_EQ(evicted.size(), 3u);
+    EXPECT_EQ(cache.weight(), 0);
+}
+
+TEST(ClockCache, RandomOperations) {
+    const int capacity = 50;
+    ClockCache<int, int> cache(capacity);
+    std::vector<int> latest(300, -1);
+    std::mt19937 rng(11);
+    for (int i = 0; i < 100000; i++) {
+        int key = static_cast<int>(rng() % latest.size());
+        int op = static_cast<int>(rng() % 10);
+        if (op < 5) {
+            int* value = cache.get(key);
+            // An entry that is present always holds its latest value
+            if (value != nullptr) {
+                ASSERT_EQ(*value, latest[key]);
+            }
+        } else if (op == 5) {
+            cache.remove(key);
+        } else {
+            bool present = cache.contains(key);
+            EXPECT_EQ(cache.put(key, i), !present);
+            latest[key] = i;
+        }
+        ASSERT_LE(cache.length(), capacity);
+        ASSERT_EQ(cache.weight(), cache.length());
+    }
+}
+
+TEST(ClockCache, ReleasesEvictedValues) {
+    // Evicted and removed values are destroyed straight away, not when their slot is reused
+    std::shared_ptr<int> tracked = std::make_shared<int>(1);
+    ClockCache<int, std::shared_ptr<int>> cache(2);
+    cache.put(1, tracked);
+    EXPECT_EQ(tracked.use_count(), 2);
+    cache.put(2, nullptr);
+    cache.put(3, nullptr);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(tracked.use_count(), 1);
+
+    cache.put(4, tracked);
+    EXPECT_EQ(tracked.use_count(), 2);
+    cache.remove(4);
+    EXPECT_EQ(tracked.use_count(), 1);
+}
@@ -0,0 +1,255 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "../include/strux.h"
+
+struct Point {
+    std::int64_t x;
+    std::int64_t y;
+    std::int64_t z;
+
+    bool operator==(const Point& other) const { return x == other.x && y == other.y && z == other.z; }
+};
+
+struct PointHash {
+    std::size_t operator()(const Point& point) const { return static_cast<std::size_t>(point.x * 73856093 ^ point.y * 19349663 ^ point.z * 83492791); }
+};
+
+TEST(ConcurrentHashMap, Constructor) {
+    ConcurrentHashMap<int, int> map(8);
+    EXPECT_EQ(map.shardCount(), 8);
+    EXPECT_TRUE(map.isEmpty());
+
+    ConcurrentHashMap<int, int> hardware;
+    EXPECT_GE(hardware.shardCount(), 4);
+
+    EXPECT_THROW((ConcurrentHashMap<int, int>(-1)), std::invalid_argument);
+}
+
+TEST(ConcurrentHashMap, InsertSetFind) {
+    ConcurrentHashMap<int, double> map(4);
+    EXPECT_TRUE(map.insert(1, 1.5));
+    EXPECT_FALSE(map.insert(1, 9.0));
+    EXPECT_TRUE(map.set(2, 2.5));
+    EXPECT_FALSE(map.set(2, 3.5));
+    EXPECT_EQ(map.length(), 2);
+
+    double value = 0;
+    EXPECT_TRUE(map.find(1, value));
+    EXPECT_EQ(value, 1.5);
+    EXPECT_TRUE(map.find(2, value));
+    EXPECT_EQ(value, 3.5);
+    EXPECT_FALSE(map.find(3, value));
+    EXPECT_TRUE(map.contains(2));
+    EXPECT_FALSE(map.contains(3));
+}
+
+TEST(ConcurrentHashMap, RemoveAndGrowth) {
+    ConcurrentHashMap<std::uint64_t, std::uint64_t> map(2);
+    for (std::uint64_t i = 0; i < 10000; i++) {
+        map.insert(i, i * 3);
+    }
+    EXPECT_EQ(map.length(), 10000);
+    for (std::uint64_t i = 0; i < 10000; i += 3) {
+        EXPECT_TRUE(map.remove(i));
+    }
+    EXPECT_FALSE(map.remove(0));
+    for (std::uint64_t i = 0; i < 10000; i++) {
+        std::uint64_t value;
+        ASSERT_EQ(map.find(i, value), i % 3 != 0);
+        if (i % 3 != 0) {
+            ASSERT_EQ(value, i * 3);
+        }
+    }
+}
+
+TEST(ConcurrentHashMap, MatchesUnorderedMap) {
+    std::mt19937 rng(31);
+    ConcurrentHashMap<int, int> map(4);
+    std::unordered_map<int, int> reference;
+    for (int i = 0; i < 50000; i++) {
+        int key = static_cast<int>(rng() % 1500);
+        switch (rng() % 3) {
+        case 0:
+            ASSERT_EQ(map.set(key, i), reference.insert_or_assign(key, i).second);
+            break;
+        case 1:
+            ASSERT_EQ(map.remove(key), reference.erase(key) > 0);
+            break;
+        default: {
+            int value;
+            ASSERT_EQ(map.find(key, value), reference.count(key) > 0);
+            if (reference.count(key) > 0) {
+                ASSERT_EQ(value, reference[key]);
+            }
+        }
+        }
+    }
+    EXPECT_EQ(map.length(), static_cast<int>(reference.size()));
+}
+
+TEST(ConcurrentHashMap, WideKeys) {
+    ConcurrentHashMap<Point, Point, PointHash> map(4);
+    for (int i = 0; i < 1000; i++) {
+        map.set({i, -i, i * i}, {i * 2, i * 3, i * 4});
+    }
+    for (int i = 0; i < 1000; i++) {
+        Point value;
+        ASSERT_TRUE(map.find({i, -i, i * i}, value));
+        ASSERT_EQ(value, (Point{i * 2, i * 3, i * 4}));
+    }
+    EXPECT_FALSE(map.contains({1, 1, 1}));
+}
+
+TEST(ConcurrentHashMap, InsertManyFindMany) {
+    ConcurrentHashMap<int, int> map(8);
+    std::vector<int> keys(5000);
+    std::vector<int> values(5000);
+    for (int i = 0; i < 5000; i++) {
+        keys[i] = i * 7;
+        values[i] = i;
+    }
+    EXPECT_EQ(map.insertMany(keys.data(), values.data(), 5000), 5000);
+    EXPECT_EQ(map.insertMany(keys.data(), values.data(), 100), 0);
+    EXPECT_EQ(map.length(), 5000);
+    EXPECT_EQ(map.insertMany(keys.data(), values.data(), 0), 0);
+
+    std::vector<int> lookups(6000);
+    for (int i = 0; i < 6000; i++) {
+        lookups[i] = i * 7;
+    }
+    std::vector<int> out(6000, -1);
+    bool* found = new bool[6000];
+    EXPECT_EQ(map.findMany(lookups.data(), 6000, out.data(), found), 5000);
+    for (int i = 0; i < 6000; i++) {
+        ASSERT_EQ(found[i], i < 5000);
+        if (i < 5000) {
+            ASSERT_EQ(out[i], i);
+        }
+    }
+    delete[] found;
+}
+
+TEST(ConcurrentHashMap, ReserveAndClear) {
+    ConcurrentHashMap<int, int> map(4);
+    map.reserve(10000);
+    for (int i = 0; i < 1000; i++) {
+        map.insert(i, i);
+    }
+    map.clear();
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.contains(5));
+    map.insert(5, 50);
+    int value;
+    EXPECT_TRUE(map.find(5, value));
+    EXPECT_EQ(value, 50);
+}
+
+TEST(ConcurrentHashMap, UpdatesDoNotGrow) {
+    // One shard of 16 slots holds 14 entries at its maximum load
+    ConcurrentHashMap<int, int> map(1);
+    int keys[14];
+    int values[14];
+    for (int i = 0; i < 14; i++) {
+        keys[i] = i;
+        values[i] = i * 2;
+        map.insert(i, i);
+    }
+    int capacity = map.capacity();
+    EXPECT_EQ(capacity, 16);
+
+    for (int i = 0; i < 14; i++) {
+        EXPECT_FALSE(map.set(i, i + 1));
+    }
+    EXPECT_EQ(map.insertMany(keys, values, 14), 0);
+    EXPECT_EQ(map.capacity(), capacity);
+    int value;
+    EXPECT_TRUE(map.find(13, value));
+    EXPECT_EQ(value, 26);
+
+    // The first new key grows the table
+    EXPECT_TRUE(map.set(14, 14));
+    EXPECT_GT(map.capacity(), capacity);
+}
+
+TEST(ConcurrentHashMap, ConcurrentReadersSeeWholeEntries) {
+    // Each value is derived from its key and a version in every word, so a torn read would show up as a mismatch
+    ConcurrentHashMap<std::uint64_t, Point> map(4);
+    const int keys = 2000;
+    for (int i = 0; i < keys; i++) {
+        map.set(i, {i, i, i});
+    }
+
+    std::atomic<bool> stop(false);
+    std::atomic<long long> bad(0);
+    std::atomic<long long> reads(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; t++) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(t);
+            std::int64_t version = 1;
+            while (!stop.load()) {
+                std::int64_t key = static_cast<std::int64_t>(rng() % (keys * 2));
+                std::int64_t tag = key + version * 100000;
+                if (rng() % 4 == 0) {
+                    map.remove(static_cast<std::uint64_t>(key));
+                } else {
+                    map.set(static_cast<std::uint64_t>(key), {tag, tag, tag});
+                }
+                version++;
+            }
+        });
+    }
+    for (int t = 0; t < 3; t++) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(100 + t);
+            for (int i = 0; i < 200000; i++) {
+                std::uint64_t key = rng() % (keys * 2);
+                Point value;
+                if (map.find(key, value)) {
+                    if (value.x != value.y || value.y != value.z || value.x % 100000 != static_cast<std::int64_t>(key)) {
+                        bad++;
+                    }
+                }
+                reads++;
+            }
+        });
+    }
+    for (int t = 2; t < 5; t++) {
+        threads[t].join();
+    }
+    stop = true;
+    threads[0].join();
+    threads[1].join();
+
+    EXPECT_EQ(bad.load(), 0);
+    EXPECT_EQ(reads.load(), 600000);
+}
+
+TEST(ConcurrentHashMap, ConcurrentWriters) {
+    ConcurrentHashMap<int, int> map(8);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 5000; i++) {
+                map.insert(t * 5000 + i, i);
+            }
+            for (int i = 0; i < 5000; i += 2) {
+                map.remove(t * 5000 + i);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(map.length(), 10000);
+    for (int key = 0; key < 20000; key++) {
+        ASSERT_EQ(map.contains(key), key % 2 == 1);
+    }
+}
@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <csignal>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <sys/resource.h>
+
+#include "../include/strux.h"
+
+struct Job {
+    int priority;
+    int id;
+};
+
+static int spillFiles(const std::filesystem::path& directory) {
+    int count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path().extension() == ".run") {
+            count++;
+        }
+    }
+    return count;
+}
+
+// A fresh directory for spill files, removed with everything in it at the end of the test
+struct ScratchDirectory {
+    std::filesystem::path path;
+
+    ScratchDirectory() : path(std::filesystem::temp_directory_path() / ("strux-test-" + std::to_string(std::random_device()()))) {
+        std::filesystem::create_directories(path);
+    }
+
+    ~ScratchDirectory() { std::filesystem::remove_all(path); }
+};
+
+TEST(ExternalPQueue, Constructor) {
+    ScratchDirectory scratch;
+    ExternalPQueue<int> pqueue(1000, scratch.path.string());
+    EXPECT_TRUE(pqueue.isEmpty());
+    EXPECT_TRUE(pqueue.isMin());
+    EXPECT_EQ(pqueue.runCount(), 0);
+    EXPECT_THROW(pqueue.pop(), std::runtime_error);
+    EXPECT_THROW(pqueue.peek(), std::runtime_error);
+
+    EXPECT_THROW(ExternalPQueue<int>(10), std::invalid_argument);
+}
+
+TEST(ExternalPQueue, InMemory) {
+    ScratchDirectory scratch;
+    ExternalPQueue<int> pqueue(1000, scratch.path.string());
+    int values[] = {5, 3, 8, 1, 9, 2};
+    for (int value : values) {
+        pqueue.push(value);
+    }
+    EXPECT_EQ(pqueue.runCount(), 0);
+    EXPECT_EQ(pqueue.peek(), 1);
+    int expected[] = {1, 2, 3, 5, 8, 9};
+    for (int value : expected) {
+        EXPECT_EQ(pqueue.pop(), value);
+    }
+    EXPECT_TRUE(pqueue.isEmpty());
+}
+
+TEST(ExternalPQueue, Spill) {
+    ScratchDirectory scratch;
+    ExternalPQueue<int> pqueue(130, scratch.path.string());
+    std::mt19937 rng(1);
+    std::vector<int> values;
+    for (int i = 0; i < 500; i++) {
+        int value = static_cast<int>(rng() % 1000);
+        pqueue.push(value);
+        values.push_back(value);
+    }
+    EXPECT_GT(pqueue.runCount(), 0);
+    EXPECT_EQ(spillFiles(scratch.path), pqueue.runCount());
+    EXPECT_EQ(pqueue.length(), 500u);
+    EXPECT_GE(pqueue.spilled(), 440u);
+
+    std::sort(values.begin(), values.end());
+    for (int value : values) {
+        EXPECT_EQ(pqueue.peek(), value);
+        ASSERT_EQ(pqueue.pop(), value);
+    }
+    EXPECT_TRUE(pqueue.isEmpty());
+    EXPECT_EQ(pqueue.runCount(), 0);
+    EXPECT_EQ(spillFiles(scratch.path), 0);
+}
+
+TEST(ExternalPQueue, MergesRuns) {
+    ScratchDirectory scratch;
+    // 130 elements of memory gives 64 per run, so 2000 elements fill level 0 and merge it
+    ExternalPQueue<int> pqueue(130, scratch.path.string());
+    std::vector<int> values;
+    for (int i = 0; i < 2000; i++) {
+        int value = (i * 7919) % 2003;
+        pqueue.push(value);
+        values.push_back(value);
+    }
+    EXPECT_LE(pqueue.runCount(), 16);
+    EXPECT_GT(pqueue.spilled(), 2000u);
+
+    std::sort(values.begin(), values.end());
+    for (int value : values) {
+        ASSERT_EQ(pqueue.pop(), value);
+    }
+}
+
+TEST(ExternalPQueue, WriteAmplification) {
+    ScratchDirectory scratch;
+    // 511 elements per run and just over 300 runs: level 0 fills 18 times and level 1 once
+    const int ITEMS = 512 * 300;
+    ExternalPQueue<int> pqueue(1024, scratch.path.string());
+    std::mt19937 rng(3);
+    for (int i = 0; i < ITEMS; i++) {
+        pqueue.push(static_cast<int>(rng() % 1000000));
+    }
+    // Each element is written once by its spill and once per level it is merged into
+    EXPECT_LE(pqueue.spilled(), 3ull * ITEMS);
+    EXPECT_LE(pqueue.runCount(), 4 * 15 + 1);
+    EXPECT_EQ(spillFiles(scratch.path), pqueue.runCount());
+
+    int previous = -1;
+    for (int i = 0; i < ITEMS; i++) {
+        int value = pqueue.pop();
+        ASSERT_GE(value, previous);
+        previous = value;
+    }
+    EXPECT_EQ(spillFiles(scratch.path), 0);
+}
+
+TEST(ExternalPQueue, Interleaved) {
+    ScratchDirectory scratch;
+    ExternalPQueue<long long> pqueue(200, scratch.path.string());
+    PQueue<long long> reference;
+    std::mt19937 rng(5);
+    for (int i = 0; i < 20000; i++) {
+        if (rng() % 3 != 0 || reference.isEmpty()) {
+            long long value = rng() % 100000;
+            pqueue.push(value);
+            reference.push(value);
+        } else {
+            ASSERT_EQ(pqueue.pop(), reference.pop());
+        }
+        ASSERT_EQ(pqueue.length(), static_cast<std::uint64_t>(reference.length()));
+    }
+    while (!reference.isEmpty()) {
+        ASSERT_EQ(pqueue.pop(), reference.pop());
+    }
+}
+
+TEST(ExternalPQueue, MaxHeapAndKey) {
+    ScratchDirectory scratch;
+    ExternalPQueue<Job, std::less<>, int Job::*> pqueue(130, scratch.path.string(), true, std::less<>(), &Job::priority);
+    EXPECT_TRUE(pqueue.isMax());
+    for (int i = 0; i < 300; i++) {
+        pqueue.push({(i * 37) % 300, i});
+    }
+    for (int i = 299; i >= 0; i--) {
+        Job job = pqueue.pop();
+        ASSERT_EQ(job.priority, i);
+        ASSERT_EQ(job.id * 37 % 300, i);
+    }
+}
+
+TEST(ExternalPQueue, Clear) {
+    ScratchDirectory scratch;
+    ExternalPQueue<int> pqueue(130, scratch.path.string());
+    for (int i = 0; i < 1000; i++) {
+        pqueue.push(1000 - i);
+    }
+    EXPECT_GT(spillFiles(scratch.path), 0);
+    pqueue.clear();
+    EXPECT_TRUE(pqueue.isEmpty());
+    EXPECT_EQ(pqueue.runCount(), 0);
+    EXPECT_EQ(spillFiles(scratch.path), 0);
+
+    pqueue.push(3);
+    pqueue.push(1);
+    EXPECT_EQ(pqueue.pop(), 1);
+}
+
+TEST(ExternalPQueue, DestructorRemovesFiles) {
+    ScratchDirectory scratch;
+    {
+        ExternalPQueue<int> pqueue(130, scratch.path.string());
+        for (int i = 0; i < 1000; i++) {
+            pqueue.push(i);
+        }
+        EXPECT_GT(spillFiles(scratch.path), 0);
+    }
+    EXPECT_EQ(spillFiles(scratch.path), 0);
+}
+
+TEST(ExternalPQueue, MissingDirectory) {
+    ScratchDirectory scratch;
+    ExternalPQueue<int> pqueue(130, (scratch.path / "missing").string());
+    for (int i = 0; i < 64; i++) {
+        pqueue.push(63 - i);
+    }
+    EXPECT_THROW(pqueue.push(64), std::runtime_error);
+    // The failed spill leaves every element in memory
+    EXPECT_EQ(pqueue.length(), 64u);
+    for (int i = 0; i < 64; i++) {
+        ASSERT_EQ(pqueue.pop(), i);
+    }
+    EXPECT_TRUE(pqueue.isEmpty());
+}
+
+TEST(ExternalPQueue, FailedWrite) {
+    ScratchDirectory scratch;
+    ExternalPQueue<int> pqueue(130, scratch.path.string());
+    for (int i = 0; i < 64; i++) {
+        pqueue.push(63 - i);
+    }
+    // Cap the size of files this process may write, so the spill file is created but cannot be filled
+    std::signal(SIGXFSZ, SIG_IGN);
+    rlimit original;
+    getrlimit(RLIMIT_FSIZE, &original);
+    rlimit limit = original;
+    limit.rlim_cur = 16;
+    setrlimit(RLIMIT_FSIZE, &limit);
+    EXPECT_THROW(pqueue.push(64), std::runtime_error);
+    setrlimit(RLIMIT_FSIZE, &original);
+
+    EXPECT_EQ(spillFiles(scratch.path), 0);
+    EXPECT_EQ(pqueue.runCount(), 0);
+    EXPECT_EQ(pqueue.length(), 64u);
+    pqueue.push(64);
+    for (int i = 0; i <= 64; i++) {
+        ASSERT_EQ(pqueue.pop(), i);
+    }
+}
+
+TEST(ExternalPQueue, FailedMerge) {
+    ScratchDirectory scratch;
+    // 64 elements per run, so the 16th spill fills level 0 and merges it into a run of 1024
+    ExternalPQueue<int> pqueue(130, scratch.path.string());
+    for (int i = 0; i < 1024; i++) {
+        pqueue.push(1023 - i);
+    }
+    EXPECT_EQ(pqueue.runCount(), 15);
+
+    // Let the spill file be written but not the much larger merged run
+    std::signal(SIGXFSZ, SIG_IGN);
+    rlimit original;
+    getrlimit(RLIMIT_FSIZE, &original);
+    rlimit limit = original;
+    limit.rlim_cur = 64 * sizeof(int) * 2;
+    setrlimit(RLIMIT_FSIZE, &limit);
+    EXPECT_THROW(pqueue.push(1024), std::runtime_error);
+    setrlimit(RLIMIT_FSIZE, &original);
+
+    // The spill went through, the merge left the runs as they were, and no partial run is left behind
+    EXPECT_EQ(pqueue.length(), 1024u);
+    EXPECT_EQ(pqueue.runCount(), 16);
+    EXPECT_EQ(spillFiles(scratch.path), 16);
+    for (int i = 0; i < 512; i++) {
+        ASSERT_EQ(pqueue.pop(), i);
+    }
+
+    // The next spill merges the level successfully
+    for (int i = 0; i < 65; i++) {
+        pqueue.push(2000 + i);
+    }
+    EXPECT_LT(pqueue.runCount(), 16);
+    for (int i = 512; i < 1024; i++) {
+        ASSERT_EQ(pqueue.pop(), i);
+    }
+    for (int i = 0; i < 65; i++) {
+        ASSERT_EQ(pqueue.pop(), 2000 + i);
+    }
+    EXPECT_TRUE(pqueue.isEmpty());
+}
+
+TEST(ExternalPQueue, HeapWithinBudget) {
+    ScratchDirectory scratch;
+    const int MEMORY = 1000;
+    ExternalPQueue<int> pqueue(MEMORY, scratch.path.string());
+    // The heap is allocated once, and with the unused slot before its root fits in half the budget
+    int capacity = pqueue.heapCapacity();
+    EXPECT_LE(capacity + 1, MEMORY / 2);
+    for (int i = 0; i < 5000; i++) {
+        pqueue.push(5000 - i);
+        ASSERT_EQ(pqueue.heapCapacity(), capacity);
+    }
+    EXPECT_GT(pqueue.runCount(), 0);
+    for (int i = 1; i <= 5000; i++) {
+        ASSERT_EQ(pqueue.pop(), i);
+        ASSERT_EQ(pqueue.heapCapacity(), capacity);
+    }
+}
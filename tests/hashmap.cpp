@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "../include/strux.h"
+
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view text) const { return std::hash<std::string_view>()(text); }
+};
+
+TEST(HashMap, Constructor) {
+    HashMap<int, int> map;
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(map.length(), 0);
+    EXPECT_THROW((HashMap<int, int>(-1)), std::invalid_argument);
+}
+
+TEST(HashMap, InsertAndSet) {
+    HashMap<std::string, int> map;
+    EXPECT_TRUE(map.insert("one", 1));
+    EXPECT_FALSE(map.insert("one", 100));
+    EXPECT_EQ(map.get(std::string("one")), 1);
+
+    EXPECT_FALSE(map.set("one", 11));
+    EXPECT_TRUE(map.set("two", 2));
+    EXPECT_EQ(map.get(std::string("one")), 11);
+    EXPECT_EQ(map.get(std::string("two")), 2);
+    EXPECT_EQ(map.length(), 2);
+}
+
+TEST(HashMap, Subscript) {
+    HashMap<std::string, int> map;
+    map["apple"] += 3;
+    map["apple"] += 4;
+    map["pear"]++;
+    EXPECT_EQ(map.length(), 2);
+    EXPECT_EQ(map["apple"], 7);
+    EXPECT_EQ(map["pear"], 1);
+}
+
+TEST(HashMap, GetAndFind) {
+    HashMap<int, std::string> map;
+    map.insert(1, "a");
+    EXPECT_EQ(map.get(1), "a");
+    EXPECT_THROW(map.get(2), std::out_of_range);
+
+    std::string* value = map.find(1);
+    ASSERT_NE(value, nullptr);
+    *value = "b";
+    EXPECT_EQ(map.get(1), "b");
+    EXPECT_EQ(map.find(2), nullptr);
+
+    const HashMap<int, std::string>& view = map;
+    EXPECT_EQ(view.get(1), "b");
+    EXPECT_EQ(*view.find(1), "b");
+    EXPECT_THROW(view.get(3), std::out_of_range);
+}
+
+TEST(HashMap, Remove) {
+    HashMap<int, int> map;
+    for (int i = 0; i < 1000; i++) {
+        map.insert(i, i * i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        EXPECT_TRUE(map.remove(i));
+    }
+    EXPECT_FALSE(map.remove(0));
+    EXPECT_EQ(map.length(), 500);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(map.contains(i), i % 2 == 1);
+        if (i % 2 == 1) {
+            EXPECT_EQ(map.get(i), i * i);
+        }
+    }
+}
+
+TEST(HashMap, HeterogeneousLookup) {
+    HashMap<std::string, int, StringHash> map;
+    map.insert("alpha", 1);
+    map.insert("beta", 2);
+
+    std::string_view key = "alpha";
+    EXPECT_TRUE(map.contains(key));
+    EXPECT_TRUE(map.contains("beta"));
+    EXPECT_FALSE(map.contains("gamma"));
+    EXPECT_EQ(map.get(key), 1);
+    EXPECT_EQ(*map.find("beta"), 2);
+    EXPECT_TRUE(map.remove(std::string_view("beta")));
+    EXPECT_EQ(map.length(), 1);
+}
+
+TEST(HashMap, MatchesUnorderedMap) {
+    std::mt19937 rng(17);
+    HashMap<int, int> map;
+    std::unordered_map<int, int> reference;
+    for (int i = 0; i < 50000; i++) {
+        int key = static_cast<int>(rng() % 2000);
+        switch (rng() % 3) {
+        case 0:
+            ASSERT_EQ(map.set(key, i), reference.insert_or_assign(key, i).second);
+            break;
+        case 1:
+            ASSERT_EQ(map.remove(key), reference.erase(key) > 0);
+            break;
+        default:
+            ASSERT_EQ(map.contains(key), reference.count(key) > 0);
+            if (reference.count(key) > 0) {
+                ASSERT_EQ(map.get(key), reference[key]);
+            }
+        }
+    }
+    EXPECT_EQ(map.length(), static_cast<int>(reference.size()));
+
+    int count = 0;
+    map.forEach([&](const int& key, int& value) {
+        EXPECT_EQ(reference.at(key), value);
+        count++;
+    });
+    EXPECT_EQ(count, map.length());
+}
+
+TEST(HashMap, Clear) {
+    HashMap<int, int> map;
+    map.reserve(100);
+    for (int i = 0; i < 100; i++) {
+        map.insert(i, i);
+    }
+    map.clear();
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.contains(5));
+    map.insert(5, 50);
+    EXPECT_EQ(map.get(5), 50);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include "../include/strux.h"
+
+TEST(HashSet, Constructor) {
+    HashSet<int> set;
+    EXPECT_TRUE(set.isEmpty());
+    EXPECT_EQ(set.length(), 0);
+    EXPECT_THROW(HashSet<int>(-1), std::invalid_argument);
+}
+
+TEST(HashSet, InsertContainsRemove) {
+    HashSet<std::string> set;
+    EXPECT_TRUE(set.insert("red"));
+    EXPECT_TRUE(set.insert("green"));
+    EXPECT_FALSE(set.insert("red"));
+    EXPECT_EQ(set.length(), 2);
+
+    EXPECT_TRUE(set.contains(std::string("red")));
+    EXPECT_FALSE(set.contains(std::string("blue")));
+    EXPECT_TRUE(set.remove(std::string("red")));
+    EXPECT_FALSE(set.remove(std::string("red")));
+    EXPECT_FALSE(set.contains(std::string("red")));
+    EXPECT_EQ(set.length(), 1);
+}
+
+TEST(HashSet, MatchesStdSet) {
+    std::mt19937 rng(23);
+    HashSet<unsigned> set;
+    std::set<unsigned> reference;
+    for (int i = 0; i < 50000; i++) {
+        unsigned value = rng() % 5000;
+        if (rng() % 2 == 0) {
+            ASSERT_EQ(set.insert(value), reference.insert(value).second);
+        } else {
+            ASSERT_EQ(set.remove(value), reference.erase(value) > 0);
+        }
+    }
+    EXPECT_EQ(set.length(), static_cast<int>(reference.size()));
+
+    int count = 0;
+    set.forEach([&](const unsigned& value) {
+        EXPECT_EQ(reference.count(value), 1u);
+        count++;
+    });
+    EXPECT_EQ(count, set.length());
+}
+
+TEST(HashSet, ReserveAndClear) {
+    HashSet<int> set;
+    set.reserve(500);
+    int capacity = set.capacity();
+    for (int i = 0; i < 500; i++) {
+        set.insert(i);
+    }
+    EXPECT_EQ(set.capacity(), capacity);
+    set.clear();
+    EXPECT_TRUE(set.isEmpty());
+    EXPECT_EQ(set.capacity(), capacity);
+}
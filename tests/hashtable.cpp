@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "../include/strux.h"
+
+struct Account {
+    int id = 0;
+    std::string owner;
+};
+
+// Sends every key to the same home slot, so all elements share one cluster
+struct CollidingHash {
+    std::size_t operator()(int) const { return 0; }
+};
+
+// Sends keys to one of a few home slots, so clusters of different homes interleave
+struct FewHomesHash {
+    std::size_t operator()(int key) const { return static_cast<std::size_t>(key % 5); }
+};
+
+TEST(HashTable, Constructor) {
+    HashTable<int> table;
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_EQ(table.length(), 0);
+    EXPECT_EQ(table.capacity(), 16);
+
+    HashTable<int> sized(100);
+    EXPECT_GE(sized.capacity() * 7, 100 * 8);
+    EXPECT_EQ(sized.capacity() & (sized.capacity() - 1), 0);
+
+    EXPECT_THROW(HashTable<int>(-1), std::invalid_argument);
+}
+
+TEST(HashTable, Projection) {
+    HashTable<Account, int Account::*> table(0, &Account::id);
+    EXPECT_TRUE(table.insert({7, "ada"}));
+    EXPECT_TRUE(table.insert({3, "grace"}));
+    EXPECT_FALSE(table.insert({7, "alan"}));
+    EXPECT_EQ(table.length(), 2);
+
+    Account* account = table.find(7);
+    ASSERT_NE(account, nullptr);
+    EXPECT_EQ(account->owner, "ada");
+    EXPECT_EQ(table.find(4), nullptr);
+
+    bool inserted;
+    Account& created = table.findOrInsert(9, []() { return Account{9, "edsger"}; }, &inserted);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(created.owner, "edsger");
+    table.findOrInsert(9, []() { return Account{9, "other"}; }, &inserted);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(table.find(9)->owner, "edsger");
+}
+
+TEST(HashTable, Growth) {
+    HashTable<int> table;
+    for (int i = 0; i < 10000; i++) {
+        EXPECT_TRUE(table.insert(i));
+    }
+    EXPECT_EQ(table.length(), 10000);
+    EXPECT_LE(table.length() * 8, table.capacity() * 7);
+    for (int i = 0; i < 10000; i++) {
+        EXPECT_TRUE(table.contains(i));
+    }
+    EXPECT_FALSE(table.contains(10000));
+    EXPECT_FALSE(table.contains(-1));
+}
+
+TEST(HashTable, Reserve) {
+    HashTable<int> table;
+    table.reserve(1000);
+    int capacity = table.capacity();
+    EXPECT_GE(capacity * 7, 1000 * 8);
+    for (int i = 0; i < 1000; i++) {
+        table.insert(i);
+    }
+    EXPECT_EQ(table.capacity(), capacity);
+    table.reserve(10);
+    EXPECT_EQ(table.capacity(), capacity);
+}
+
+TEST(HashTable, RemoveShiftsCluster) {
+    HashTable<int, std::identity, CollidingHash> table;
+    for (int i = 0; i < 12; i++) {
+        table.insert(i);
+    }
+    // Removing from the middle of the cluster must not hide the elements behind it
+    EXPECT_TRUE(table.remove(4));
+    EXPECT_TRUE(table.remove(0));
+    EXPECT_FALSE(table.remove(0));
+    for (int i = 1; i < 12; i++) {
+        EXPECT_EQ(table.contains(i), i != 4);
+    }
+    EXPECT_EQ(table.length(), 10);
+}
+
+TEST(HashTable, MatchesUnorderedMap) {
+    std::mt19937 rng(9);
+    HashTable<int, std::identity, FewHomesHash> colliding;
+    HashTable<int> spread;
+    std::unordered_map<int, bool> reference;
+    for (int i = 0; i < 20000; i++) {
+        int value = static_cast<int>(rng() % 300);
+        if (rng() % 2 == 0) {
+            bool expected = reference.emplace(value, true).second;
+            ASSERT_EQ(colliding.insert(value), expected);
+            ASSERT_EQ(spread.insert(value), expected);
+        } else {
+            bool expected = reference.erase(value) > 0;
+            ASSERT_EQ(colliding.remove(value), expected);
+            ASSERT_EQ(spread.remove(value), expected);
+        }
+        ASSERT_EQ(colliding.length(), static_cast<int>(reference.size()));
+        ASSERT_EQ(spread.length(), static_cast<int>(reference.size()));
+    }
+    for (int value = 0; value < 300; value++) {
+        EXPECT_EQ(colliding.contains(value), reference.count(value) > 0);
+        EXPECT_EQ(spread.contains(value), reference.count(value) > 0);
+    }
+}
+
+TEST(HashTable, ClearAndForEach) {
+    HashTable<int> table;
+    for (int i = 1; i <= 100; i++) {
+        table.insert(i);
+    }
+    int sum = 0;
+    table.forEach([&](const int& value) { sum += value; });
+    EXPECT_EQ(sum, 5050);
+
+    int capacity = table.capacity();
+    table.clear();
+    EXPECT_TRUE(table.isEmpty());
+    EXPECT_EQ(table.capacity(), capacity);
+    EXPECT_FALSE(table.contains(50));
+    EXPECT_TRUE(table.insert(50));
+}
@@ -0,0 +1,233 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+struct Idle {};
+struct Active {};
+
+struct Connection : ListHook<Idle>, ListHook<Active> {
+    int id;
+    Connection(int id = 0) : id(id) {}
+};
+
+TEST(IntrusiveList, Constructor) {
+    IntrusiveList<Connection, Idle> list;
+    EXPECT_TRUE(list.isEmpty());
+    EXPECT_EQ(list.length(), 0);
+    EXPECT_TRUE(list.begin() == list.end());
+}
+
+TEST(IntrusiveList, Push) {
+    Connection conns[3] = {1, 2, 3};
+    IntrusiveList<Connection, Idle> list;
+
+    list.push(conns[1]);
+    list.push(conns[2]);
+    list.pushFront(conns[0]);
+
+    EXPECT_EQ(list.length(), 3);
+    EXPECT_EQ(list.peek().id, 1);
+    EXPECT_EQ(list.peekBack().id, 3);
+    EXPECT_EQ(&list.peek(), &conns[0]);
+
+    int expected = 1;
+    for (Connection& conn : list) {
+        EXPECT_EQ(conn.id, expected++);
+    }
+}
+
+TEST(IntrusiveList, PushLinked) {
+    Connection conn(1);
+    IntrusiveList<Connection, Idle> list;
+    IntrusiveList<Connection, Idle> other;
+
+    list.push(conn);
+    EXPECT_THROW(list.push(conn), std::runtime_error);
+    EXPECT_THROW(other.push(conn), std::runtime_error);
+    EXPECT_EQ(list.length(), 1);
+    EXPECT_EQ(other.length(), 0);
+}
+
+TEST(IntrusiveList, InsertAfter) {
+    Connection conns[3] = {1, 2, 3};
+    IntrusiveList<Connection, Idle> list;
+
+    list.push(conns[0]);
+    list.push(conns[2]);
+    list.insertAfter(conns[0], conns[1]);
+
+    int expected = 1;
+    for (Connection& conn : list) {
+        EXPECT_EQ(conn.id, expected++);
+    }
+    EXPECT_EQ(expected, 4);
+}
+
+TEST(IntrusiveList, Pop) {
+    Connection conns[3] = {1, 2, 3};
+    IntrusiveList<Connection, Idle> list;
+    for (int i = 0; i < 3; i++) {
+        list.push(conns[i]);
+    }
+
+    EXPECT_EQ(list.pop().id, 3);
+    EXPECT_EQ(list.popFront().id, 1);
+    EXPECT_EQ(list.length(), 1);
+    EXPECT_FALSE(conns[0].ListHook<Idle>::isLinked());
+    EXPECT_TRUE(conns[1].ListHook<Idle>::isLinked());
+
+    EXPECT_EQ(list.pop().id, 2);
+    EXPECT_TRUE(list.isEmpty());
+
+    EXPECT_THROW(list.pop(), std::runtime_error);
+    EXPECT_THROW(list.popFront(), std::runtime_error);
+    EXPECT_THROW(list.peek(), std::runtime_error);
+    EXPECT_THROW(list.peekBack(), std::runtime_error);
+}
+
+TEST(IntrusiveList, Remove) {
+    Connection conns[3] = {1, 2, 3};
+    IntrusiveList<Connection, Idle> list;
+    for (int i = 0; i < 3; i++) {
+        list.push(conns[i]);
+    }
+
+    EXPECT_TRUE(list.remove(conns[1]));
+    EXPECT_FALSE(list.remove(conns[1]));
+    EXPECT_EQ(list.length(), 2);
+    EXPECT_FALSE(list.contains(conns[1]));
+    EXPECT_EQ(list.peek().id, 1);
+    EXPECT_EQ(list.peekBack().id, 3);
+
+    EXPECT_TRUE(list.remove(conns[0]));
+    EXPECT_TRUE(list.remove(conns[2]));
+    EXPECT_TRUE(list.isEmpty());
+}
+
+TEST(IntrusiveList, RemoveFromWrongList) {
+    Connection conns[3] = {1, 2, 3};
+    IntrusiveList<Connection, Idle> list;
+    IntrusiveList<Connection, Idle> other;
+    list.push(conns[0]);
+    other.push(conns[1]);
+    other.push(conns[2]);
+
+    // The object is linked, but into the other list, so neither list may change
+    EXPECT_THROW(list.remove(conns[1]), std::runtime_error);
+    EXPECT_THROW(list.insertAfter(conns[1], conns[0]), std::runtime_error);
+    EXPECT_EQ(list.length(), 1);
+    EXPECT_EQ(other.length(), 2);
+    EXPECT_TRUE(other.contains(conns[1]));
+
+    // Moving it through its own list and then linking it here works
+    EXPECT_TRUE(other.remove(conns[1]));
+    list.push(conns[1]);
+    EXPECT_TRUE(list.remove(conns[1]));
+    EXPECT_EQ(list.length(), 1);
+    EXPECT_EQ(other.length(), 1);
+    EXPECT_EQ(other.peek().id, 3);
+}
+
+TEST(IntrusiveList, Contains) {
+    Connection conns[2] = {1, 2};
+    IntrusiveList<Connection, Idle> list;
+    IntrusiveList<Connection, Idle> other;
+
+    list.push(conns[0]);
+    other.push(conns[1]);
+
+    EXPECT_TRUE(list.contains(conns[0]));
+    EXPECT_FALSE(list.contains(conns[1]));
+    EXPECT_TRUE(other.contains(conns[1]));
+}
+
+TEST(IntrusiveList, MultipleLists) {
+    Connection conns[4] = {1, 2, 3, 4};
+    IntrusiveList<Connection, Idle> idle;
+    IntrusiveList<Connection, Active> active;
+
+    for (int i = 0; i < 4; i++) {
+        idle.push(conns[i]);
+        active.push(conns[i]);
+    }
+    EXPECT_EQ(idle.length(), 4);
+    EXPECT_EQ(active.length(), 4);
+
+    idle.remove(conns[2]);
+    EXPECT_EQ(idle.length(), 3);
+    EXPECT_TRUE(active.contains(conns[2]));
+    EXPECT_FALSE(idle.contains(conns[2]));
+}
+
+TEST(IntrusiveList, Clear) {
+    Connection conns[3] = {1, 2, 3};
+    IntrusiveList<Connection, Idle> list;
+    for (int i = 0; i < 3; i++) {
+        list.push(conns[i]);
+    }
+
+    list.clear();
+    EXPECT_TRUE(list.isEmpty());
+    for (int i = 0; i < 3; i++) {
+        EXPECT_FALSE(conns[i].ListHook<Idle>::isLinked());
+    }
+
+    list.push(conns[0]);
+    EXPECT_EQ(list.length(), 1);
+}
+
+TEST(IntrusiveList, Destructor) {
+    Connection conn(1);
+    {
+        IntrusiveList<Connection, Idle> list;
+        list.push(conn);
+    }
+    EXPECT_FALSE(conn.ListHook<Idle>::isLinked());
+}
+
+TEST(IntrusiveList, CopyUnlinked) {
+    Connection conn(1);
+    IntrusiveList<Connection, Idle> list;
+    list.push(conn);
+
+    Connection copy = conn;
+    EXPECT_FALSE(copy.ListHook<Idle>::isLinked());
+    EXPECT_EQ(list.length(), 1);
+}
+
+TEST(IntrusiveList, Reverse) {
+    Connection conns[5] = {1, 2, 3, 4, 5};
+    IntrusiveList<Connection, Idle> list;
+    for (int i = 0; i < 5; i++) {
+        list.push(conns[i]);
+    }
+
+    list.reverse();
+    EXPECT_EQ(list.peek().id, 5);
+    EXPECT_EQ(list.peekBack().id, 1);
+
+    int expected = 5;
+    for (Connection& conn : list) {
+        EXPECT_EQ(conn.id, expected--);
+    }
+}
+
+TEST(IntrusiveList, LargeOperations) {
+    Connection conns[1000];
+    IntrusiveList<Connection, Idle> idle;
+    IntrusiveList<Connection, Active> active;
+
+    for (int i = 0; i < 1000; i++) {
+        conns[i].id = i;
+        idle.push(conns[i]);
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        Connection& conn = idle.popFront();
+        EXPECT_EQ(conn.id, i);
+        active.push(conn);
+    }
+
+    EXPECT_TRUE(idle.isEmpty());
+    EXPECT_EQ(active.length(), 1000);
+}
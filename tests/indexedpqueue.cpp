@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+TEST(IndexedPQueue, Constructor) {
+    IndexedPQueue<int> pqueue;
+    EXPECT_TRUE(pqueue.isEmpty());
+    EXPECT_EQ(pqueue.length(), 0);
+    EXPECT_TRUE(pqueue.isMin());
+    EXPECT_FALSE(pqueue.contains(0));
+    EXPECT_THROW(pqueue.pop(), std::runtime_error);
+    EXPECT_THROW(pqueue.peek(), std::runtime_error);
+}
+
+TEST(IndexedPQueue, PushPop) {
+    IndexedPQueue<int> pqueue;
+    int values[] = {5, 3, 8, 1, 9, 2};
+    for (int value : values) {
+        pqueue.push(value);
+    }
+
+    EXPECT_EQ(pqueue.length(), 6);
+    EXPECT_TRUE(pqueue.validHeap());
+    for (int expected : {1, 2, 3, 5, 8, 9}) {
+        EXPECT_EQ(pqueue.pop(), expected);
+    }
+    EXPECT_TRUE(pqueue.isEmpty());
+}
+
+TEST(IndexedPQueue, Handles) {
+    IndexedPQueue<int> pqueue;
+    int a = pqueue.push(10);
+    int b = pqueue.push(20);
+    int c = pqueue.push(5);
+
+    EXPECT_EQ(pqueue.get(a), 10);
+    EXPECT_EQ(pqueue.get(b), 20);
+    EXPECT_EQ(pqueue.peekHandle(), c);
+    EXPECT_TRUE(pqueue.contains(b));
+
+    EXPECT_EQ(pqueue.pop(), 5);
+    EXPECT_FALSE(pqueue.contains(c));
+    EXPECT_THROW(pqueue.get(c), std::out_of_range);
+    EXPECT_THROW(pqueue.get(-1), std::out_of_range);
+
+    int d = pqueue.push(15);
+    EXPECT_EQ(d, c);
+    EXPECT_EQ(pqueue.get(d), 15);
+    EXPECT_TRUE(pqueue.validHeap());
+}
+
+TEST(IndexedPQueue, DecreaseKey) {
+    IndexedPQueue<int> pqueue;
+    pqueue.push(10);
+    pqueue.push(20);
+    int handle = pqueue.push(30);
+
+    pqueue.decreaseKey(handle, 1);
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.peekHandle(), handle);
+    EXPECT_THROW(pqueue.decreaseKey(handle, 50), std::invalid_argument);
+    EXPECT_EQ(pqueue.get(handle), 1);
+}
+
+TEST(IndexedPQueue, IncreaseKey) {
+    IndexedPQueue<int> pqueue;
+    int handle = pqueue.push(1);
+    pqueue.push(10);
+    pqueue.push(20);
+
+    pqueue.increaseKey(handle, 15);
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.pop(), 10);
+    EXPECT_EQ(pqueue.pop(), 15);
+    EXPECT_THROW(pqueue.increaseKey(0, 1), std::out_of_range);
+}
+
+TEST(IndexedPQueue, Update) {
+    IndexedPQueue<int> pqueue(true);
+    int handles[8];
+    for (int i = 0; i < 8; i++) {
+        handles[i] = pqueue.push(i * 10);
+    }
+
+    pqueue.update(handles[0], 100);
+    pqueue.update(handles[7], -5);
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.pop(), 100);
+    EXPECT_EQ(pqueue.pop(), 60);
+}
+
+TEST(IndexedPQueue, Erase) {
+    IndexedPQueue<int> pqueue;
+    int handles[10];
+    for (int i = 0; i < 10; i++) {
+        handles[i] = pqueue.push((i * 7) % 10);
+    }
+
+    EXPECT_TRUE(pqueue.erase(handles[3]));
+    EXPECT_FALSE(pqueue.erase(handles[3]));
+    EXPECT_FALSE(pqueue.contains(handles[3]));
+    EXPECT_TRUE(pqueue.erase(pqueue.peekHandle()));
+    EXPECT_EQ(pqueue.length(), 8);
+    EXPECT_TRUE(pqueue.validHeap());
+
+    int prev = pqueue.pop();
+    while (!pqueue.isEmpty()) {
+        int next = pqueue.pop();
+        EXPECT_LE(prev, next);
+        prev = next;
+    }
+}
+
+TEST(IndexedPQueue, Clear) {
+    IndexedPQueue<int> pqueue;
+    int handle = pqueue.push(1);
+    pqueue.push(2);
+    pqueue.clear();
+
+    EXPECT_TRUE(pqueue.isEmpty());
+    EXPECT_FALSE(pqueue.contains(handle));
+    EXPECT_EQ(pqueue.push(3), 0);
+    EXPECT_TRUE(pqueue.validHeap());
+}
+
+TEST(IndexedPQueue, Dijkstra) {
+    // Edges of a small directed graph as {from, to, weight}
+    int edges[][3] = {{0, 1, 4}, {0, 2, 1}, {2, 1, 2}, {1, 3, 1}, {2, 3, 5}, {3, 4, 3}};
+    const int nodes = 5;
+    int dist[nodes];
+    int handles[nodes];
+
+    IndexedPQueue<std::pair<int, int>> pqueue;
+    for (int i = 0; i < nodes; i++) {
+        dist[i] = i == 0 ? 0 : 1000;
+        handles[i] = pqueue.push({dist[i], i});
+    }
+    while (!pqueue.isEmpty()) {
+        std::pair<int, int> top = pqueue.pop();
+        for (auto& edge : edges) {
+            if (edge[0] == top.second && top.first + edge[2] < dist[edge[1]]) {
+                dist[edge[1]] = top.first + edge[2];
+                pqueue.decreaseKey(handles[edge[1]], {dist[edge[1]], edge[1]});
+            }
+        }
+    }
+
+    int expected[] = {0, 3, 1, 4, 7};
+    for (int i = 0; i < nodes; i++) {
+        EXPECT_EQ(dist[i], expected[i]);
+    }
+}
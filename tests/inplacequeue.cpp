@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+TEST(InplaceQueue, Constructor) {
+    InplaceQueue<int, 5> queue;
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.length(), 0);
+    EXPECT_EQ(queue.capacity(), 5);
+}
+
+TEST(InplaceQueue, Push) {
+    InplaceQueue<int, 3> queue;
+
+    queue.push(1);
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_TRUE(queue.tryPush(3));
+    EXPECT_TRUE(queue.isFull());
+    EXPECT_FALSE(queue.tryPush(4));
+    EXPECT_THROW(queue.push(4), std::length_error);
+    EXPECT_EQ(queue.peek(), 1);
+}
+
+TEST(InplaceQueue, Pop) {
+    InplaceQueue<int, 4> queue;
+
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), 3);
+    EXPECT_THROW(queue.pop(), std::runtime_error);
+    EXPECT_THROW(queue.peek(), std::runtime_error);
+}
+
+TEST(InplaceQueue, Wraparound) {
+    InplaceQueue<int, 3> queue;
+
+    for (int i = 0; i < 20; i++) {
+        queue.push(i);
+        queue.push(i + 100);
+        EXPECT_EQ(queue.pop(), i);
+        EXPECT_EQ(queue.get(0), i + 100);
+        EXPECT_EQ(queue.pop(), i + 100);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(InplaceQueue, GetContains) {
+    InplaceQueue<int, 3> queue;
+    queue.push(1);
+    queue.push(2);
+    queue.pop();
+    queue.push(3);
+    queue.push(4);
+
+    EXPECT_EQ(queue.get(0), 2);
+    EXPECT_EQ(queue.get(2), 4);
+    EXPECT_THROW(queue.get(3), std::out_of_range);
+    EXPECT_TRUE(queue.contains(4));
+    EXPECT_FALSE(queue.contains(1));
+}
+
+TEST(InplaceQueue, Clear) {
+    InplaceQueue<int, 3> queue;
+    queue.push(1);
+    queue.push(2);
+
+    queue.clear();
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_TRUE(queue.tryPush(1));
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+TEST(InplaceStack, Constructor) {
+    InplaceStack<int, 4> stack;
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_EQ(stack.length(), 0);
+    EXPECT_EQ(stack.capacity(), 4);
+}
+
+TEST(InplaceStack, Push) {
+    InplaceStack<int, 3> stack;
+
+    stack.push(1);
+    EXPECT_TRUE(stack.tryPush(2));
+    EXPECT_TRUE(stack.tryPush(3));
+    EXPECT_TRUE(stack.isFull());
+    EXPECT_FALSE(stack.tryPush(4));
+    EXPECT_THROW(stack.push(4), std::length_error);
+    EXPECT_EQ(stack.peek(), 3);
+}
+
+TEST(InplaceStack, Pop) {
+    InplaceStack<int, 4> stack;
+
+    stack.push(1);
+    stack.push(2);
+    stack.push(3);
+
+    EXPECT_EQ(stack.pop(), 3);
+    EXPECT_EQ(stack.pop(), 2);
+    EXPECT_EQ(stack.pop(), 1);
+    EXPECT_THROW(stack.pop(), std::runtime_error);
+    EXPECT_THROW(stack.peek(), std::runtime_error);
+}
+
+TEST(InplaceStack, Peek) {
+    InplaceStack<int, 4> stack;
+    stack.push(1);
+
+    stack.peek() = 5;
+    const InplaceStack<int, 4>& view = stack;
+    EXPECT_EQ(view.peek(), 5);
+    EXPECT_EQ(stack.pop(), 5);
+
+    const InplaceStack<int, 4>& empty_view = stack;
+    EXPECT_THROW(empty_view.peek(), std::runtime_error);
+}
+
+TEST(InplaceStack, Clear) {
+    InplaceStack<int, 4> stack;
+    stack.push(1);
+    stack.push(2);
+
+    EXPECT_TRUE(stack.contains(2));
+    stack.clear();
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_FALSE(stack.contains(2));
+}
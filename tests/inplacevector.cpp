@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+TEST(InplaceVector, Constructor) {
+    InplaceVector<int, 8> vector;
+    EXPECT_TRUE(vector.isEmpty());
+    EXPECT_EQ(vector.length(), 0);
+    EXPECT_EQ(vector.capacity(), 8);
+}
+
+TEST(InplaceVector, ArrayConstructor) {
+    int values[] = {1, 2, 3, 4, 5};
+    InplaceVector<int, 8> vector(values, 5);
+
+    EXPECT_EQ(vector.length(), 5);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(vector.get(i), values[i]);
+    }
+
+    EXPECT_THROW((InplaceVector<int, 4>(values, 5)), std::length_error);
+    EXPECT_THROW((InplaceVector<int, 4>(values, -1)), std::invalid_argument);
+}
+
+TEST(InplaceVector, NoHeap) {
+    InplaceVector<int, 16> vector;
+    EXPECT_EQ(sizeof(vector), sizeof(int) * 16 + sizeof(int));
+}
+
+TEST(InplaceVector, Push) {
+    InplaceVector<int, 3> vector;
+
+    vector.push(1);
+    EXPECT_TRUE(vector.tryPush(2));
+    EXPECT_TRUE(vector.tryPush(3));
+    EXPECT_TRUE(vector.isFull());
+    EXPECT_FALSE(vector.tryPush(4));
+    EXPECT_THROW(vector.push(4), std::length_error);
+
+    EXPECT_EQ(vector.length(), 3);
+    EXPECT_EQ(vector.get(2), 3);
+}
+
+TEST(InplaceVector, Insert) {
+    InplaceVector<int, 4> vector;
+
+    vector.push(1);
+    vector.push(3);
+    vector.insert(1, 2);
+    vector.insert(0, 0);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(vector.get(i), i);
+    }
+    EXPECT_THROW(vector.insert(0, 5), std::length_error);
+    EXPECT_THROW(vector.insert(6, 5), std::out_of_range);
+}
+
+TEST(InplaceVector, SetGet) {
+    InplaceVector<int, 4> vector;
+    vector.push(1);
+
+    vector.set(0, 5);
+    EXPECT_EQ(vector.get(0), 5);
+    EXPECT_EQ(vector.back(), 5);
+    EXPECT_THROW(vector.set(1, 5), std::out_of_range);
+    EXPECT_THROW(vector.get(-1), std::out_of_range);
+}
+
+TEST(InplaceVector, Remove) {
+    int values[] = {1, 2, 3, 4};
+    InplaceVector<int, 4> vector(values, 4);
+
+    EXPECT_EQ(vector.remove(1), 2);
+    EXPECT_EQ(vector.get(1), 3);
+    EXPECT_TRUE(vector.removeValue(4));
+    EXPECT_FALSE(vector.removeValue(4));
+    EXPECT_EQ(vector.length(), 2);
+    EXPECT_THROW(vector.remove(2), std::out_of_range);
+}
+
+TEST(InplaceVector, Pop) {
+    int values[] = {1, 2};
+    InplaceVector<int, 4> vector(values, 2);
+
+    EXPECT_EQ(vector.pop(), 2);
+    EXPECT_EQ(vector.pop(), 1);
+    EXPECT_THROW(vector.pop(), std::runtime_error);
+    EXPECT_THROW(vector.back(), std::runtime_error);
+}
+
+TEST(InplaceVector, FindContains) {
+    int values[] = {1, 2, 3};
+    InplaceVector<int, 4> vector(values, 3);
+
+    EXPECT_EQ(vector.find(2), 1);
+    EXPECT_EQ(vector.find(5), -1);
+    EXPECT_TRUE(vector.contains(3));
+    EXPECT_FALSE(vector.contains(5));
+}
+
+TEST(InplaceVector, Reverse) {
+    int values[] = {1, 2, 3, 4, 5};
+    InplaceVector<int, 8> vector(values, 5);
+
+    vector.reverse();
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(vector.get(i), 5 - i);
+    }
+}
+
+TEST(InplaceVector, Clear) {
+    int values[] = {1, 2, 3};
+    InplaceVector<int, 4> vector(values, 3);
+
+    vector.clear();
+    EXPECT_TRUE(vector.isEmpty());
+    EXPECT_TRUE(vector.tryPush(1));
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+struct Message : ListHook<> {
+    int id;
+    Message(int id = 0) : id(id) {}
+};
+
+TEST(IntrusiveQueue, Constructor) {
+    IntrusiveQueue<Message> queue;
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.length(), 0);
+}
+
+TEST(IntrusiveQueue, Push) {
+    Message messages[3] = {1, 2, 3};
+    IntrusiveQueue<Message> queue;
+
+    for (int i = 0; i < 3; i++) {
+        queue.push(messages[i]);
+    }
+
+    EXPECT_EQ(queue.length(), 3);
+    EXPECT_EQ(queue.peek().id, 1);
+    EXPECT_THROW(queue.push(messages[0]), std::runtime_error);
+}
+
+TEST(IntrusiveQueue, Pop) {
+    Message messages[3] = {1, 2, 3};
+    IntrusiveQueue<Message> queue;
+    for (int i = 0; i < 3; i++) {
+        queue.push(messages[i]);
+    }
+
+    EXPECT_EQ(queue.pop().id, 1);
+    EXPECT_EQ(queue.pop().id, 2);
+    EXPECT_EQ(&queue.pop(), &messages[2]);
+    EXPECT_TRUE(queue.isEmpty());
+
+    EXPECT_THROW(queue.pop(), std::runtime_error);
+    EXPECT_THROW(queue.peek(), std::runtime_error);
+}
+
+TEST(IntrusiveQueue, Remove) {
+    Message messages[3] = {1, 2, 3};
+    IntrusiveQueue<Message> queue;
+    for (int i = 0; i < 3; i++) {
+        queue.push(messages[i]);
+    }
+
+    EXPECT_TRUE(queue.remove(messages[1]));
+    EXPECT_FALSE(queue.contains(messages[1]));
+    EXPECT_EQ(queue.pop().id, 1);
+    EXPECT_EQ(queue.pop().id, 3);
+}
+
+TEST(IntrusiveQueue, Clear) {
+    Message messages[3] = {1, 2, 3};
+    IntrusiveQueue<Message> queue;
+    for (int i = 0; i < 3; i++) {
+        queue.push(messages[i]);
+    }
+
+    queue.clear();
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(messages[2].isLinked());
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+struct Frame : ListHook<> {
+    int id;
+    Frame(int id = 0) : id(id) {}
+};
+
+TEST(IntrusiveStack, Constructor) {
+    IntrusiveStack<Frame> stack;
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_EQ(stack.length(), 0);
+}
+
+TEST(IntrusiveStack, Push) {
+    Frame frames[3] = {1, 2, 3};
+    IntrusiveStack<Frame> stack;
+
+    for (int i = 0; i < 3; i++) {
+        stack.push(frames[i]);
+    }
+
+    EXPECT_EQ(stack.length(), 3);
+    EXPECT_EQ(stack.peek().id, 3);
+    EXPECT_THROW(stack.push(frames[0]), std::runtime_error);
+}
+
+TEST(IntrusiveStack, Pop) {
+    Frame frames[3] = {1, 2, 3};
+    IntrusiveStack<Frame> stack;
+    for (int i = 0; i < 3; i++) {
+        stack.push(frames[i]);
+    }
+
+    EXPECT_EQ(stack.pop().id, 3);
+    EXPECT_EQ(stack.pop().id, 2);
+    EXPECT_EQ(&stack.pop(), &frames[0]);
+    EXPECT_TRUE(stack.isEmpty());
+
+    EXPECT_THROW(stack.pop(), std::runtime_error);
+    EXPECT_THROW(stack.peek(), std::runtime_error);
+}
+
+TEST(IntrusiveStack, Remove) {
+    Frame frames[3] = {1, 2, 3};
+    IntrusiveStack<Frame> stack;
+    for (int i = 0; i < 3; i++) {
+        stack.push(frames[i]);
+    }
+
+    EXPECT_TRUE(stack.remove(frames[1]));
+    EXPECT_FALSE(stack.contains(frames[1]));
+    EXPECT_EQ(stack.pop().id, 3);
+    EXPECT_EQ(stack.pop().id, 1);
+}
+
+TEST(IntrusiveStack, Clear) {
+    Frame frames[3] = {1, 2, 3};
+    IntrusiveStack<Frame> stack;
+    for (int i = 0; i < 3; i++) {
+        stack.push(frames[i]);
+    }
+
+    stack.clear();
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_FALSE(frames[0].isLinked());
+}
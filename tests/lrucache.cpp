@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../include/strux.h"
+
+TEST(LRUCache, Constructor) {
+    LRUCache<int, int> cache(3);
+    EXPECT_TRUE(cache.isEmpty());
+    EXPECT_EQ(cache.length(), 0);
+    EXPECT_EQ(cache.capacity(), 3);
+    EXPECT_EQ(cache.weight(), 0);
+    EXPECT_THROW((LRUCache<int, int>(0)), std::invalid_argument);
+    EXPECT_THROW((LRUCache<int, int>(-5)), std::invalid_argument);
+}
+
+TEST(LRUCache, GetAndPut) {
+    LRUCache<std::string, int> cache(4);
+    EXPECT_TRUE(cache.put("one", 1));
+    EXPECT_TRUE(cache.put("two", 2));
+    EXPECT_FALSE(cache.put("one", 11));
+    EXPECT_EQ(cache.length(), 2);
+
+    int* value = cache.get(std::string("one"));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 11);
+    *value = 12;
+    EXPECT_EQ(*cache.peek(std::string("one")), 12);
+    EXPECT_EQ(cache.get(std::string("three")), nullptr);
+    EXPECT_EQ(cache.peek(std::string("three")), nullptr);
+    EXPECT_TRUE(cache.contains(std::string("two")));
+    EXPECT_FALSE(cache.contains(std::string("three")));
+}
+
+TEST(LRUCache, EvictsLeastRecentlyUsed) {
+    LRUCache<int, int> cache(3);
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+    // Using 1 leaves 2 as the least recently used
+    cache.get(1);
+    cache.put(4, 40);
+    EXPECT_FALSE(cache.contains(2));
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_TRUE(cache.contains(4));
+
+    // Replacing a value also counts as a use, while peeking does not
+    cache.put(3, 31);
+    cache.peek(1);
+    cache.put(5, 50);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_EQ(cache.length(), 3);
+    EXPECT_EQ(*cache.peek(3), 31);
+}
+
+TEST(LRUCache, EvictionCallback) {
+    std::vector<std::pair<int, int>> evicted;
+    LRUCache<int, int> cache(2, {}, [&](const int& key, const int& value) { evicted.push_back({key, value}); });
+    cache.put(1, 10);
+    cache.put(2, 20);
+    cache.put(3, 30);
+    cache.put(4, 40);
+    ASSERT_EQ(evicted.size(), 2u);
+    EXPECT_EQ(evicted[0], std::make_pair(1, 10));
+    EXPECT_EQ(evicted[1], std::make_pair(2, 20));
+
+    // Explicit removal and clearing are not evictions
+    cache.remove(3);
+    cache.clear();
+    EXPECT_EQ(evicted.size(), 2u);
+    EXPECT_TRUE(cache.isEmpty());
+}
+
+TEST(LRUCache, Weighted) {
+    std::vector<std::string> evicted;
+    LRUCache<std::string, std::string> cache(10, [](const std::string&, const std::string& value) { return static_cast<std::int64_t>(value.size()); }, [&](const std::string& key, const std::string&) { evicted.push_back(key); });
+    cache.put("a", "xxxx");
+    cache.put("b", "xxx");
+    cache.put("c", "xx");
+    EXPECT_EQ(cache.weight(), 9);
+
+    // Six more units need both a and b gone
+    cache.put("d", "xxxxxx");
+    EXPECT_EQ(evicted, (std::vector<std::string>{"a", "b"}));
+    EXPECT_EQ(cache.weight(), 8);
+
+    // Growing a value evicts others, never the value itself
+    cache.put("d", "xxxxxxxxxx");
+    EXPECT_EQ(cache.weight(), 10);
+    EXPECT_EQ(cache.length(), 1);
+    EXPECT_THROW(cache.put("e", "xxxxxxxxxxx"), std::invalid_argument);
+    EXPECT_TRUE(cache.contains(std::string("d")));
+
+    cache.remove(std::string("d"));
+    EXPECT_EQ(cache.weight(), 0);
+}
+
+TEST(LRUCache, Remove) {
+    LRUCache<int, int> cache(3);
+    cache.put(1, 1);
+    cache.put(2, 2);
+    cache.put(3, 3);
+    EXPECT_TRUE(cache.remove(2));
+    EXPECT_FALSE(cache.remove(2));
+    EXPECT_EQ(cache.length(), 2);
+
+    // The freed room is used before anything is evicted
+    cache.put(4, 4);
+    EXPECT_TRUE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_TRUE(cache.contains(4));
+    cache.put(5, 5);
+    EXPECT_FALSE(cache.contains(1));
+}
+
+TEST(LRUCache, MatchesReference) {
+    // A list plus a map of iterators is the textbook LRU
+    const int capacity = 64;
+    LRUCache<int, int> cache(capacity);
+    std::list<std::pair<int, int>> order;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> index;
+    std::mt19937 rng(7);
+    for (int i = 0; i < 100000; i++) {
+        int key = static_cast<int>(rng() % 200);
+        if (rng() % 2 == 0) {
+            int* value = cache.get(key);
+            auto it = index.find(key);
+            ASSERT_EQ(value != nullptr, it != index.end());
+            if (value != nullptr) {
+                EXPECT_EQ(*value, it->second->second);
+                order.splice(order.begin(), order, it->second);
+            }
+        } else if (rng() % 8 == 0) {
+            auto it = index.find(key);
+            EXPECT_EQ(cache.remove(key), it != index.end());
+            if (it != index.end()) {
+                order.erase(it->second);
+                index.erase(it);
+            }
+        } else {
+            cache.put(key, i);
+            auto it = index.find(key);
+            if (it != index.end()) {
+                it->second->second = i;
+                order.splice(order.begin(), order, it->second);
+            } else {
+                if (static_cast<int>(order.size()) == capacity) {
+                    index.erase(order.back().first);
+                    order.pop_back();
+                }
+                order.push_front({key, i});
+                index[key] = order.begin();
+            }
+        }
+        ASSERT_EQ(cache.length(), static_cast<int>(order.size()));
+    }
+}
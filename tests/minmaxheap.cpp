@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <type_traits>
+
+#include "../include/strux.h"
+
+TEST(MinMaxHeap, Constructor) {
+    MinMaxHeap<int> heap;
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_FALSE(heap.isFull());
+    EXPECT_EQ(heap.capacity(), 0);
+    EXPECT_THROW(heap.popMin(), std::runtime_error);
+    EXPECT_THROW(heap.popMax(), std::runtime_error);
+    EXPECT_THROW(heap.peekMin(), std::runtime_error);
+    EXPECT_THROW(heap.peekMax(), std::runtime_error);
+    EXPECT_THROW(MinMaxHeap<int>(-1), std::invalid_argument);
+}
+
+TEST(MinMaxHeap, PeekBothEnds) {
+    MinMaxHeap<int> heap;
+    heap.push(5);
+    EXPECT_EQ(heap.peekMin(), 5);
+    EXPECT_EQ(heap.peekMax(), 5);
+
+    int values[] = {3, 8, 1, 9, 2, 7};
+    for (int value : values) {
+        heap.push(value);
+    }
+    EXPECT_EQ(heap.length(), 7);
+    EXPECT_EQ(heap.peekMin(), 1);
+    EXPECT_EQ(heap.peekMax(), 9);
+    EXPECT_TRUE(heap.validHeap());
+}
+
+TEST(MinMaxHeap, PopMin) {
+    MinMaxHeap<int> heap;
+    for (int i = 0; i < 200; i++) {
+        heap.push((i * 37) % 200);
+    }
+    for (int expected = 0; expected < 200; expected++) {
+        EXPECT_EQ(heap.popMin(), expected);
+    }
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(MinMaxHeap, PopMax) {
+    MinMaxHeap<int> heap;
+    for (int i = 0; i < 200; i++) {
+        heap.push((i * 37) % 200);
+    }
+    for (int expected = 199; expected >= 0; expected--) {
+        EXPECT_EQ(heap.popMax(), expected);
+    }
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(MinMaxHeap, Alternating) {
+    MinMaxHeap<int> heap;
+    for (int i = 0; i < 101; i++) {
+        heap.push((i * 53) % 101);
+    }
+    int low = 0;
+    int high = 100;
+    while (!heap.isEmpty()) {
+        EXPECT_EQ(heap.popMin(), low++);
+        EXPECT_TRUE(heap.validHeap());
+        if (!heap.isEmpty()) {
+            EXPECT_EQ(heap.popMax(), high--);
+            EXPECT_TRUE(heap.validHeap());
+        }
+    }
+}
+
+TEST(MinMaxHeap, BoundedEvictMax) {
+    MinMaxHeap<int> heap(3);
+    int evicted = -1;
+    EXPECT_FALSE(heap.push(5));
+    EXPECT_FALSE(heap.push(9));
+    EXPECT_FALSE(heap.push(1));
+    EXPECT_TRUE(heap.isFull());
+
+    EXPECT_TRUE(heap.push(4, &evicted));
+    EXPECT_EQ(evicted, 9);
+    EXPECT_TRUE(heap.push(6, &evicted));
+    EXPECT_EQ(evicted, 6);
+    EXPECT_EQ(heap.length(), 3);
+    EXPECT_EQ(heap.peekMax(), 5);
+    EXPECT_EQ(heap.popMin(), 1);
+    EXPECT_FALSE(heap.push(2));
+}
+
+TEST(MinMaxHeap, BoundedEvictMin) {
+    MinMaxHeap<int> heap(2, false);
+    int evicted = -1;
+    heap.push(5);
+    heap.push(3);
+
+    EXPECT_TRUE(heap.push(8, &evicted));
+    EXPECT_EQ(evicted, 3);
+    EXPECT_TRUE(heap.push(1, &evicted));
+    EXPECT_EQ(evicted, 1);
+    EXPECT_EQ(heap.popMax(), 8);
+    EXPECT_EQ(heap.popMax(), 5);
+}
+
+struct Request {
+    int id;
+    int urgency;
+};
+
+TEST(MinMaxHeap, KeyProjection) {
+    MinMaxHeap<Request, std::less<>, int Request::*> heap(0, true, std::less<>(), &Request::urgency);
+    heap.push({1, 30});
+    heap.push({2, 10});
+    heap.push({3, 20});
+
+    EXPECT_EQ(heap.peekMin().id, 2);
+    EXPECT_EQ(heap.peekMax().id, 1);
+    heap.clear();
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(MinMaxHeap, NotCopyable) {
+    // The heap owns its storage, so copying it would double-free
+    EXPECT_FALSE((std::is_copy_constructible_v<MinMaxHeap<int>>));
+    EXPECT_FALSE((std::is_copy_assignable_v<MinMaxHeap<int>>));
+}
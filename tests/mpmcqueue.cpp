@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+TEST(MPMCQueue, Constructor) {
+    MPMCQueue<int> queue(10);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.length(), 0);
+    EXPECT_EQ(queue.capacity(), 16);
+
+    EXPECT_EQ(MPMCQueue<int>(1).capacity(), 2);
+    EXPECT_THROW(MPMCQueue<int>(0), std::invalid_argument);
+}
+
+TEST(MPMCQueue, PushPop) {
+    MPMCQueue<int> queue(4);
+
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_EQ(queue.length(), 2);
+
+    int out;
+    EXPECT_TRUE(queue.tryPop(out));
+    EXPECT_EQ(out, 1);
+    EXPECT_TRUE(queue.tryPop(out));
+    EXPECT_EQ(out, 2);
+    EXPECT_FALSE(queue.tryPop(out));
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(MPMCQueue, Full) {
+    MPMCQueue<int> queue(4);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int out;
+    queue.tryPop(out);
+    EXPECT_TRUE(queue.tryPush(4));
+
+    for (int i = 1; i <= 4; i++) {
+        EXPECT_TRUE(queue.tryPop(out));
+        EXPECT_EQ(out, i);
+    }
+}
+
+TEST(MPMCQueue, Batch) {
+    MPMCQueue<int> queue(8);
+    int values[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int out[10];
+
+    EXPECT_EQ(queue.pushMany(values, 6), 6);
+    EXPECT_EQ(queue.popMany(out, 4), 4);
+    EXPECT_EQ(queue.pushMany(values + 6, 4), 4);
+    EXPECT_EQ(queue.pushMany(values, 10), 2);
+    EXPECT_EQ(queue.length(), 8);
+
+    EXPECT_EQ(queue.popMany(out, 10), 8);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(out[i], i + 4);
+    }
+    EXPECT_EQ(out[6], 0);
+    EXPECT_EQ(out[7], 1);
+    EXPECT_EQ(queue.popMany(out, 10), 0);
+}
+
+TEST(MPMCQueue, ManyThreads) {
+    const int producers = 4;
+    const int consumers = 4;
+    const int per_producer = 20000;
+    MPMCQueue<int> queue(64);
+    std::atomic<long long> sum(0);
+    std::atomic<int> received(0);
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p]() {
+            for (int i = 0; i < per_producer; i++) {
+                int value = p * per_producer + i;
+                while (!queue.tryPush(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&, c]() {
+            int out[8];
+            while (received.load() < producers * per_producer) {
+                int got = c % 2 == 0 ? queue.popMany(out, 8) : queue.tryPop(out[0]);
+                if (got == 0) {
+                    std::this_thread::yield();
+                }
+                for (int i = 0; i < got; i++) {
+                    sum += out[i];
+                }
+                received += got;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    long long total = (long long)producers * per_producer;
+    EXPECT_EQ(received.load(), total);
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+    EXPECT_TRUE(queue.isEmpty());
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+TEST(MultiQueue, Constructor) {
+    MultiQueue<int> queue(4, 2);
+    int out;
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.shardCount(), 8);
+    EXPECT_TRUE(queue.isMin());
+    EXPECT_FALSE(queue.tryPop(out));
+    EXPECT_THROW((MultiQueue<int>(-1)), std::invalid_argument);
+    EXPECT_THROW((MultiQueue<int>(1, 0)), std::invalid_argument);
+    EXPECT_GE(MultiQueue<int>().shardCount(), 2);
+}
+
+TEST(MultiQueue, SingleShardIsExact) {
+    MultiQueue<int> queue(1, 1);
+    for (int i = 0; i < 100; i++) {
+        queue.push((i * 37) % 100);
+    }
+    int out;
+    for (int expected = 0; expected < 100; expected++) {
+        ASSERT_TRUE(queue.tryPop(out));
+        EXPECT_EQ(out, expected);
+    }
+    EXPECT_FALSE(queue.tryPop(out));
+}
+
+TEST(MultiQueue, MaxQueue) {
+    MultiQueue<int> queue(1, 1, true);
+    queue.push(3);
+    queue.push(9);
+    queue.push(1);
+    int out;
+    queue.tryPop(out);
+    EXPECT_EQ(out, 9);
+}
+
+TEST(MultiQueue, RankError) {
+    const int n = 2000;
+    MultiQueue<int> queue(4, 2);
+    std::vector<bool> present(n, true);
+    for (int i = 0; i < n; i++) {
+        queue.push((i * 7) % n);
+    }
+    EXPECT_EQ(queue.length(), n);
+
+    // Rank error of a pop is the number of smaller elements still in the queue
+    long long total = 0;
+    int out;
+    for (int i = 0; i < n; i++) {
+        ASSERT_TRUE(queue.tryPop(out));
+        ASSERT_TRUE(present[out]);
+        present[out] = false;
+        for (int smaller = 0; smaller < out; smaller++) {
+            total += present[smaller];
+        }
+    }
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_LT(static_cast<double>(total) / n, 8.0 * queue.shardCount());
+}
+
+TEST(MultiQueue, Concurrent) {
+    const int threads = 4;
+    const int per_thread = 20000;
+    MultiQueue<int> queue(threads, 2);
+    std::atomic<long long> sum(0);
+    std::atomic<int> popped(0);
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            int out;
+            for (int i = 0; i < per_thread; i++) {
+                queue.push(t * per_thread + i);
+                if (queue.tryPop(out)) {
+                    sum += out;
+                    popped++;
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    int out;
+    while (queue.tryPop(out)) {
+        sum += out;
+        popped++;
+    }
+    long long total = static_cast<long long>(threads) * per_thread;
+    EXPECT_EQ(popped.load(), total);
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+TEST(PairingHeap, Constructor) {
+    PairingHeap<int> heap;
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(heap.length(), 0);
+    EXPECT_TRUE(heap.isMin());
+    EXPECT_TRUE(heap.validHeap());
+    EXPECT_THROW(heap.pop(), std::runtime_error);
+    EXPECT_THROW(heap.peek(), std::runtime_error);
+}
+
+TEST(PairingHeap, PushPop) {
+    PairingHeap<int> heap;
+    for (int i = 0; i < 300; i++) {
+        heap.push((i * 71) % 300);
+    }
+
+    EXPECT_EQ(heap.length(), 300);
+    EXPECT_EQ(heap.peek(), 0);
+    EXPECT_TRUE(heap.validHeap());
+    for (int expected = 0; expected < 300; expected++) {
+        EXPECT_EQ(heap.pop(), expected);
+    }
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(PairingHeap, MaxHeap) {
+    PairingHeap<int> heap(true);
+    int values[] = {5, 3, 8, 1, 9, 2};
+    for (int value : values) {
+        heap.push(value);
+    }
+
+    for (int expected : {9, 8, 5, 3, 2, 1}) {
+        EXPECT_EQ(heap.pop(), expected);
+    }
+}
+
+TEST(PairingHeap, Meld) {
+    PairingHeap<int> heap_1;
+    PairingHeap<int> heap_2;
+    for (int i = 0; i < 100; i++) {
+        heap_1.push(2 * i);
+        heap_2.push(2 * i + 1);
+    }
+    PairingHeap<int>::Handle handle = heap_2.push(500);
+
+    heap_1.meld(heap_2);
+    EXPECT_EQ(heap_1.length(), 201);
+    EXPECT_TRUE(heap_2.isEmpty());
+    EXPECT_TRUE(heap_1.validHeap());
+    EXPECT_TRUE(heap_2.validHeap());
+
+    heap_1.decreaseKey(handle, -1);
+    EXPECT_EQ(heap_1.pop(), -1);
+    for (int expected = 0; expected < 200; expected++) {
+        EXPECT_EQ(heap_1.pop(), expected);
+    }
+
+    heap_2.push(7);
+    EXPECT_EQ(heap_2.pop(), 7);
+}
+
+TEST(PairingHeap, MeldIntoEmpty) {
+    PairingHeap<int> heap_1;
+    PairingHeap<int> heap_2;
+    heap_2.push(3);
+    heap_2.push(1);
+
+    heap_1.meld(heap_2);
+    heap_1.push(2);
+    EXPECT_EQ(heap_1.pop(), 1);
+    EXPECT_EQ(heap_1.pop(), 2);
+    EXPECT_EQ(heap_1.pop(), 3);
+
+    PairingHeap<int> heap_3(true);
+    EXPECT_THROW(heap_1.meld(heap_3), std::invalid_argument);
+}
+
+TEST(PairingHeap, DecreaseKey) {
+    PairingHeap<int> heap;
+    PairingHeap<int>::Handle handles[50];
+    for (int i = 0; i < 50; i++) {
+        handles[i] = heap.push(100 + i);
+    }
+    heap.pop();
+
+    heap.decreaseKey(handles[30], 5);
+    heap.decreaseKey(handles[10], 7);
+    EXPECT_TRUE(heap.validHeap());
+    EXPECT_EQ(heap.get(handles[30]), 5);
+    EXPECT_THROW(heap.decreaseKey(handles[20], 500), std::invalid_argument);
+
+    EXPECT_EQ(heap.pop(), 5);
+    EXPECT_EQ(heap.pop(), 7);
+    EXPECT_EQ(heap.pop(), 101);
+}
+
+TEST(PairingHeap, Clear) {
+    PairingHeap<int> heap;
+    for (int i = 0; i < 100; i++) {
+        heap.push(i);
+    }
+    heap.clear();
+
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_TRUE(heap.validHeap());
+    heap.push(4);
+    EXPECT_EQ(heap.peek(), 4);
+}
+
+TEST(PairingHeap, NodeReuse) {
+    PairingHeap<std::string> heap;
+    for (int round = 0; round < 10; round++) {
+        for (int i = 0; i < 100; i++) {
+            heap.push(std::to_string(1000 + i));
+        }
+        for (int i = 0; i < 100; i++) {
+            EXPECT_EQ(heap.pop(), std::to_string(1000 + i));
+        }
+    }
+    EXPECT_TRUE(heap.isEmpty());
+}
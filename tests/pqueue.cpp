@@ -247,3 +247,278 @@ TEST(PQueue, LargeOperations) {
     
     EXPECT_TRUE(maxHeap.isEmpty());
 }
+
+struct Job {
+    int id;
+    int deadline;
+
+    bool operator==(const Job& other) const { return id == other.id; }
+};
+
+TEST(PQueue, GreaterComparator) {
+    PQueue<int, std::greater<>> pqueue;
+
+    pqueue.push(5);
+    pqueue.push(3);
+    pqueue.push(8);
+
+    EXPECT_EQ(pqueue.peek(), 8);
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.pop(), 8);
+    EXPECT_EQ(pqueue.pop(), 5);
+    EXPECT_EQ(pqueue.pop(), 3);
+}
+
+TEST(PQueue, KeyProjection) {
+    auto deadline = [](const Job& job) { return job.deadline; };
+    PQueue<Job, std::less<>, decltype(deadline)> pqueue;
+
+    pqueue.push({1, 30});
+    pqueue.push({2, 10});
+    pqueue.push({3, 20});
+
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.pop().id, 2);
+    EXPECT_EQ(pqueue.pop().id, 3);
+    EXPECT_EQ(pqueue.pop().id, 1);
+}
+
+TEST(PQueue, MemberKey) {
+    PQueue<Job, std::less<>, int Job::*> pqueue(true, std::less<>(), &Job::deadline);
+
+    pqueue.push({1, 30});
+    pqueue.push({2, 10});
+    pqueue.push({3, 20});
+
+    EXPECT_TRUE(pqueue.removeValue({3, 0}));
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.pop().id, 1);
+    EXPECT_EQ(pqueue.pop().id, 2);
+}
+
+TEST(PQueue, ArrayConstructorComparator) {
+    int values[] = {5, 3, 8, 1, 2};
+    PQueue<int, std::greater<>> pqueue(values, 5);
+
+    EXPECT_TRUE(pqueue.validHeap());
+    for (int expected : {8, 5, 3, 2, 1}) {
+        EXPECT_EQ(pqueue.pop(), expected);
+    }
+}
+
+TEST(PQueue, Duplicates) {
+    PQueue<int> pqueue;
+    int values[] = {4, 1, 4, 1, 2, 2, 4};
+    for (int value : values) {
+        pqueue.push(value);
+    }
+
+    EXPECT_TRUE(pqueue.removeValue(4));
+    EXPECT_TRUE(pqueue.validHeap());
+    for (int expected : {1, 1, 2, 2, 4, 4}) {
+        EXPECT_EQ(pqueue.pop(), expected);
+    }
+}
+
+TEST(PQueue, Arity) {
+    PQueue<int> binary;
+    PQueue<int, std::less<>, std::identity, 4> quaternary;
+    EXPECT_EQ(binary.arity(), 2);
+    EXPECT_EQ(quaternary.arity(), 4);
+    EXPECT_TRUE(quaternary.isEmpty());
+    EXPECT_THROW(quaternary.pop(), std::runtime_error);
+}
+
+TEST(PQueue, QuaternaryHeap) {
+    PQueue<int, std::less<>, std::identity, 4> minHeap;
+    PQueue<int, std::less<>, std::identity, 4> maxHeap(true);
+    for (int i = 0; i < 200; i++) {
+        int value = (i * 37) % 101;
+        minHeap.push(value);
+        maxHeap.push(value);
+    }
+
+    EXPECT_EQ(minHeap.length(), 200);
+    EXPECT_TRUE(minHeap.validHeap());
+    EXPECT_TRUE(maxHeap.validHeap());
+    EXPECT_EQ(minHeap.peek(), 0);
+    EXPECT_EQ(maxHeap.peek(), 100);
+
+    int prevMin = minHeap.pop();
+    int prevMax = maxHeap.pop();
+    while (!minHeap.isEmpty()) {
+        int nextMin = minHeap.pop();
+        int nextMax = maxHeap.pop();
+        EXPECT_LE(prevMin, nextMin);
+        EXPECT_GE(prevMax, nextMax);
+        prevMin = nextMin;
+        prevMax = nextMax;
+    }
+    EXPECT_TRUE(maxHeap.isEmpty());
+}
+
+TEST(PQueue, WideHeapSimd) {
+    PQueue<float, std::greater<>, std::identity, 8> floats;
+    PQueue<int, std::less<>, std::identity, 16> ints;
+    for (int i = 0; i < 500; i++) {
+        floats.push(static_cast<float>((i * 53) % 211));
+        ints.push((i * 53) % 211);
+    }
+
+    EXPECT_TRUE(floats.validHeap());
+    EXPECT_TRUE(ints.validHeap());
+    EXPECT_EQ(floats.peek(), 210.0f);
+    EXPECT_EQ(ints.peek(), 0);
+    for (int i = 0; i < 250; i++) {
+        float largest = floats.pop();
+        int smallest = ints.pop();
+        EXPECT_GE(largest, floats.peek());
+        EXPECT_LE(smallest, ints.peek());
+    }
+    EXPECT_TRUE(floats.validHeap());
+    EXPECT_TRUE(ints.validHeap());
+}
+
+TEST(PQueue, WideHeapArrayConstructor) {
+    int values[] = {9, 4, 7, 1, 8, 2, 6, 3, 5, 0, 11, 10};
+    PQueue<int, std::less<>, std::identity, 8> pqueue(values, 12);
+
+    EXPECT_EQ(pqueue.length(), 12);
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.find(0), 0);
+    EXPECT_TRUE(pqueue.removeValue(7));
+    EXPECT_FALSE(pqueue.contains(7));
+    EXPECT_TRUE(pqueue.validHeap());
+
+    pqueue.clear();
+    EXPECT_TRUE(pqueue.isEmpty());
+    pqueue.push(3);
+    pqueue.push(1);
+    EXPECT_EQ(pqueue.pop(), 1);
+    EXPECT_EQ(pqueue.pop(), 3);
+}
+
+TEST(PQueue, WideHeapKeyProjection) {
+    PQueue<Job, std::less<>, int Job::*, 4> pqueue(false, std::less<>(), &Job::deadline);
+    for (int i = 0; i < 50; i++) {
+        pqueue.push({i, (i * 17) % 50});
+    }
+
+    EXPECT_TRUE(pqueue.validHeap());
+    for (int expected = 0; expected < 50; expected++) {
+        EXPECT_EQ(pqueue.pop().deadline, expected);
+    }
+}
+
+TEST(PQueue, PushManySmallBatch) {
+    PQueue<int> pqueue;
+    for (int i = 0; i < 100; i++) {
+        pqueue.push(100 + i);
+    }
+    int batch[] = {50, 250, 5};
+    pqueue.pushMany(batch, 3);
+
+    EXPECT_EQ(pqueue.length(), 103);
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.pop(), 5);
+    EXPECT_EQ(pqueue.pop(), 50);
+}
+
+TEST(PQueue, PushManyBulk) {
+    PQueue<int, std::less<>, std::identity, 4> pqueue(true);
+    pqueue.push(7);
+    int batch[64];
+    for (int i = 0; i < 64; i++) {
+        batch[i] = (i * 29) % 64;
+    }
+    pqueue.pushMany(batch, 64);
+    pqueue.pushMany(batch, 0);
+
+    EXPECT_EQ(pqueue.length(), 65);
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.pop(), 63);
+    EXPECT_EQ(pqueue.pop(), 62);
+}
+
+TEST(PQueue, PushPop) {
+    PQueue<int> pqueue;
+    EXPECT_EQ(pqueue.pushPop(5), 5);
+    EXPECT_TRUE(pqueue.isEmpty());
+
+    pqueue.push(3);
+    pqueue.push(8);
+    EXPECT_EQ(pqueue.pushPop(1), 1);
+    EXPECT_EQ(pqueue.pushPop(3), 3);
+    EXPECT_EQ(pqueue.pushPop(6), 3);
+    EXPECT_EQ(pqueue.length(), 2);
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.pop(), 6);
+    EXPECT_EQ(pqueue.pop(), 8);
+}
+
+TEST(PQueue, PopMany) {
+    int values[] = {9, 4, 7, 1, 8};
+    PQueue<int> pqueue(values, 5);
+    int out[10];
+
+    EXPECT_EQ(pqueue.popMany(3, out), 3);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 4);
+    EXPECT_EQ(out[2], 7);
+    EXPECT_EQ(pqueue.popMany(10, out), 2);
+    EXPECT_EQ(out[1], 9);
+    EXPECT_EQ(pqueue.popMany(10, out), 0);
+}
+
+TEST(PQueue, TopK) {
+    PQueue<int, std::less<>, std::identity, 4> pqueue(true);
+    for (int i = 0; i < 100; i++) {
+        pqueue.push((i * 37) % 100);
+    }
+    int out[200];
+
+    EXPECT_EQ(pqueue.topK(5, out), 5);
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(out[i], 99 - i);
+    }
+    EXPECT_EQ(pqueue.length(), 100);
+    EXPECT_EQ(pqueue.topK(200, out), 100);
+    EXPECT_EQ(out[99], 0);
+
+    PQueue<int> empty;
+    EXPECT_EQ(empty.topK(3, out), 0);
+}
+
+TEST(PQueue, Sort) {
+    PQueue<int, std::less<>, std::identity, 4> pqueue(true);
+    for (int i = 0; i < 100; i++) {
+        pqueue.push((i * 37) % 100);
+    }
+    const int* sorted = pqueue.sort();
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(sorted[i], 99 - i);
+    }
+    // The sorted array is still a valid heap
+    EXPECT_TRUE(pqueue.validHeap());
+    EXPECT_EQ(pqueue.length(), 100);
+    pqueue.push(150);
+    EXPECT_EQ(pqueue.pop(), 150);
+    EXPECT_EQ(pqueue.pop(), 99);
+}
+
+TEST(PQueue, Reserve) {
+    PQueue<int> pqueue;
+    pqueue.reserve(100);
+    int capacity = pqueue.capacity();
+    EXPECT_GE(capacity, 100);
+    for (int i = 0; i < 100; i++) {
+        pqueue.push(i);
+    }
+    EXPECT_EQ(pqueue.capacity(), capacity);
+    while (!pqueue.isEmpty()) {
+        pqueue.pop();
+    }
+    EXPECT_EQ(pqueue.capacity(), capacity);
+    pqueue.clear();
+    EXPECT_EQ(pqueue.capacity(), capacity);
+}
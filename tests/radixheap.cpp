@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+TEST(RadixHeap, Constructor) {
+    RadixHeap<unsigned, int> heap;
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(heap.length(), 0);
+    EXPECT_EQ(heap.lastKey(), 0u);
+    EXPECT_THROW(heap.pop(), std::runtime_error);
+    EXPECT_THROW(heap.peekKey(), std::runtime_error);
+}
+
+TEST(RadixHeap, PushPop) {
+    RadixHeap<unsigned, int> heap;
+    unsigned keys[] = {50, 3, 17, 3, 1000, 0, 64, 65};
+    for (int i = 0; i < 8; i++) {
+        heap.push(keys[i], i);
+    }
+
+    EXPECT_EQ(heap.length(), 8);
+    EXPECT_EQ(heap.peekKey(), 0u);
+    unsigned prev = 0;
+    while (!heap.isEmpty()) {
+        std::pair<unsigned, int> entry = heap.pop();
+        EXPECT_EQ(entry.first, keys[entry.second]);
+        EXPECT_GE(entry.first, prev);
+        prev = entry.first;
+    }
+    EXPECT_EQ(prev, 1000u);
+}
+
+TEST(RadixHeap, Monotone) {
+    RadixHeap<unsigned, int> heap;
+    heap.push(10, 0);
+    heap.push(20, 1);
+    EXPECT_EQ(heap.pop().first, 10u);
+    EXPECT_EQ(heap.lastKey(), 10u);
+
+    EXPECT_THROW(heap.push(9, 2), std::invalid_argument);
+    heap.push(10, 3);
+    heap.push(15, 4);
+    EXPECT_EQ(heap.pop().second, 3);
+    EXPECT_EQ(heap.pop().second, 4);
+    EXPECT_EQ(heap.pop().second, 1);
+}
+
+TEST(RadixHeap, PeekThenPush) {
+    RadixHeap<unsigned, int> heap;
+    heap.push(5, 0);
+    heap.push(40, 1);
+    EXPECT_EQ(heap.pop().first, 5u);
+
+    // Peeking must not raise the floor above the last popped key
+    EXPECT_EQ(heap.peekKey(), 40u);
+    EXPECT_EQ(heap.lastKey(), 5u);
+    heap.push(12, 2);
+    EXPECT_EQ(heap.peekKey(), 12u);
+    heap.push(5, 3);
+    EXPECT_EQ(heap.peekKey(), 5u);
+    EXPECT_THROW(heap.push(4, 4), std::invalid_argument);
+
+    EXPECT_EQ(heap.pop().second, 3);
+    EXPECT_EQ(heap.pop().second, 2);
+    EXPECT_EQ(heap.pop().second, 1);
+    EXPECT_TRUE(heap.isEmpty());
+}
+
+TEST(RadixHeap, Interleaved) {
+    RadixHeap<std::uint64_t, int> heap;
+    std::uint64_t current = 0;
+    std::uint64_t seed = 12345;
+    for (int i = 0; i < 1000; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        heap.push(current + (seed >> 40), i);
+        if (i % 3 == 2) {
+            std::uint64_t key = heap.pop().first;
+            EXPECT_GE(key, current);
+            current = key;
+        }
+    }
+    while (!heap.isEmpty()) {
+        std::uint64_t key = heap.pop().first;
+        EXPECT_GE(key, current);
+        current = key;
+    }
+}
+
+TEST(RadixHeap, LargeKeys) {
+    RadixHeap<std::uint64_t, int> heap;
+    heap.push(~0ULL, 1);
+    heap.push(1ULL << 63, 2);
+    heap.push(0, 3);
+
+    EXPECT_EQ(heap.pop().second, 3);
+    EXPECT_EQ(heap.pop().second, 2);
+    EXPECT_EQ(heap.pop().second, 1);
+}
+
+TEST(RadixHeap, Clear) {
+    RadixHeap<unsigned, int> heap;
+    heap.push(5, 0);
+    heap.push(7, 1);
+    heap.pop();
+    heap.clear();
+
+    EXPECT_TRUE(heap.isEmpty());
+    EXPECT_EQ(heap.lastKey(), 0u);
+    heap.push(1, 2);
+    EXPECT_EQ(heap.pop().second, 2);
+}
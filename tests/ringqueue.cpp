@@ -0,0 +1,228 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "../include/strux.h"
+
+TEST(RingQueue, Constructor) {
+    RingQueue<int> queue;
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.length(), 0);
+    EXPECT_EQ(queue.capacity(), 1);
+}
+
+TEST(RingQueue, SizeConstructor) {
+    RingQueue<int> queue(10);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.capacity(), 16);
+}
+
+TEST(RingQueue, ArrayConstructor) {
+    int values[] = {1, 2, 3, 4, 5};
+    RingQueue<int> queue(values, 5);
+
+    EXPECT_EQ(queue.length(), 5);
+    EXPECT_EQ(queue.capacity(), 8);
+
+    for (int i = 0; i < 5; i++) {
+        EXPECT_EQ(queue.pop(), values[i]);
+    }
+}
+
+TEST(RingQueue, Enqueue) {
+    RingQueue<int> queue;
+
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    EXPECT_EQ(queue.length(), 3);
+    EXPECT_EQ(queue.capacity(), 4);
+    EXPECT_EQ(queue.peek(), 1);
+}
+
+TEST(RingQueue, Dequeue) {
+    RingQueue<int> queue;
+
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), 3);
+    EXPECT_TRUE(queue.isEmpty());
+
+    EXPECT_THROW(queue.pop(), std::runtime_error);
+    EXPECT_THROW(queue.peek(), std::runtime_error);
+}
+
+TEST(RingQueue, Wraparound) {
+    RingQueue<int> queue(4);
+
+    for (int round = 0; round < 10; round++) {
+        queue.push(round * 3);
+        queue.push(round * 3 + 1);
+        queue.push(round * 3 + 2);
+        EXPECT_EQ(queue.pop(), round * 3);
+        EXPECT_EQ(queue.pop(), round * 3 + 1);
+        EXPECT_EQ(queue.pop(), round * 3 + 2);
+    }
+    EXPECT_EQ(queue.capacity(), 4);
+}
+
+TEST(RingQueue, GrowWhileWrapped) {
+    RingQueue<int> queue(4);
+
+    queue.push(0);
+    queue.push(1);
+    queue.push(2);
+    queue.pop();
+    queue.pop();
+    for (int i = 3; i < 8; i++) {
+        queue.push(i);
+    }
+
+    EXPECT_EQ(queue.capacity(), 8);
+    for (int i = 2; i < 8; i++) {
+        EXPECT_EQ(queue.pop(), i);
+    }
+}
+
+TEST(RingQueue, Reserve) {
+    RingQueue<int> queue;
+    queue.reserve(100);
+    EXPECT_EQ(queue.capacity(), 128);
+
+    queue.reserve(10);
+    EXPECT_EQ(queue.capacity(), 128);
+}
+
+TEST(RingQueue, PushMany) {
+    int values[] = {1, 2, 3, 4, 5, 6};
+    RingQueue<int> queue(8);
+
+    queue.push(0);
+    queue.push(0);
+    queue.push(0);
+    queue.push(0);
+    queue.pop();
+    queue.pop();
+    queue.pop();
+    queue.pop();
+
+    queue.pushMany(values, 6);
+    EXPECT_EQ(queue.length(), 6);
+    EXPECT_EQ(queue.capacity(), 8);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(queue.get(i), values[i]);
+    }
+
+    queue.pushMany(values, 6);
+    EXPECT_EQ(queue.length(), 12);
+    EXPECT_EQ(queue.capacity(), 16);
+    for (int i = 0; i < 12; i++) {
+        EXPECT_EQ(queue.pop(), values[i % 6]);
+    }
+}
+
+TEST(RingQueue, PushManyBadSizes) {
+    int values[] = {1, 2, 3};
+    RingQueue<int> queue;
+    queue.pushMany(values, 3);
+
+    queue.pushMany(values, 0);
+    queue.pushMany(values, -2);
+    EXPECT_EQ(queue.length(), 3);
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(queue.pop(), values[i]);
+    }
+
+    EXPECT_THROW(queue.reserve((1 << 30) + 1), std::length_error);
+    EXPECT_THROW(queue.pushMany(values, 2147483647), std::length_error);
+    EXPECT_THROW(RingQueue<int>(2147483647), std::length_error);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(RingQueue, PopMany) {
+    RingQueue<int> queue(8);
+    int out[8];
+
+    for (int i = 0; i < 6; i++) {
+        queue.push(i);
+    }
+    EXPECT_EQ(queue.popMany(out, 4), 4);
+    for (int i = 6; i < 12; i++) {
+        queue.push(i);
+    }
+
+    EXPECT_EQ(queue.popMany(out, 8), 8);
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(out[i], i + 4);
+    }
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.popMany(out, 8), 0);
+}
+
+TEST(RingQueue, Get) {
+    int values[] = {1, 2, 3};
+    RingQueue<int> queue(values, 3);
+
+    EXPECT_EQ(queue.get(0), 1);
+    EXPECT_EQ(queue.get(2), 3);
+    EXPECT_THROW(queue.get(3), std::out_of_range);
+    EXPECT_THROW(queue.get(-1), std::out_of_range);
+}
+
+TEST(RingQueue, Contains) {
+    int values[] = {1, 2, 3};
+    RingQueue<int> queue(values, 3);
+
+    EXPECT_TRUE(queue.contains(2));
+    EXPECT_FALSE(queue.contains(4));
+}
+
+TEST(RingQueue, Clear) {
+    RingQueue<int> queue;
+
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    queue.clear();
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.length(), 0);
+    EXPECT_EQ(queue.capacity(), 1);
+}
+
+TEST(RingQueue, MultipleTypes) {
+    RingQueue<std::string> qs;
+    std::string values[] = {"a", "b", "c"};
+    qs.pushMany(values, 3);
+    qs.push("d");
+
+    std::string out[4];
+    EXPECT_EQ(qs.popMany(out, 4), 4);
+    EXPECT_EQ(out[0], "a");
+    EXPECT_EQ(out[3], "d");
+
+    RingQueue<char> qc;
+    qc.push('A');
+    EXPECT_EQ(qc.peek(), 'A');
+}
+
+TEST(RingQueue, LargeOperations) {
+    RingQueue<int> queue;
+
+    for (int i = 0; i < 1000; i++) {
+        queue.push(i);
+    }
+
+    EXPECT_EQ(queue.length(), 1000);
+    EXPECT_EQ(queue.capacity(), 1024);
+
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(queue.pop(), i);
+    }
+
+    EXPECT_TRUE(queue.isEmpty());
+}
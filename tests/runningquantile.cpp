@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "../include/strux.h"
+
+static int nearestRank(std::vector<int> values, double q) {
+    std::sort(values.begin(), values.end());
+    return values[static_cast<int>(q * (values.size() - 1))];
+}
+
+TEST(RunningQuantile, Constructor) {
+    RunningQuantile<int> median;
+    EXPECT_TRUE(median.isEmpty());
+    EXPECT_EQ(median.length(), 0);
+    EXPECT_EQ(median.fraction(), 0.5);
+    EXPECT_EQ(median.windowSize(), 0);
+    EXPECT_FALSE(median.isApproximate());
+    EXPECT_THROW(median.quantile(), std::runtime_error);
+
+    EXPECT_THROW(RunningQuantile<int>(-0.1), std::invalid_argument);
+    EXPECT_THROW(RunningQuantile<int>(1.5), std::invalid_argument);
+    EXPECT_THROW(RunningQuantile<int>(0.5, -1), std::invalid_argument);
+    EXPECT_THROW(RunningQuantile<int>(0.5, 10, 10), std::invalid_argument);
+}
+
+TEST(RunningQuantile, Median) {
+    RunningQuantile<int> median;
+    median.push(5);
+    EXPECT_EQ(median.quantile(), 5);
+    median.push(1);
+    EXPECT_EQ(median.quantile(), 1);
+    median.push(9);
+    EXPECT_EQ(median.quantile(), 5);
+    median.push(7);
+    EXPECT_EQ(median.quantile(), 5);
+    median.push(8);
+    EXPECT_EQ(median.quantile(), 7);
+    EXPECT_EQ(median.length(), 5);
+    EXPECT_EQ(median.count(), 5u);
+}
+
+TEST(RunningQuantile, Extremes) {
+    RunningQuantile<int> minimum(0);
+    RunningQuantile<int> maximum(1);
+    int values[] = {4, -2, 8, 8, 0, 15, -7};
+    for (int value : values) {
+        minimum.push(value);
+        maximum.push(value);
+    }
+    EXPECT_EQ(minimum.quantile(), -7);
+    EXPECT_EQ(maximum.quantile(), 15);
+}
+
+TEST(RunningQuantile, MatchesSort) {
+    std::mt19937 rng(7);
+    double fractions[] = {0.1, 0.5, 0.9, 0.99};
+    for (double q : fractions) {
+        RunningQuantile<int> tracker(q);
+        std::vector<int> values;
+        for (int i = 0; i < 2000; i++) {
+            int value = static_cast<int>(rng() % 500);
+            tracker.push(value);
+            values.push_back(value);
+            if (i % 97 == 0) {
+                EXPECT_EQ(tracker.quantile(), nearestRank(values, q));
+            }
+        }
+        EXPECT_EQ(tracker.quantile(), nearestRank(values, q));
+    }
+}
+
+TEST(RunningQuantile, Comparator) {
+    RunningQuantile<int, std::greater<>> tracker(0);
+    int values[] = {3, 9, 1, 4};
+    for (int value : values) {
+        tracker.push(value);
+    }
+    EXPECT_EQ(tracker.quantile(), 9);
+}
+
+TEST(RunningQuantile, Window) {
+    RunningQuantile<int> median(0.5, 3);
+    EXPECT_EQ(median.windowSize(), 3);
+    int values[] = {1, 100, 2, 3, 200, 300, 4};
+    int expected[] = {1, 1, 2, 3, 3, 200, 200};
+    for (int i = 0; i < 7; i++) {
+        median.push(values[i]);
+        EXPECT_EQ(median.quantile(), expected[i]);
+    }
+    EXPECT_EQ(median.length(), 3);
+    EXPECT_EQ(median.count(), 7u);
+}
+
+TEST(RunningQuantile, WindowMatchesSort) {
+    std::mt19937 rng(11);
+    double fractions[] = {0.0, 0.25, 0.5, 0.99, 1.0};
+    for (double q : fractions) {
+        RunningQuantile<int> tracker(q, 64);
+        std::vector<int> values;
+        for (int i = 0; i < 5000; i++) {
+            // A drifting stream with duplicates leaves retired entries throughout both heaps
+            int value = static_cast<int>(rng() % 100) + i / 10;
+            tracker.push(value);
+            values.push_back(value);
+            std::vector<int> window(values.end() - std::min<int>(values.size(), 64), values.end());
+            ASSERT_EQ(tracker.quantile(), nearestRank(window, q));
+            ASSERT_EQ(tracker.length(), static_cast<int>(window.size()));
+        }
+    }
+}
+
+TEST(RunningQuantile, Reservoir) {
+    RunningQuantile<int> median(0.5, 0, 2000);
+    RunningQuantile<int> p99(0.99, 0, 2000);
+    EXPECT_TRUE(median.isApproximate());
+    EXPECT_EQ(median.reservoirSize(), 2000);
+
+    std::mt19937 rng(3);
+    std::vector<int> values;
+    for (int i = 0; i < 200000; i++) {
+        int value = static_cast<int>(rng() % 1000000);
+        median.push(value);
+        p99.push(value);
+        values.push_back(value);
+    }
+    EXPECT_EQ(median.length(), 2000);
+    EXPECT_EQ(median.count(), 200000u);
+    EXPECT_NEAR(median.quantile(), nearestRank(values, 0.5), 50000);
+    EXPECT_NEAR(p99.quantile(), nearestRank(values, 0.99), 10000);
+}
+
+TEST(RunningQuantile, ReservoirExactWhileFilling) {
+    RunningQuantile<int> median(0.5, 0, 100);
+    std::vector<int> values;
+    for (int i = 0; i < 100; i++) {
+        median.push(i * 37 % 101);
+        values.push_back(i * 37 % 101);
+    }
+    EXPECT_EQ(median.quantile(), nearestRank(values, 0.5));
+}
+
+TEST(RunningQuantile, Clear) {
+    RunningQuantile<int> median(0.5, 4);
+    for (int i = 0; i < 10; i++) {
+        median.push(i);
+    }
+    median.clear();
+    EXPECT_TRUE(median.isEmpty());
+    EXPECT_EQ(median.count(), 0u);
+    EXPECT_THROW(median.quantile(), std::runtime_error);
+
+    median.push(42);
+    median.push(7);
+    EXPECT_EQ(median.quantile(), 7);
+}
+
+TEST(RunningQuantile, Doubles) {
+    RunningQuantile<double> p90(0.9);
+    for (int i = 1; i <= 100; i++) {
+        p90.push(i / 100.0);
+    }
+    EXPECT_DOUBLE_EQ(p90.quantile(), 0.9);
+}
@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+using namespace std::chrono_literals;
+
+static bool waitFor(std::atomic<int>& value, int target, std::chrono::milliseconds limit = 2000ms) {
+    auto end = std::chrono::steady_clock::now() + limit;
+    while (value.load() < target) {
+        if (std::chrono::steady_clock::now() > end) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+TEST(ScheduledExecutor, Constructor) {
+    ThreadPool pool(2);
+    ScheduledExecutor executor(pool, 2ms);
+    EXPECT_EQ(executor.tolerance(), std::chrono::steady_clock::duration(2ms));
+    EXPECT_EQ(executor.pending(), 0);
+    EXPECT_EQ(executor.wakeups(), 0u);
+
+    EXPECT_THROW(ScheduledExecutor(pool, -1ms), std::invalid_argument);
+}
+
+TEST(ScheduledExecutor, Schedule) {
+    ThreadPool pool(2);
+    ScheduledExecutor executor(pool);
+    std::atomic<int> count(0);
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<long long> elapsed(0);
+    executor.schedule([&]() {
+        elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        count++;
+    }, 20ms);
+    EXPECT_EQ(executor.pending(), 1);
+
+    ASSERT_TRUE(waitFor(count, 1));
+    EXPECT_GE(elapsed.load(), 19900);
+    EXPECT_EQ(executor.pending(), 0);
+}
+
+TEST(ScheduledExecutor, DeadlineOrder) {
+    ThreadPool pool(1);
+    ScheduledExecutor executor(pool, 0ms);
+    std::mutex lock;
+    std::vector<int> order;
+    std::atomic<int> count(0);
+
+    auto base = std::chrono::steady_clock::now() + 30ms;
+    int offsets[] = {5, 1, 4, 2, 3};
+    for (int offset : offsets) {
+        executor.scheduleAt([&, offset]() {
+            std::lock_guard<std::mutex> guard(lock);
+            order.push_back(offset);
+            count++;
+        }, base + std::chrono::milliseconds(offset * 5));
+    }
+
+    ASSERT_TRUE(waitFor(count, 5));
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 4, 5}));
+}
+
+TEST(ScheduledExecutor, TiesRunInScheduleOrder) {
+    ThreadPool pool(1);
+    ScheduledExecutor executor(pool);
+    std::vector<int> order;
+    std::atomic<int> count(0);
+
+    auto deadline = std::chrono::steady_clock::now() + 10ms;
+    for (int i = 0; i < 40; i++) {
+        executor.scheduleAt([&, i]() { order.push_back(i); count++; }, deadline);
+    }
+
+    ASSERT_TRUE(waitFor(count, 40));
+    for (int i = 0; i < 40; i++) {
+        EXPECT_EQ(order[i], i);
+    }
+}
+
+TEST(ScheduledExecutor, Coalescing) {
+    ThreadPool pool(2);
+    ScheduledExecutor executor(pool, 50ms);
+    std::atomic<int> count(0);
+
+    auto base = std::chrono::steady_clock::now() + 20ms;
+    for (int i = 0; i < 10; i++) {
+        executor.scheduleAt([&]() { count++; }, base + std::chrono::milliseconds(i * 2));
+    }
+
+    ASSERT_TRUE(waitFor(count, 10));
+    EXPECT_EQ(executor.wakeups(), 1u);
+}
+
+TEST(ScheduledExecutor, NeverEarly) {
+    // Deadlines a few microseconds apart, well inside the tolerance of each other
+    const int TASKS = 200;
+    ThreadPool pool(2);
+    for (auto tolerance : {std::chrono::steady_clock::duration(0), std::chrono::steady_clock::duration(100us), std::chrono::steady_clock::duration(5ms)}) {
+        ScheduledExecutor executor(pool, tolerance);
+        std::vector<std::chrono::steady_clock::time_point> deadlines(TASKS);
+        std::vector<std::chrono::steady_clock::time_point> runs(TASKS);
+        std::atomic<int> count(0);
+
+        auto base = std::chrono::steady_clock::now();
+        for (int i = 0; i < TASKS; i++) {
+            deadlines[i] = base + std::chrono::microseconds(i * 7);
+            executor.scheduleAt([&, i]() { runs[i] = std::chrono::steady_clock::now(); count++; }, deadlines[i]);
+        }
+        // A delay shorter than the tolerance must still be waited out
+        std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+        std::chrono::steady_clock::time_point delayed;
+        executor.schedule([&]() { delayed = std::chrono::steady_clock::now(); count++; }, 50us);
+
+        ASSERT_TRUE(waitFor(count, TASKS + 1));
+        for (int i = 0; i < TASKS; i++) {
+            EXPECT_GE(runs[i], deadlines[i]);
+        }
+        EXPECT_GE(delayed, before + 50us);
+    }
+}
+
+TEST(ScheduledExecutor, Cancel) {
+    ThreadPool pool(2);
+    ScheduledExecutor executor(pool);
+    std::atomic<int> count(0);
+
+    ScheduledExecutor::Handle handle = executor.schedule([&]() { count += 100; }, 20ms);
+    executor.schedule([&]() { count++; }, 30ms);
+    EXPECT_TRUE(executor.cancel(handle));
+    EXPECT_FALSE(executor.cancel(handle));
+    EXPECT_FALSE(executor.cancel(ScheduledExecutor::Handle()));
+    EXPECT_EQ(executor.pending(), 1);
+
+    ASSERT_TRUE(waitFor(count, 1));
+    std::this_thread::sleep_for(10ms);
+    EXPECT_EQ(count.load(), 1);
+}
+
+TEST(ScheduledExecutor, CancelAfterRun) {
+    ThreadPool pool(1);
+    ScheduledExecutor executor(pool);
+    std::atomic<int> count(0);
+
+    ScheduledExecutor::Handle handle = executor.schedule([&]() { count++; }, 1ms);
+    ASSERT_TRUE(waitFor(count, 1));
+    EXPECT_FALSE(executor.cancel(handle));
+}
+
+TEST(ScheduledExecutor, CancelMany) {
+    ThreadPool pool(2);
+    ScheduledExecutor executor(pool);
+    std::atomic<int> count(0);
+
+    std::vector<ScheduledExecutor::Handle> handles;
+    for (int i = 0; i < 1000; i++) {
+        handles.push_back(executor.schedule([&]() { count++; }, 10s));
+    }
+    executor.schedule([&]() { count++; }, 200ms);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_TRUE(executor.cancel(handles[i]));
+    }
+    EXPECT_EQ(executor.pending(), 1);
+
+    ASSERT_TRUE(waitFor(count, 1));
+    EXPECT_EQ(executor.pending(), 0);
+}
+
+TEST(ScheduledExecutor, FixedRate) {
+    ThreadPool pool(2);
+    ScheduledExecutor executor(pool, 0ms);
+    std::atomic<int> count(0);
+
+    auto start = std::chrono::steady_clock::now();
+    ScheduledExecutor::Handle handle = executor.scheduleAtFixedRate([&]() { count++; }, 0ms, 10ms);
+    ASSERT_TRUE(waitFor(count, 5));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, 40ms);
+    EXPECT_EQ(executor.pending(), 1);
+
+    EXPECT_TRUE(executor.cancel(handle));
+    EXPECT_FALSE(executor.cancel(handle));
+    std::this_thread::sleep_for(15ms);
+    int after = count.load();
+    std::this_thread::sleep_for(40ms);
+    EXPECT_EQ(count.load(), after);
+    EXPECT_EQ(executor.pending(), 0);
+
+    EXPECT_THROW(executor.scheduleAtFixedRate([]() {}, 0ms, 0ms), std::invalid_argument);
+}
+
+TEST(ScheduledExecutor, Batches) {
+    ThreadPool pool(4);
+    ScheduledExecutor executor(pool);
+    std::atomic<int> count(0);
+
+    auto deadline = std::chrono::steady_clock::now() + 10ms;
+    for (int i = 0; i < 1000; i++) {
+        executor.scheduleAt([&]() { count++; }, deadline);
+    }
+    ASSERT_TRUE(waitFor(count, 1000));
+    EXPECT_EQ(executor.wakeups(), 1u);
+}
+
+TEST(ScheduledExecutor, Exceptions) {
+    ThreadPool pool(1);
+    ScheduledExecutor executor(pool);
+    std::atomic<int> count(0);
+
+    auto deadline = std::chrono::steady_clock::now() + 5ms;
+    executor.scheduleAt([]() { throw std::runtime_error("task failed"); }, deadline);
+    executor.scheduleAt([&]() { count++; }, deadline);
+    ASSERT_TRUE(waitFor(count, 1));
+}
+
+TEST(ScheduledExecutor, ConcurrentSchedule) {
+    ThreadPool pool(2);
+    std::atomic<int> count(0);
+    {
+        ScheduledExecutor executor(pool);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < 250; i++) {
+                    ScheduledExecutor::Handle handle = executor.schedule([&]() { count++; }, std::chrono::microseconds(i * 10));
+                    if (i % 5 == t) {
+                        executor.cancel(handle);
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        waitFor(count, 800);
+    }
+    EXPECT_LE(count.load(), 1000);
+    EXPECT_GE(count.load(), 800);
+}
+
+TEST(ScheduledExecutor, DestructorDropsPending) {
+    ThreadPool pool(1);
+    std::atomic<int> count(0);
+    {
+        ScheduledExecutor executor(pool);
+        executor.schedule([&]() { count++; }, 10s);
+    }
+    EXPECT_EQ(count.load(), 0);
+}
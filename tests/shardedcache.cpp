@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+TEST(ShardedCache, Constructor) {
+    ShardedCache<LRUCache<int, int>> cache(100, 8);
+    EXPECT_TRUE(cache.isEmpty());
+    EXPECT_EQ(cache.shardCount(), 8);
+    EXPECT_EQ(cache.capacity(), 100);
+    EXPECT_THROW((ShardedCache<LRUCache<int, int>>(0)), std::invalid_argument);
+    EXPECT_THROW((ShardedCache<LRUCache<int, int>>(10, -1)), std::invalid_argument);
+
+    // Shards never outnumber the capacity
+    ShardedCache<ClockCache<int, int>> small(3, 16);
+    EXPECT_EQ(small.shardCount(), 3);
+    EXPECT_EQ(small.capacity(), 3);
+    ShardedCache<ClockCache<int, int>> automatic(1000);
+    EXPECT_GE(automatic.shardCount(), 1);
+}
+
+TEST(ShardedCache, GetPutRemove) {
+    ShardedCache<LRUCache<std::string, int>> cache(1000, 4);
+    EXPECT_TRUE(cache.put("a", 1));
+    EXPECT_FALSE(cache.put("a", 2));
+    EXPECT_TRUE(cache.put("b", 3));
+
+    int value = 0;
+    EXPECT_TRUE(cache.get(std::string("a"), value));
+    EXPECT_EQ(value, 2);
+    EXPECT_FALSE(cache.get(std::string("c"), value));
+    EXPECT_TRUE(cache.contains(std::string("b")));
+    EXPECT_EQ(cache.length(), 2);
+    EXPECT_EQ(cache.weight(), 2);
+
+    EXPECT_TRUE(cache.remove(std::string("a")));
+    EXPECT_FALSE(cache.contains(std::string("a")));
+    cache.clear();
+    EXPECT_TRUE(cache.isEmpty());
+}
+
+TEST(ShardedCache, BoundedWithEvictions) {
+    std::atomic<int> evicted{0};
+    ShardedCache<ClockCache<int, int>> cache(64, 4, {}, [&](const int&, const int&) { evicted++; });
+    for (int i = 0; i < 1000; i++) {
+        cache.put(i, i);
+    }
+    EXPECT_LE(cache.length(), 64);
+    EXPECT_EQ(cache.length() + evicted.load(), 1000);
+}
+
+TEST(ShardedCache, ConcurrentAccess) {
+    const int THREADS = 8;
+    const int OPS = 20000;
+    ShardedCache<LRUCache<int, int>> cache(512, 16);
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&, t]() {
+            unsigned seed = 12345u + t;
+            for (int i = 0; i < OPS; i++) {
+                seed = seed * 1103515245u + 12345u;
+                int key = static_cast<int>((seed >> 8) % 2048);
+                if (i % 3 == 0) {
+                    // Every value stored for a key is derived from it, so any hit can be checked
+                    cache.put(key, key * 7);
+                } else {
+                    int value;
+                    if (cache.get(key, value) && value != key * 7) {
+                        wrong++;
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(wrong.load(), 0);
+    EXPECT_LE(cache.length(), 512);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+#include "../include/strux.h"
+
+TEST(SPSCQueue, Constructor) {
+    SPSCQueue<int> queue(10);
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_EQ(queue.length(), 0);
+    EXPECT_EQ(queue.capacity(), 16);
+
+    EXPECT_THROW(SPSCQueue<int>(0), std::invalid_argument);
+}
+
+TEST(SPSCQueue, PushPop) {
+    SPSCQueue<int> queue(4);
+
+    EXPECT_TRUE(queue.tryPush(1));
+    EXPECT_TRUE(queue.tryPush(2));
+    EXPECT_EQ(queue.length(), 2);
+    EXPECT_EQ(queue.peek(), 1);
+
+    int out;
+    EXPECT_TRUE(queue.tryPop(out));
+    EXPECT_EQ(out, 1);
+    EXPECT_TRUE(queue.tryPop(out));
+    EXPECT_EQ(out, 2);
+    EXPECT_FALSE(queue.tryPop(out));
+    EXPECT_THROW(queue.peek(), std::runtime_error);
+}
+
+TEST(SPSCQueue, Full) {
+    SPSCQueue<int> queue(4);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int out;
+    queue.tryPop(out);
+    EXPECT_TRUE(queue.tryPush(4));
+    EXPECT_EQ(queue.length(), 4);
+}
+
+TEST(SPSCQueue, Batch) {
+    SPSCQueue<int> queue(8);
+    int values[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    int out[10];
+
+    EXPECT_EQ(queue.pushMany(values, 6), 6);
+    EXPECT_EQ(queue.popMany(out, 4), 4);
+    EXPECT_EQ(queue.pushMany(values + 6, 4), 4);
+    EXPECT_EQ(queue.pushMany(values, 10), 2);
+
+    EXPECT_EQ(queue.popMany(out, 10), 8);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(out[i], i + 4);
+    }
+    EXPECT_EQ(out[6], 0);
+    EXPECT_EQ(out[7], 1);
+    EXPECT_EQ(queue.popMany(out, 10), 0);
+}
+
+TEST(SPSCQueue, TwoThreads) {
+    const int count = 100000;
+    SPSCQueue<int> queue(64);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < count; i++) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    long long sum = 0;
+    int expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        int out;
+        if (queue.tryPop(out)) {
+            ordered = ordered && out == expected;
+            sum += out;
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(sum, (long long)count * (count - 1) / 2);
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(SPSCQueue, TwoThreadsBatch) {
+    const int count = 100000;
+    SPSCQueue<int> queue(64);
+
+    std::thread producer([&]() {
+        int batch[16];
+        int next = 0;
+        while (next < count) {
+            int size = std::min(16, count - next);
+            for (int i = 0; i < size; i++) {
+                batch[i] = next + i;
+            }
+            int sent = 0;
+            while (sent < size) {
+                int pushed = queue.pushMany(batch + sent, size - sent);
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+                sent += pushed;
+            }
+            next += size;
+        }
+    });
+
+    int out[32];
+    int expected = 0;
+    bool ordered = true;
+    while (expected < count) {
+        int got = queue.popMany(out, 32);
+        if (got == 0) {
+            std::this_thread::yield();
+        }
+        for (int i = 0; i < got; i++) {
+            ordered = ordered && out[i] == expected++;
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+}
+
+TEST(SPSCQueue, LengthWhileBusy) {
+    const int count = 50000;
+    SPSCQueue<int> queue(8);
+    std::atomic<bool> done(false);
+
+    std::thread producer([&]() {
+        for (int i = 0; i < count; i++) {
+            while (!queue.tryPush(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    std::thread consumer([&]() {
+        int out;
+        for (int i = 0; i < count; i++) {
+            while (!queue.tryPop(out)) {
+                std::this_thread::yield();
+            }
+        }
+        done = true;
+    });
+
+    // A snapshot taken while both ends move must still lie within the capacity
+    bool bounded = true;
+    while (!done) {
+        int len = queue.length();
+        bounded = bounded && len >= 0 && len <= queue.capacity();
+    }
+    producer.join();
+    consumer.join();
+
+    EXPECT_TRUE(bounded);
+    EXPECT_TRUE(queue.isEmpty());
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "../include/strux.h"
+
+struct Task {
+    int priority;
+    int id;
+};
+
+struct Reading {
+    float value;
+    int id;
+};
+
+struct Named {
+    std::string name;
+    int id;
+};
+
+TEST(StablePQueue, Constructor) {
+    StablePQueue<int> pqueue;
+    EXPECT_TRUE(pqueue.isEmpty());
+    EXPECT_EQ(pqueue.length(), 0);
+    EXPECT_TRUE(pqueue.isMin());
+    EXPECT_THROW(pqueue.pop(), std::runtime_error);
+    EXPECT_THROW(pqueue.peek(), std::runtime_error);
+}
+
+TEST(StablePQueue, Packed) {
+    EXPECT_TRUE((StablePQueue<int>::isPacked()));
+    EXPECT_TRUE((StablePQueue<float, std::greater<>>::isPacked()));
+    EXPECT_TRUE((StablePQueue<Task, std::less<>, int Task::*>::isPacked()));
+    EXPECT_FALSE((StablePQueue<long long>::isPacked()));
+    EXPECT_FALSE((StablePQueue<Named, std::less<>, std::string Named::*>::isPacked()));
+}
+
+TEST(StablePQueue, Ordering) {
+    StablePQueue<int> minHeap;
+    StablePQueue<int> maxHeap(true);
+    int values[] = {5, -3, 8, 0, -7, 2, 2};
+    for (int value : values) {
+        minHeap.push(value);
+        maxHeap.push(value);
+    }
+
+    for (int expected : {-7, -3, 0, 2, 2, 5, 8}) {
+        EXPECT_EQ(minHeap.pop(), expected);
+    }
+    for (int expected : {8, 5, 2, 2, 0, -3, -7}) {
+        EXPECT_EQ(maxHeap.pop(), expected);
+    }
+}
+
+TEST(StablePQueue, FifoOnTies) {
+    StablePQueue<Task, std::less<>, int Task::*> pqueue(false, std::less<>(), &Task::priority);
+    for (int i = 0; i < 100; i++) {
+        pqueue.push({i % 3, i});
+    }
+
+    EXPECT_TRUE(pqueue.validHeap());
+    int prevPriority = -1;
+    int prevId = -1;
+    while (!pqueue.isEmpty()) {
+        Task task = pqueue.pop();
+        if (task.priority == prevPriority) {
+            EXPECT_GT(task.id, prevId);
+        } else {
+            EXPECT_GT(task.priority, prevPriority);
+        }
+        prevPriority = task.priority;
+        prevId = task.id;
+    }
+}
+
+TEST(StablePQueue, FifoOnTiesMaxHeap) {
+    StablePQueue<Task, std::less<>, int Task::*, 4> pqueue(true, std::less<>(), &Task::priority);
+    pqueue.push({1, 0});
+    pqueue.push({5, 1});
+    pqueue.push({1, 2});
+    pqueue.push({5, 3});
+    pqueue.push({-2, 4});
+
+    for (int expected : {1, 3, 0, 2, 4}) {
+        EXPECT_EQ(pqueue.pop().id, expected);
+    }
+}
+
+TEST(StablePQueue, Floats) {
+    StablePQueue<float> pqueue;
+    float values[] = {1.5f, -0.5f, -2.25f, 0.0f, 3.0f, -0.0f};
+    for (float value : values) {
+        pqueue.push(value);
+    }
+
+    EXPECT_EQ(pqueue.pop(), -2.25f);
+    EXPECT_EQ(pqueue.pop(), -0.5f);
+    pqueue.pop();
+    pqueue.pop();
+    EXPECT_EQ(pqueue.pop(), 1.5f);
+    EXPECT_EQ(pqueue.pop(), 3.0f);
+}
+
+TEST(StablePQueue, SignedZerosTie) {
+    StablePQueue<Reading, std::less<>, float Reading::*> minHeap(false, std::less<>(), &Reading::value);
+    StablePQueue<Reading, std::less<>, float Reading::*> maxHeap(true, std::less<>(), &Reading::value);
+    EXPECT_TRUE(minHeap.isPacked());
+    for (int i = 0; i < 8; i++) {
+        Reading reading = {i % 2 == 0 ? -0.0f : 0.0f, i};
+        minHeap.push(reading);
+        maxHeap.push(reading);
+    }
+
+    // -0.0f and +0.0f are equal keys, so they come out in the order they went in
+    for (int i = 0; i < 8; i++) {
+        EXPECT_EQ(minHeap.pop().id, i);
+        EXPECT_EQ(maxHeap.pop().id, i);
+    }
+}
+
+TEST(StablePQueue, Unpacked) {
+    StablePQueue<Named, std::less<>, std::string Named::*> pqueue(false, std::less<>(), &Named::name);
+    pqueue.push({"b", 0});
+    pqueue.push({"a", 1});
+    pqueue.push({"b", 2});
+    pqueue.push({"a", 3});
+
+    for (int expected : {1, 3, 0, 2}) {
+        EXPECT_EQ(pqueue.pop().id, expected);
+    }
+
+    pqueue.push({"c", 4});
+    pqueue.clear();
+    EXPECT_TRUE(pqueue.isEmpty());
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+
+#include "../include/strux.h"
+
+static long long fib(ThreadPool& pool, int n) {
+    if (n < 12) {
+        return n < 2 ? n : fib(pool, n - 1) + fib(pool, n - 2);
+    }
+    long long a = 0;
+    ThreadPool::TaskGroup group(pool);
+    group.run([&]() { a = fib(pool, n - 1); });
+    long long b = fib(pool, n - 2);
+    group.wait();
+    return a + b;
+}
+
+TEST(ThreadPool, Constructor) {
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.size(), 3);
+
+    ThreadPool hardware;
+    EXPECT_GE(hardware.size(), 1);
+
+    EXPECT_THROW(ThreadPool(-1), std::invalid_argument);
+}
+
+TEST(ThreadPool, Submit) {
+    std::atomic<int> count(0);
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 1000; i++) {
+            pool.submit([&]() { count++; });
+        }
+    }
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(ThreadPool, TaskGroup) {
+    ThreadPool pool(4);
+    std::atomic<int> count(0);
+    ThreadPool::TaskGroup group(pool);
+
+    for (int i = 0; i < 1000; i++) {
+        group.run([&]() { count++; });
+    }
+    group.wait();
+    EXPECT_EQ(count.load(), 1000);
+}
+
+TEST(ThreadPool, ForkJoin) {
+    ThreadPool pool(4);
+    EXPECT_EQ(fib(pool, 25), 75025);
+}
+
+TEST(ThreadPool, ForkJoinSingleWorker) {
+    ThreadPool pool(1);
+    EXPECT_EQ(fib(pool, 20), 6765);
+}
+
+TEST(ThreadPool, Exception) {
+    ThreadPool pool(2);
+    std::atomic<int> count(0);
+    ThreadPool::TaskGroup group(pool);
+
+    group.run([]() { throw std::runtime_error("task failed"); });
+    for (int i = 0; i < 10; i++) {
+        group.run([&]() { count++; });
+    }
+    EXPECT_THROW(group.wait(), std::runtime_error);
+    EXPECT_EQ(count.load(), 10);
+
+    group.run([&]() { count++; });
+    EXPECT_NO_THROW(group.wait());
+}
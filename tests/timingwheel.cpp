@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "../include/strux.h"
+
+TEST(TimingWheel, Constructor) {
+    TimingWheel<int> wheel(100);
+    Vector<int> expired;
+    EXPECT_TRUE(wheel.isEmpty());
+    EXPECT_EQ(wheel.now(), 100u);
+    EXPECT_EQ(wheel.advance(200, expired), 0);
+    EXPECT_EQ(wheel.now(), 200u);
+    EXPECT_THROW(wheel.advance(199, expired), std::invalid_argument);
+}
+
+TEST(TimingWheel, ExpiresInOrder) {
+    TimingWheel<int> wheel;
+    std::uint64_t deadlines[] = {5, 1, 64, 63, 4096, 70, 1000000};
+    for (int i = 0; i < 7; i++) {
+        wheel.schedule(i, deadlines[i]);
+    }
+    EXPECT_EQ(wheel.length(), 7);
+
+    Vector<int> expired;
+    EXPECT_EQ(wheel.advance(64, expired), 4);
+    EXPECT_EQ(expired.get(0), 1);
+    EXPECT_EQ(expired.get(1), 0);
+    EXPECT_EQ(expired.get(2), 3);
+    EXPECT_EQ(expired.get(3), 2);
+
+    EXPECT_EQ(wheel.advance(69, expired), 0);
+    EXPECT_EQ(wheel.advance(70, expired), 1);
+    EXPECT_EQ(wheel.advance(2000000, expired), 2);
+    EXPECT_EQ(expired.get(5), 4);
+    EXPECT_EQ(expired.get(6), 6);
+    EXPECT_TRUE(wheel.isEmpty());
+}
+
+TEST(TimingWheel, PastDeadline) {
+    TimingWheel<int> wheel(50);
+    wheel.schedule(1, 10);
+    wheel.schedule(2, 50);
+
+    Vector<int> expired;
+    EXPECT_EQ(wheel.advance(50, expired), 2);
+    EXPECT_TRUE(wheel.isEmpty());
+}
+
+TEST(TimingWheel, Cancel) {
+    TimingWheel<int> wheel;
+    TimingWheel<int>::Handle near = wheel.schedule(1, 10);
+    TimingWheel<int>::Handle far = wheel.schedule(2, 100000);
+    TimingWheel<int>::Handle kept = wheel.schedule(3, 20);
+    TimingWheel<int>::Handle unset;
+
+    EXPECT_TRUE(wheel.isPending(near));
+    EXPECT_TRUE(wheel.cancel(near));
+    EXPECT_FALSE(wheel.cancel(near));
+    EXPECT_TRUE(wheel.cancel(far));
+    EXPECT_FALSE(wheel.cancel(unset));
+    EXPECT_EQ(wheel.length(), 1);
+
+    Vector<int> expired;
+    EXPECT_EQ(wheel.advance(1000000, expired), 1);
+    EXPECT_EQ(expired.get(0), 3);
+    EXPECT_FALSE(wheel.isPending(kept));
+    EXPECT_FALSE(wheel.cancel(kept));
+}
+
+TEST(TimingWheel, HandleReuse) {
+    TimingWheel<int> wheel;
+    TimingWheel<int>::Handle old = wheel.schedule(1, 5);
+    wheel.cancel(old);
+    TimingWheel<int>::Handle fresh = wheel.schedule(2, 5);
+
+    EXPECT_FALSE(wheel.cancel(old));
+    EXPECT_TRUE(wheel.isPending(fresh));
+}
+
+TEST(TimingWheel, LargeTicks) {
+    std::uint64_t start = ~0ull - 1000;
+    TimingWheel<int> wheel(start);
+    wheel.schedule(1, ~0ull);
+    wheel.schedule(2, start + 1);
+
+    Vector<int> expired;
+    EXPECT_EQ(wheel.advance(~0ull, expired), 2);
+    EXPECT_EQ(expired.get(0), 2);
+    EXPECT_EQ(expired.get(1), 1);
+}
+
+TEST(TimingWheel, MatchesBruteForce) {
+    TimingWheel<int> wheel;
+    std::vector<std::uint64_t> deadline;
+    std::vector<bool> live;
+    std::vector<TimingWheel<int>::Handle> handles;
+    std::uint64_t seed = 99;
+    auto next = [&seed]() {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        return seed >> 33;
+    };
+
+    std::uint64_t now = 0;
+    for (int round = 0; round < 200; round++) {
+        for (int i = 0; i < 20; i++) {
+            std::uint64_t at = now + next() % (1ull << (next() % 24));
+            handles.push_back(wheel.schedule(static_cast<int>(deadline.size()), at));
+            deadline.push_back(at);
+            live.push_back(true);
+        }
+        for (int i = 0; i < 5; i++) {
+            int victim = static_cast<int>(next() % deadline.size());
+            EXPECT_EQ(wheel.cancel(handles[victim]), live[victim]);
+            live[victim] = false;
+        }
+
+        now += next() % 100000;
+        Vector<int> expired;
+        wheel.advance(now, expired);
+        std::uint64_t prev = 0;
+        for (int i = 0; i < expired.length(); i++) {
+            int id = expired.get(i);
+            ASSERT_TRUE(live[id]);
+            EXPECT_LE(deadline[id], now);
+            EXPECT_GE(deadline[id], prev);
+            prev = deadline[id];
+            live[id] = false;
+        }
+        for (std::size_t id = 0; id < deadline.size(); id++) {
+            if (live[id]) {
+                ASSERT_GT(deadline[id], now);
+            }
+        }
+    }
+}
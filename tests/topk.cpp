@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include "../include/strux.h"
+
+TEST(TopK, Constructor) {
+    TopK<int> topk(3);
+    EXPECT_TRUE(topk.isEmpty());
+    EXPECT_FALSE(topk.isFull());
+    EXPECT_EQ(topk.capacity(), 3);
+    EXPECT_THROW(topk.threshold(), std::runtime_error);
+    EXPECT_THROW(TopK<int>(0), std::invalid_argument);
+}
+
+TEST(TopK, KeepsGreatest) {
+    TopK<int> topk(3);
+    int values[] = {5, 1, 9, 3, 7, 2, 8};
+    for (int value : values) {
+        topk.push(value);
+    }
+
+    EXPECT_TRUE(topk.isFull());
+    EXPECT_EQ(topk.length(), 3);
+    EXPECT_EQ(topk.threshold(), 7);
+    EXPECT_FALSE(topk.push(6));
+    EXPECT_FALSE(topk.push(7));
+    EXPECT_TRUE(topk.push(10));
+
+    int out[3];
+    EXPECT_EQ(topk.popAll(out), 3);
+    EXPECT_EQ(out[0], 10);
+    EXPECT_EQ(out[1], 9);
+    EXPECT_EQ(out[2], 8);
+    EXPECT_TRUE(topk.isEmpty());
+}
+
+TEST(TopK, KeepsSmallest) {
+    TopK<int, std::greater<>> topk(2);
+    int values[] = {5, 1, 9, 3, 7};
+    EXPECT_EQ(topk.pushMany(values, 5), 3);
+
+    int out[2];
+    EXPECT_EQ(topk.peekAll(out), 2);
+    EXPECT_EQ(out[0], 1);
+    EXPECT_EQ(out[1], 3);
+    EXPECT_EQ(topk.length(), 2);
+}
+
+TEST(TopK, Stream) {
+    TopK<int> topk(10);
+    for (int i = 0; i < 100000; i++) {
+        topk.push((i * 7919) % 100003);
+    }
+
+    int out[10];
+    topk.peekAll(out);
+    for (int i = 1; i < 10; i++) {
+        EXPECT_GT(out[i - 1], out[i]);
+    }
+    EXPECT_EQ(topk.threshold(), out[9]);
+    topk.clear();
+    EXPECT_TRUE(topk.isEmpty());
+}
+
+struct Score {
+    int player;
+    int points;
+};
+
+TEST(TopK, KeyProjection) {
+    TopK<Score, std::less<>, int Score::*> topk(2, std::less<>(), &Score::points);
+    Score scores[] = {{1, 40}, {2, 90}, {3, 10}, {4, 70}};
+    topk.pushMany(scores, 4);
+
+    Score out[2];
+    topk.popAll(out);
+    EXPECT_EQ(out[0].player, 2);
+    EXPECT_EQ(out[1].player, 4);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+TEST(TreiberStack, Constructor) {
+    TreiberStack<int> stack;
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_EQ(stack.length(), 0);
+}
+
+TEST(TreiberStack, PushPop) {
+    TreiberStack<int> stack;
+
+    stack.push(1);
+    stack.push(2);
+    stack.push(3);
+    EXPECT_EQ(stack.length(), 3);
+
+    int out;
+    EXPECT_TRUE(stack.pop(out));
+    EXPECT_EQ(out, 3);
+    EXPECT_TRUE(stack.pop(out));
+    EXPECT_EQ(out, 2);
+    EXPECT_TRUE(stack.pop(out));
+    EXPECT_EQ(out, 1);
+    EXPECT_FALSE(stack.pop(out));
+    EXPECT_TRUE(stack.isEmpty());
+}
+
+TEST(TreiberStack, PushChain) {
+    TreiberStack<int> stack;
+    int values[] = {1, 2, 3, 4};
+
+    stack.push(0);
+    stack.pushChain(values, 4);
+    EXPECT_EQ(stack.length(), 5);
+
+    int out;
+    for (int i = 4; i >= 0; i--) {
+        EXPECT_TRUE(stack.pop(out));
+        EXPECT_EQ(out, i);
+    }
+}
+
+TEST(TreiberStack, PopAll) {
+    TreiberStack<int> stack;
+    int values[] = {1, 2, 3};
+    stack.pushChain(values, 3);
+
+    Vector<int>* all = stack.popAll();
+    EXPECT_EQ(all->length(), 3);
+    EXPECT_EQ(all->get(0), 3);
+    EXPECT_EQ(all->get(2), 1);
+    EXPECT_TRUE(stack.isEmpty());
+    EXPECT_EQ(stack.length(), 0);
+    delete all;
+
+    all = stack.popAll();
+    EXPECT_TRUE(all->isEmpty());
+    delete all;
+}
+
+TEST(TreiberStack, MultipleTypes) {
+    TreiberStack<std::string> stack;
+    stack.push("a");
+    stack.push("b");
+
+    std::string out;
+    EXPECT_TRUE(stack.pop(out));
+    EXPECT_EQ(out, "b");
+}
+
+TEST(TreiberStack, ManyThreads) {
+    const int threads = 8;
+    const int per_thread = 20000;
+    TreiberStack<int> stack;
+    std::atomic<long long> sum(0);
+    std::atomic<int> popped(0);
+    std::vector<std::thread> workers;
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            int out;
+            for (int i = 0; i < per_thread; i++) {
+                stack.push(t * per_thread + i);
+                if (stack.pop(out)) {
+                    sum += out;
+                    popped++;
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    int out;
+    while (stack.pop(out)) {
+        sum += out;
+        popped++;
+    }
+
+    long long total = (long long)threads * per_thread;
+    EXPECT_EQ(popped.load(), total);
+    EXPECT_EQ(sum.load(), total * (total - 1) / 2);
+}
+
+TEST(TreiberStack, ConcurrentPopAll) {
+    const int producers = 4;
+    const int per_producer = 20000;
+    TreiberStack<int> stack;
+    std::atomic<int> done(0);
+    long long sum = 0;
+    std::vector<std::thread> workers;
+
+    for (int p = 0; p < producers; p++) {
+        workers.emplace_back([&, p]() {
+            int batch[8];
+            for (int i = 0; i < per_producer; i += 8) {
+                for (int j = 0; j < 8; j++) {
+                    batch[j] = p * per_producer + i + j;
+                }
+                stack.pushChain(batch, 8);
+            }
+            done++;
+        });
+    }
+    workers.emplace_back([&]() {
+        int out;
+        while (done.load() < producers) {
+            if (stack.pop(out)) {
+                stack.push(out);
+            }
+        }
+    });
+
+    while (done.load() < producers || !stack.isEmpty()) {
+        Vector<int>* all = stack.popAll();
+        for (int i = 0; i < all->length(); i++) {
+            sum += all->get(i);
+        }
+        delete all;
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    Vector<int>* rest = stack.popAll();
+    for (int i = 0; i < rest->length(); i++) {
+        sum += rest->get(i);
+    }
+    delete rest;
+
+    long long total = (long long)producers * per_producer;
+    EXPECT_EQ(sum, total * (total - 1) / 2);
+}
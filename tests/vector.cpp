@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
 
 #include "../include/strux.h"
 
@@ -291,3 +293,84 @@ TEST(Vector, ArrayPush) {
     EXPECT_EQ(vector.get(1), 2);
     EXPECT_EQ(vector.get(2), 3);
 }
+
+TEST(Vector, Reserve) {
+    Vector<int> vector;
+    vector.push(1);
+    vector.push(2);
+
+    vector.reserve(64);
+    EXPECT_EQ(vector.capacity(), 64);
+    EXPECT_EQ(vector.get(0), 1);
+    EXPECT_EQ(vector.get(1), 2);
+
+    vector.pop();
+    EXPECT_EQ(vector.capacity(), 64);
+
+    vector.clear();
+    EXPECT_EQ(vector.capacity(), 64);
+}
+
+TEST(Vector, Truncate) {
+    Vector<int> vector;
+    for (int i = 0; i < 10; i++) {
+        vector.push(i);
+    }
+    int capacity = vector.capacity();
+
+    vector.truncate(4);
+    EXPECT_EQ(vector.length(), 4);
+    EXPECT_EQ(vector.get(3), 3);
+    vector.truncate(0);
+    EXPECT_TRUE(vector.isEmpty());
+    EXPECT_EQ(vector.capacity(), capacity);
+
+    EXPECT_THROW(vector.truncate(1), std::out_of_range);
+    EXPECT_THROW(vector.truncate(-1), std::out_of_range);
+    vector.push(7);
+    EXPECT_EQ(vector.get(0), 7);
+}
+
+TEST(Vector, Back) {
+    Vector<int> vector;
+    EXPECT_THROW(vector.back(), std::runtime_error);
+
+    vector.push(1);
+    vector.push(2);
+    EXPECT_EQ(vector.back(), 2);
+
+    vector.back() = 7;
+    EXPECT_EQ(vector.get(1), 7);
+}
+
+TEST(Vector, ZeroCapacity) {
+    Vector<int> vector(0);
+    vector.push(1);
+    vector.push(2);
+    EXPECT_EQ(vector.length(), 2);
+    EXPECT_EQ(vector.get(1), 2);
+}
+
+TEST(Vector, Aligned) {
+    // The array stays aligned through growth, decay, clearing and reversal
+    Vector<int, 64> vector;
+    for (int i = 0; i < 1000; i++) {
+        vector.push(i);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&vector[0]) % 64, 0u);
+    }
+    vector.reverse();
+    EXPECT_EQ(vector[0], 999);
+    while (vector.length() > 1) {
+        vector.pop();
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&vector[0]) % 64, 0u);
+    }
+    EXPECT_EQ(vector[0], 999);
+
+    Vector<std::string, 64> strings;
+    strings.push("aligned");
+    strings.reserve(100);
+    EXPECT_EQ(strings[0], "aligned");
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&strings[0]) % 64, 0u);
+    strings.clear();
+    EXPECT_TRUE(strings.isEmpty());
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "../include/strux.h"
+
+TEST(WorkStealingDeque, Constructor) {
+    WorkStealingDeque<int> deque;
+    EXPECT_TRUE(deque.isEmpty());
+    EXPECT_EQ(deque.length(), 0);
+    EXPECT_EQ(deque.capacity(), 64);
+
+    EXPECT_EQ(WorkStealingDeque<int>(5).capacity(), 8);
+}
+
+TEST(WorkStealingDeque, PushPop) {
+    WorkStealingDeque<int> deque;
+
+    deque.push(1);
+    deque.push(2);
+    deque.push(3);
+    EXPECT_EQ(deque.length(), 3);
+
+    int out;
+    EXPECT_TRUE(deque.pop(out));
+    EXPECT_EQ(out, 3);
+    EXPECT_TRUE(deque.pop(out));
+    EXPECT_EQ(out, 2);
+    EXPECT_TRUE(deque.pop(out));
+    EXPECT_EQ(out, 1);
+    EXPECT_FALSE(deque.pop(out));
+    EXPECT_TRUE(deque.isEmpty());
+}
+
+TEST(WorkStealingDeque, Steal) {
+    WorkStealingDeque<int> deque;
+
+    deque.push(1);
+    deque.push(2);
+    deque.push(3);
+
+    int out;
+    EXPECT_TRUE(deque.steal(out));
+    EXPECT_EQ(out, 1);
+    EXPECT_TRUE(deque.pop(out));
+    EXPECT_EQ(out, 3);
+    EXPECT_TRUE(deque.steal(out));
+    EXPECT_EQ(out, 2);
+    EXPECT_FALSE(deque.steal(out));
+    EXPECT_FALSE(deque.pop(out));
+}
+
+TEST(WorkStealingDeque, Grow) {
+    WorkStealingDeque<int> deque(4);
+
+    for (int i = 0; i < 100; i++) {
+        deque.push(i);
+    }
+    EXPECT_EQ(deque.length(), 100);
+    EXPECT_EQ(deque.capacity(), 128);
+
+    int out;
+    for (int i = 0; i < 50; i++) {
+        EXPECT_TRUE(deque.steal(out));
+        EXPECT_EQ(out, i);
+    }
+    for (int i = 99; i >= 50; i--) {
+        EXPECT_TRUE(deque.pop(out));
+        EXPECT_EQ(out, i);
+    }
+}
+
+TEST(WorkStealingDeque, ConcurrentSteal) {
+    const int count = 100000;
+    const int thieves = 3;
+    WorkStealingDeque<int> deque(16);
+    std::atomic<bool> done(false);
+    std::atomic<long long> stolen_sum(0);
+    std::atomic<int> stolen(0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < thieves; t++) {
+        threads.emplace_back([&]() {
+            int out;
+            while (!done.load() || !deque.isEmpty()) {
+                if (deque.steal(out)) {
+                    stolen_sum += out;
+                    stolen++;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    long long popped_sum = 0;
+    int popped = 0;
+    int out;
+    for (int i = 0; i < count; i++) {
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(out)) {
+            popped_sum += out;
+            popped++;
+        }
+    }
+    while (deque.pop(out)) {
+        popped_sum += out;
+        popped++;
+    }
+    done.store(true);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(popped + stolen.load(), count);
+    EXPECT_EQ(popped_sum + stolen_sum.load(), (long long)count * (count - 1) / 2);
+}